@@ -292,9 +292,14 @@ int AppShell::processConverter(const CommandLineController::ConverterTask& task)
     bool forceMode = task.params[CommandLineController::ParamKey::ForceMode].toBool();
 
     switch (task.type) {
-    case CommandLineController::ConvertType::Batch:
-        ret = converter()->batchConvert(task.inputFile, stylePath, forceMode);
-        break;
+    case CommandLineController::ConvertType::Batch: {
+        converter::BatchOptions options;
+        options.reportPath = task.params[CommandLineController::ParamKey::BatchReportPath].toString();
+        options.workerCount = task.params.value(CommandLineController::ParamKey::BatchWorkerCount, 1).toUInt();
+        options.jobTimeoutSec = task.params[CommandLineController::ParamKey::BatchJobTimeout].toInt();
+        options.workerArgs = task.params[CommandLineController::ParamKey::BatchWorkerArgs].toStringList();
+        ret = converter()->batchConvert(task.inputFile, stylePath, forceMode, options);
+    } break;
     case CommandLineController::ConvertType::ConvertScoreParts:
         ret = converter()->convertScoreParts(task.inputFile, task.outputFile, stylePath);
         break;
@@ -54,6 +54,15 @@ void CommandLineController::parse(const QStringList& args)
     // Converter mode
     m_parser.addOption(QCommandLineOption({ "r", "image-resolution" }, "Set output resolution for image export", "DPI"));
     m_parser.addOption(QCommandLineOption({ "j", "job" }, "Process a conversion job", "file"));
+    m_parser.addOption(QCommandLineOption("batch-workers",
+                                          "Use with '-j <file>', run the jobs on the given number of worker processes, 0 - one per CPU core",
+                                          "count"));
+    m_parser.addOption(QCommandLineOption("batch-report",
+                                          "Use with '-j <file>', write the result and the duration of every job to a JSON Lines file",
+                                          "file"));
+    m_parser.addOption(QCommandLineOption("batch-job-timeout",
+                                          "Use with '-j <file>' and '--batch-workers', stop a worker running a job for longer, in seconds",
+                                          "seconds"));
     m_parser.addOption(QCommandLineOption({ "o", "export-to" }, "Export to 'file'. Format depends on file's extension", "file"));
     m_parser.addOption(QCommandLineOption({ "F", "factory-settings" }, "Use factory settings"));
     m_parser.addOption(QCommandLineOption({ "R", "revert-settings" }, "Revert to factory settings, but keep default preferences"));
@@ -209,6 +218,43 @@ void CommandLineController::apply()
         application()->setRunMode(IApplication::RunMode::Converter);
         m_converterTask.type = ConvertType::Batch;
         m_converterTask.inputFile = m_parser.value("j");
+
+        if (m_parser.isSet("batch-workers")) {
+            std::optional<int> val = intValue("batch-workers");
+            if (val && val.value() >= 0) {
+                m_converterTask.params[CommandLineController::ParamKey::BatchWorkerCount] = val.value();
+            } else {
+                LOGE() << "Option: --batch-workers not recognized count value: " << m_parser.value("batch-workers");
+            }
+        }
+
+        if (m_parser.isSet("batch-report")) {
+            m_converterTask.params[CommandLineController::ParamKey::BatchReportPath] = m_parser.value("batch-report");
+        }
+
+        if (m_parser.isSet("batch-job-timeout")) {
+            std::optional<int> val = intValue("batch-job-timeout");
+            if (val && val.value() >= 0) {
+                m_converterTask.params[CommandLineController::ParamKey::BatchJobTimeout] = val.value();
+            } else {
+                LOGE() << "Option: --batch-job-timeout not recognized seconds value: " << m_parser.value("batch-job-timeout");
+            }
+        }
+
+        //! NOTE The workers get only the options that change the conversion,
+        //! not the ones like -F and -R, which would change the settings in each of them
+        QStringList workerArgs;
+        for (const QString& name : QStringList { "S", "r", "T", "b", "M", "migration" }) {
+            if (m_parser.isSet(name)) {
+                workerArgs << (name.size() == 1 ? "-" : "--") + name << m_parser.value(name);
+            }
+        }
+        for (const QString& name : QStringList { "f", "t", "template-mode" }) {
+            if (m_parser.isSet(name)) {
+                workerArgs << (name.size() == 1 ? "-" : "--") + name;
+            }
+        }
+        m_converterTask.params[CommandLineController::ParamKey::BatchWorkerArgs] = workerArgs;
     }
 
     if (m_parser.isSet("score-media")) {
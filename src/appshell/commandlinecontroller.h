@@ -74,6 +74,12 @@ public:
         ScoreTransposeOptions,
         ForceMode,
 
+        // Batch
+        BatchWorkerCount,
+        BatchReportPath,
+        BatchJobTimeout,
+        BatchWorkerArgs,
+
         // Video
     };
 
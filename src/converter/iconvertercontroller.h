@@ -22,11 +22,20 @@
 #ifndef MU_CONVERTER_ICONVERTERCONTROLLER_H
 #define MU_CONVERTER_ICONVERTERCONTROLLER_H
 
+#include <QStringList>
+
 #include "modularity/imoduleexport.h"
 #include "types/ret.h"
 #include "io/path.h"
 
 namespace mu::converter {
+struct BatchOptions {
+    io::path_t reportPath;      // the result of every job is written to it, as JSON Lines
+    size_t workerCount = 1;     // the jobs are run on worker processes if it's more than 1, 0 - one per CPU core
+    int jobTimeoutSec = 0;      // a worker running a job for longer is stopped, 0 - no timeout
+    QStringList workerArgs;     // the command line options the workers get
+};
+
 class IConverterController : MODULE_EXPORT_INTERFACE
 {
     INTERFACE_ID(IConverterController)
@@ -35,7 +44,9 @@ public:
 
     virtual Ret fileConvert(const io::path_t& in, const io::path_t& out, const io::path_t& stylePath = io::path_t(),
                             bool forceMode = false) = 0;
-    virtual Ret batchConvert(const io::path_t& batchJobFile, const io::path_t& stylePath = io::path_t(), bool forceMode = false) = 0;
+    //! NOTE Goes on after a failed job. If the job file is "-", the jobs are read from the standard input, one per line
+    virtual Ret batchConvert(const io::path_t& batchJobFile, const io::path_t& stylePath = io::path_t(), bool forceMode = false,
+                             const BatchOptions& options = BatchOptions()) = 0;
     virtual Ret convertScoreParts(const io::path_t& in, const io::path_t& out,
                                   const io::path_t& stylePath = io::path_t(), bool forceMode = false) = 0;
 
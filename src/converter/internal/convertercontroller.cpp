@@ -21,11 +21,23 @@
  */
 #include "convertercontroller.h"
 
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <iostream>
+#include <memory>
+#include <optional>
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
 #include <QFile>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonArray>
 #include <QJsonParseError>
+#include <QProcess>
+#include <QTemporaryDir>
+#include <QThread>
 
 #include "convertercodes.h"
 #include "stringutils.h"
@@ -40,28 +52,316 @@ using namespace mu::notation;
 static const std::string PDF_SUFFIX = "pdf";
 static const std::string PNG_SUFFIX = "png";
 
-mu::Ret ConverterController::batchConvert(const io::path_t& batchJobFile, const io::path_t& stylePath, bool forceMode)
+static const mu::io::path_t JOBS_FROM_STDIN("-");
+static constexpr int WORKER_POLL_INTERVAL_MS = 100;
+
+static QByteArray jobReportLine(const mu::io::path_t& in, const mu::io::path_t& out, const mu::Ret& ret, int64_t durationMs)
+{
+    QJsonObject obj;
+    obj["in"] = in.toQString();
+    obj["out"] = out.toQString();
+    obj["success"] = ret.success();
+    obj["error"] = ret.code();
+    obj["errorText"] = QString::fromStdString(ret.text());
+    obj["durationMs"] = static_cast<qint64>(durationMs);
+
+    return QJsonDocument(obj).toJson(QJsonDocument::Compact);
+}
+
+static mu::Ret batchJobResult(size_t failedCount, size_t jobCount)
+{
+    if (failedCount == 0) {
+        return make_ret(mu::Ret::Code::Ok);
+    }
+
+    return make_ret(Err::BatchJobFailed, std::to_string(failedCount) + " of " + std::to_string(jobCount) + " jobs failed");
+}
+
+static void openReport(QFile& report, const mu::io::path_t& reportPath)
+{
+    if (reportPath.empty()) {
+        return;
+    }
+
+    report.setFileName(reportPath.toQString());
+    if (!report.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        LOGE() << "failed open report file: " << reportPath;
+    }
+}
+
+mu::Ret ConverterController::batchConvert(const io::path_t& batchJobFile, const io::path_t& stylePath, bool forceMode,
+                                          const BatchOptions& options)
 {
     TRACEFUNC;
 
+    if (batchJobFile == JOBS_FROM_STDIN) {
+        return runBatchWorker(stylePath, forceMode, options.reportPath);
+    }
+
     RetVal<BatchJob> batchJob = parseBatchJob(batchJobFile);
     if (!batchJob.ret) {
         LOGE() << "failed parse batch job file, err: " << batchJob.ret.toString();
         return batchJob.ret;
     }
 
-    Ret ret = make_ret(Ret::Code::Ok);
-    for (const Job& job : batchJob.val) {
-        ret = fileConvert(job.in, job.out, stylePath, forceMode);
-        if (!ret) {
-            LOGE() << "failed convert, err: " << ret.toString() << ", in: " << job.in << ", out: " << job.out;
-            break;
-        }
+    BatchOptions workerOptions = options;
+    if (workerOptions.workerCount == 0) {
+        workerOptions.workerCount = static_cast<size_t>(std::max(QThread::idealThreadCount(), 1));
+    }
+
+    workerOptions.workerCount = std::min(workerOptions.workerCount, batchJob.val.size());
+    if (workerOptions.workerCount > 1) {
+        return runBatchJobOnWorkers(batchJob.val, workerOptions);
+    }
+
+    return runBatchJob(batchJob.val, stylePath, forceMode, options.reportPath);
+}
+
+mu::Ret ConverterController::runJob(const Job& job, const io::path_t& stylePath, bool forceMode, QFile& report)
+{
+    auto start = std::chrono::steady_clock::now();
+    Ret ret = fileConvert(job.in, job.out, stylePath, forceMode);
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+
+    if (!ret) {
+        LOGE() << "failed convert, err: " << ret.toString() << ", in: " << job.in << ", out: " << job.out;
+    }
+
+    //! NOTE The report is written after every job, so it's complete up to the job that crashed the process, if any
+    if (report.isOpen()) {
+        report.write(jobReportLine(job.in, job.out, ret, duration.count()) + '\n');
+        report.flush();
     }
 
     return ret;
 }
 
+mu::Ret ConverterController::runBatchJob(const BatchJob& batchJob, const io::path_t& stylePath, bool forceMode,
+                                         const io::path_t& reportPath)
+{
+    QFile report;
+    openReport(report, reportPath);
+
+    size_t failedCount = 0;
+    for (const Job& job : batchJob) {
+        if (!runJob(job, stylePath, forceMode, report)) {
+            ++failedCount;
+        }
+    }
+
+    return batchJobResult(failedCount, batchJob.size());
+}
+
+mu::Ret ConverterController::runBatchWorker(const io::path_t& stylePath, bool forceMode, const io::path_t& reportPath)
+{
+    //! NOTE A worker gets its jobs one at a time, as JSON objects on the lines of the standard input,
+    //! and ends with it. It writes the result of a job to the report before it takes the next one
+    QFile report;
+    openReport(report, reportPath);
+
+    size_t jobCount = 0;
+    size_t failedCount = 0;
+    std::string line;
+    while (std::getline(std::cin, line)) {
+        QJsonObject obj = QJsonDocument::fromJson(QByteArray::fromStdString(line)).object();
+
+        Job job;
+        job.in = obj["in"].toString();
+        job.out = obj["out"].toString();
+
+        ++jobCount;
+        if (!runJob(job, stylePath, forceMode, report)) {
+            ++failedCount;
+        }
+    }
+
+    return batchJobResult(failedCount, jobCount);
+}
+
+mu::Ret ConverterController::runBatchJobOnWorkers(const BatchJob& batchJob, const BatchOptions& options) const
+{
+    //! NOTE The engraving isn't thread-safe, so the jobs are run by worker processes of this application.
+    //! The workers take the jobs one at a time from a shared queue until it's empty, so the fonts, templates
+    //! and SoundFonts a worker loads are reused across its jobs, and a long job doesn't hold up the others.
+    //! If a worker crashes or runs a job for longer than the timeout, it's stopped, its job is marked as failed
+    //! and a new worker goes on with the queue
+    QTemporaryDir tempDir;
+    if (!tempDir.isValid()) {
+        LOGE() << "failed create temporary dir, err: " << tempDir.errorString();
+        return make_ret(Err::UnknownError);
+    }
+
+    struct Worker {
+        std::unique_ptr<QProcess> process;
+        QString reportFile;
+        qint64 reportReadPos = 0;
+        std::optional<size_t> jobIdx;
+        QElapsedTimer jobTimer;
+        bool isInputClosed = false;
+    };
+
+    std::deque<size_t> jobQueue;
+    for (size_t i = 0; i < batchJob.size(); ++i) {
+        jobQueue.push_back(i);
+    }
+
+    std::vector<QByteArray> reportLines(batchJob.size());
+    std::vector<bool> succeeded(batchJob.size(), false);
+
+    std::vector<Worker> workers(options.workerCount);
+    int startCount = 0;
+    QString startError;
+
+    auto failJob = [&](size_t idx, const Ret& ret, int64_t durationMs) {
+        const Job& job = batchJob[idx];
+        LOGE() << "failed convert, err: " << ret.toString() << ", in: " << job.in << ", out: " << job.out;
+        reportLines[idx] = jobReportLine(job.in, job.out, ret, durationMs);
+    };
+
+    auto giveNextJob = [&](Worker& worker) {
+        if (jobQueue.empty()) {
+            //! NOTE The end of the input stops the worker
+            worker.process->closeWriteChannel();
+            worker.isInputClosed = true;
+            return;
+        }
+
+        size_t idx = jobQueue.front();
+        jobQueue.pop_front();
+
+        QJsonObject obj;
+        obj["in"] = batchJob[idx].in.toQString();
+        obj["out"] = batchJob[idx].out.toQString();
+        worker.process->write(QJsonDocument(obj).toJson(QJsonDocument::Compact) + '\n');
+        worker.process->waitForBytesWritten();
+
+        worker.jobIdx = idx;
+        worker.jobTimer.start();
+    };
+
+    auto startWorker = [&](Worker& worker) {
+        ++startCount;
+        worker.reportFile = tempDir.filePath(QString("worker%1.jsonl").arg(startCount));
+        worker.reportReadPos = 0;
+        worker.jobIdx.reset();
+        worker.isInputClosed = false;
+
+        QStringList args = options.workerArgs;
+        args << "-j" << JOBS_FROM_STDIN.toQString() << "--batch-report" << worker.reportFile;
+
+        worker.process = std::make_unique<QProcess>();
+        worker.process->setProcessChannelMode(QProcess::ForwardedChannels);
+        worker.process->start(QCoreApplication::applicationFilePath(), args);
+        if (!worker.process->waitForStarted()) {
+            startError = worker.process->errorString();
+            LOGE() << "failed start worker, err: " << startError;
+            worker.process.reset();
+            return;
+        }
+
+        giveNextJob(worker);
+    };
+
+    auto collectReport = [&](Worker& worker) {
+        QFile file(worker.reportFile);
+        if (!file.open(QIODevice::ReadOnly) || !file.seek(worker.reportReadPos)) {
+            return;
+        }
+
+        QByteArray data = file.readAll();
+        int end = data.lastIndexOf('\n');
+        if (end < 0) {
+            return;
+        }
+
+        worker.reportReadPos += end + 1;
+
+        //! NOTE A worker runs one job at a time, so a line is the result of its current job
+        for (const QByteArray& line : data.left(end).split('\n')) {
+            if (line.isEmpty() || !worker.jobIdx) {
+                continue;
+            }
+
+            size_t idx = worker.jobIdx.value();
+            reportLines[idx] = line;
+            succeeded[idx] = QJsonDocument::fromJson(line).object().value("success").toBool();
+            worker.jobIdx.reset();
+        }
+    };
+
+    for (Worker& worker : workers) {
+        startWorker(worker);
+    }
+
+    auto isRunning = [&workers]() {
+        return std::any_of(workers.begin(), workers.end(), [](const Worker& w) { return w.process != nullptr; });
+    };
+
+    while (isRunning()) {
+        QThread::msleep(WORKER_POLL_INTERVAL_MS);
+
+        for (Worker& worker : workers) {
+            if (!worker.process) {
+                continue;
+            }
+
+            bool isFinished = worker.process->state() == QProcess::NotRunning || worker.process->waitForFinished(0);
+            collectReport(worker);
+
+            if (worker.jobIdx) {
+                int64_t durationMs = worker.jobTimer.elapsed();
+                if (isFinished) {
+                    bool isCrashed = worker.process->exitStatus() == QProcess::CrashExit;
+                    failJob(worker.jobIdx.value(), make_ret(Err::BatchWorkerFailed, isCrashed
+                                                            ? "worker crashed"
+                                                            : "worker exit code: " + std::to_string(worker.process->exitCode())),
+                            durationMs);
+                    worker.jobIdx.reset();
+                } else if (options.jobTimeoutSec > 0 && durationMs > static_cast<int64_t>(options.jobTimeoutSec) * 1000) {
+                    worker.process->kill();
+                    worker.process->waitForFinished();
+                    isFinished = true;
+
+                    failJob(worker.jobIdx.value(), make_ret(Err::BatchWorkerFailed, "worker stopped, the job timed out after "
+                                                            + std::to_string(options.jobTimeoutSec) + " s"), durationMs);
+                    worker.jobIdx.reset();
+                }
+            }
+
+            if (isFinished) {
+                worker.process.reset();
+                if (!jobQueue.empty()) {
+                    startWorker(worker);
+                }
+            } else if (!worker.jobIdx && !worker.isInputClosed) {
+                giveNextJob(worker);
+            }
+        }
+    }
+
+    //! NOTE No worker could be started for the rest of the jobs
+    while (!jobQueue.empty()) {
+        failJob(jobQueue.front(), make_ret(Err::BatchWorkerFailed, startError.toStdString()), 0);
+        jobQueue.pop_front();
+    }
+
+    QFile report;
+    openReport(report, options.reportPath);
+
+    size_t failedCount = 0;
+    for (size_t i = 0; i < batchJob.size(); ++i) {
+        if (!succeeded[i]) {
+            ++failedCount;
+        }
+
+        if (report.isOpen()) {
+            report.write(reportLines[i] + '\n');
+        }
+    }
+
+    return batchJobResult(failedCount, batchJob.size());
+}
+
 mu::Ret ConverterController::fileConvert(const io::path_t& in, const io::path_t& out, const io::path_t& stylePath, bool forceMode)
 {
     TRACEFUNC;
@@ -92,7 +392,7 @@ mu::Ret ConverterController::fileConvert(const io::path_t& in, const io::path_t&
         ret = convertFullNotation(writer, notationProject->masterNotation()->notation(), out);
     }
 
-    return make_ret(Ret::Code::Ok);
+    return ret;
 }
 
 mu::Ret ConverterController::convertScoreParts(const mu::io::path_t& in, const mu::io::path_t& out, const mu::io::path_t& stylePath,
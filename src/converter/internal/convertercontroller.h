@@ -22,7 +22,7 @@
 #ifndef MU_CONVERTER_CONVERTERCONTROLLER_H
 #define MU_CONVERTER_CONVERTERCONTROLLER_H
 
-#include <list>
+#include <vector>
 
 #include "../iconvertercontroller.h"
 
@@ -34,6 +34,8 @@
 
 #include "types/retval.h"
 
+class QFile;
+
 namespace mu::converter {
 class ConverterController : public IConverterController
 {
@@ -47,7 +49,8 @@ public:
 
     Ret fileConvert(const io::path_t& in, const io::path_t& out, const io::path_t& stylePath = io::path_t(),
                     bool forceMode = false) override;
-    Ret batchConvert(const io::path_t& batchJobFile, const io::path_t& stylePath = io::path_t(), bool forceMode = false) override;
+    Ret batchConvert(const io::path_t& batchJobFile, const io::path_t& stylePath = io::path_t(), bool forceMode = false,
+                     const BatchOptions& options = BatchOptions()) override;
     Ret convertScoreParts(const io::path_t& in, const io::path_t& out, const io::path_t& stylePath = io::path_t(),
                           bool forceMode = false) override;
 
@@ -74,10 +77,15 @@ private:
         io::path_t out;
     };
 
-    using BatchJob = std::list<Job>;
+    using BatchJob = std::vector<Job>;
 
     RetVal<BatchJob> parseBatchJob(const io::path_t& batchJobFile) const;
 
+    Ret runJob(const Job& job, const io::path_t& stylePath, bool forceMode, QFile& report);
+    Ret runBatchJob(const BatchJob& batchJob, const io::path_t& stylePath, bool forceMode, const io::path_t& reportPath);
+    Ret runBatchWorker(const io::path_t& stylePath, bool forceMode, const io::path_t& reportPath);
+    Ret runBatchJobOnWorkers(const BatchJob& batchJob, const BatchOptions& options) const;
+
     bool isConvertPageByPage(const std::string& suffix) const;
     Ret convertPageByPage(project::INotationWriterPtr writer, notation::INotationPtr notation, const io::path_t& out) const;
     Ret convertFullNotation(project::INotationWriterPtr writer, notation::INotationPtr notation, const io::path_t& out) const;
@@ -0,0 +1,164 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTemporaryDir>
+
+#include "converter/internal/convertercontroller.h"
+#include "converter/convertercodes.h"
+
+using namespace mu;
+using namespace mu::converter;
+
+namespace {
+//! NOTE Converts nothing, fails the jobs for the given input files
+class TestConverterController : public ConverterController
+{
+public:
+    Ret fileConvert(const io::path_t& in, const io::path_t& out, const io::path_t&, bool) override
+    {
+        convertedFiles.push_back({ in, out });
+
+        if (failingFiles.contains(in.toQString())) {
+            return make_ret(Err::InFileFailedLoad);
+        }
+
+        return make_ret(Ret::Code::Ok);
+    }
+
+    QStringList failingFiles;
+    std::vector<std::pair<io::path_t, io::path_t> > convertedFiles;
+};
+}
+
+class Converter_ConverterControllerTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        ASSERT_TRUE(m_tempDir.isValid());
+        m_controller = std::make_shared<TestConverterController>();
+    }
+
+    io::path_t writeBatchJobFile(const QStringList& inFiles) const
+    {
+        QJsonArray arr;
+        for (const QString& in : inFiles) {
+            QJsonObject obj;
+            obj["in"] = in;
+            obj["out"] = in + ".pdf";
+            arr.append(obj);
+        }
+
+        QString path = m_tempDir.filePath("job.json");
+        QFile file(path);
+        file.open(QIODevice::WriteOnly);
+        file.write(QJsonDocument(arr).toJson());
+
+        return path;
+    }
+
+    QList<QJsonObject> readReport(const io::path_t& reportPath) const
+    {
+        QFile file(reportPath.toQString());
+        file.open(QIODevice::ReadOnly);
+
+        QList<QJsonObject> result;
+        for (const QByteArray& line : file.readAll().split('\n')) {
+            if (!line.isEmpty()) {
+                result << QJsonDocument::fromJson(line).object();
+            }
+        }
+
+        return result;
+    }
+
+    QTemporaryDir m_tempDir;
+    std::shared_ptr<TestConverterController> m_controller;
+};
+
+TEST_F(Converter_ConverterControllerTest, BatchConvert_Report)
+{
+    // [GIVEN] A batch of two jobs
+    io::path_t jobFile = writeBatchJobFile({ "a.mscz", "b.mscz" });
+
+    // [WHEN] Run it in this process
+    BatchOptions options;
+    options.reportPath = m_tempDir.filePath("report.jsonl");
+    Ret ret = m_controller->batchConvert(jobFile, io::path_t(), false, options);
+
+    // [THEN] All jobs succeeded
+    EXPECT_TRUE(ret.success());
+
+    // [THEN] The report has a line per job, in the order of the batch
+    QList<QJsonObject> report = readReport(options.reportPath);
+    ASSERT_EQ(report.size(), 2);
+
+    EXPECT_EQ(report[0].value("in").toString(), "a.mscz");
+    EXPECT_EQ(report[0].value("out").toString(), "a.mscz.pdf");
+    EXPECT_EQ(report[1].value("in").toString(), "b.mscz");
+    EXPECT_EQ(report[1].value("out").toString(), "b.mscz.pdf");
+
+    for (const QJsonObject& obj : report) {
+        EXPECT_TRUE(obj.value("success").toBool());
+        EXPECT_EQ(obj.value("error").toInt(), static_cast<int>(Ret::Code::Ok));
+        EXPECT_TRUE(obj.value("errorText").isString());
+        EXPECT_GE(obj.value("durationMs").toInt(-1), 0);
+    }
+}
+
+TEST_F(Converter_ConverterControllerTest, BatchConvert_FailedJobInTheMiddle)
+{
+    // [GIVEN] A batch whose second job fails
+    io::path_t jobFile = writeBatchJobFile({ "a.mscz", "broken.mscz", "c.mscz" });
+    m_controller->failingFiles << "broken.mscz";
+
+    // [WHEN] Run it in this process
+    BatchOptions options;
+    options.reportPath = m_tempDir.filePath("report.jsonl");
+    Ret ret = m_controller->batchConvert(jobFile, io::path_t(), false, options);
+
+    // [THEN] The batch failed, with the number of failed jobs
+    EXPECT_EQ(ret.code(), static_cast<int>(Err::BatchJobFailed));
+    EXPECT_EQ(ret.text(), "1 of 3 jobs failed");
+
+    // [THEN] The jobs after the failed one were run too
+    ASSERT_EQ(m_controller->convertedFiles.size(), 3);
+    EXPECT_EQ(m_controller->convertedFiles[2].first, io::path_t("c.mscz"));
+
+    // [THEN] Only the failed job is reported as failed, with its error
+    QList<QJsonObject> report = readReport(options.reportPath);
+    ASSERT_EQ(report.size(), 3);
+
+    EXPECT_TRUE(report[0].value("success").toBool());
+
+    EXPECT_EQ(report[1].value("in").toString(), "broken.mscz");
+    EXPECT_FALSE(report[1].value("success").toBool());
+    EXPECT_EQ(report[1].value("error").toInt(), static_cast<int>(Err::InFileFailedLoad));
+
+    EXPECT_TRUE(report[2].value("success").toBool());
+}
@@ -0,0 +1,114 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+
+#include "libmscore/bsp.h"
+#include "libmscore/masterscore.h"
+#include "libmscore/page.h"
+
+#include "utils/scorerw.h"
+
+#include "log.h"
+
+using namespace mu;
+using namespace mu::engraving;
+
+static const String ALL_ELEMENTS_DATA_DIR("all_elements_data/");
+
+class Engraving_BspBenchmarks : public ::testing::Test
+{
+public:
+    void benchmarkEditAndQuery(const String& file);
+};
+
+//---------------------------------------------------------
+//   benchmarkEditAndQuery
+//    moves everything on the pages back and forth and
+//    queries the page trees after every layout, the first
+//    query of a page also brings its tree up to date
+//---------------------------------------------------------
+
+void Engraving_BspBenchmarks::benchmarkEditAndQuery(const String& file)
+{
+    MasterScore* score = ScoreRW::readScore(ALL_ELEMENTS_DATA_DIR + file);
+    ASSERT_TRUE(score);
+
+    size_t queries = 0;
+    long long queryTime = 0;
+
+    auto queryPages = [score, &queries, &queryTime]() {
+        auto start = std::chrono::steady_clock::now();
+        for (Page* page : score->pages()) {
+            const RectF pageRect = page->abbox();
+            const int steps = 8;
+            const double w = pageRect.width() / steps;
+            const double h = pageRect.height() / steps;
+            for (int i = 0; i < steps; ++i) {
+                for (int j = 0; j < steps; ++j) {
+                    page->items(RectF(pageRect.left() + i * w, pageRect.top() + j * h, w, h));
+                    ++queries;
+                }
+            }
+        }
+        queryTime += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    };
+
+    for (int i = 0; i < 5; ++i) {
+        score->startCmd();
+        score->undoChangeStyleVal(Sid::staffDistance, Spatium(8.0));
+        score->endCmd();
+        queryPages();
+
+        score->undoRedo(true, nullptr);
+        queryPages();
+    }
+
+    BspTree::Stats total;
+    for (const Page* page : score->pages()) {
+        const BspTree::Stats& stats = page->bspTreeStats();
+        total.fullRebuilds += stats.fullRebuilds;
+        total.incrementalUpdates += stats.incrementalUpdates;
+        total.insertedItems += stats.insertedItems;
+        total.movedItems += stats.movedItems;
+        total.removedItems += stats.removedItems;
+    }
+
+    LOGI() << file << ": " << score->pages().size() << " pages, " << total.fullRebuilds << " full rebuilds, "
+           << total.incrementalUpdates << " incremental updates ("
+           << total.insertedItems << " inserted, " << total.movedItems << " moved, " << total.removedItems << " removed), "
+           << queries << " queries in " << queryTime << " us";
+
+    delete score;
+}
+
+TEST_F(Engraving_BspBenchmarks, EditAndQuery_Moonlight)
+{
+    benchmarkEditAndQuery(u"moonlight.mscx");
+}
+
+TEST_F(Engraving_BspBenchmarks, EditAndQuery_Goldberg)
+{
+    benchmarkEditAndQuery(u"goldberg.mscx");
+}
@@ -0,0 +1,95 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+
+#include "libmscore/masterscore.h"
+#include "libmscore/measure.h"
+
+#include "utils/scorerw.h"
+
+#include "log.h"
+
+using namespace mu;
+using namespace mu::engraving;
+
+static const String ALL_ELEMENTS_DATA_DIR("all_elements_data/");
+
+class Engraving_LayoutBenchmarks : public ::testing::Test
+{
+public:
+    void benchmarkMeasureWidthCache(const String& file);
+};
+
+static long long layoutTime(Score* score)
+{
+    auto start = std::chrono::steady_clock::now();
+    score->doLayout();
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+//---------------------------------------------------------
+//   benchmarkMeasureWidthCache
+//    times the layout after a page size change with the
+//    cached measure widths and with all of them computed
+//    again
+//---------------------------------------------------------
+
+void Engraving_LayoutBenchmarks::benchmarkMeasureWidthCache(const String& file)
+{
+    MasterScore* score = ScoreRW::readScore(ALL_ELEMENTS_DATA_DIR + file);
+    ASSERT_TRUE(score);
+
+    const double pageWidth = score->styleD(Sid::pageWidth);
+    const double printableWidth = score->styleD(Sid::pagePrintableWidth);
+
+    for (double delta : { -1.0, 0.5 }) {
+        score->startCmd();
+        score->undoChangeStyleVal(Sid::pageWidth, pageWidth + delta);
+        score->undoChangeStyleVal(Sid::pagePrintableWidth, printableWidth + delta);
+        score->endCmd();
+
+        long long cachedTime = layoutTime(score);
+
+        for (Measure* m = score->firstMeasure(); m; m = m->nextMeasure()) {
+            m->invalidateWidthCache();
+        }
+        long long uncachedTime = layoutTime(score);
+
+        LOGI() << file << ", page width " << pageWidth + delta << ": layout " << cachedTime << " us with the width cache, "
+               << uncachedTime << " us without";
+    }
+
+    delete score;
+}
+
+TEST_F(Engraving_LayoutBenchmarks, MeasureWidthCache_Moonlight)
+{
+    benchmarkMeasureWidthCache(u"moonlight.mscx");
+}
+
+TEST_F(Engraving_LayoutBenchmarks, MeasureWidthCache_Goldberg)
+{
+    benchmarkMeasureWidthCache(u"goldberg.mscx");
+}
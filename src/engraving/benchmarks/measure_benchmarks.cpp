@@ -0,0 +1,102 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+
+#include "libmscore/masterscore.h"
+#include "libmscore/measure.h"
+
+#include "utils/scorerw.h"
+
+#include "log.h"
+
+using namespace mu;
+using namespace mu::engraving;
+
+static const String MEASURE_DATA_DIR("measure_data/");
+
+class Engraving_MeasureBenchmarks : public ::testing::Test
+{
+};
+
+//---------------------------------------------------------
+//   linearTick2measure
+//    walks the measure chain, like tick2measure did before
+//    the index
+//---------------------------------------------------------
+
+static Measure* linearTick2measure(const Score* score, const Fraction& tick)
+{
+    Measure* lm = nullptr;
+    for (Measure* m = score->firstMeasure(); m; m = m->nextMeasure()) {
+        if (tick < m->tick()) {
+            return lm;
+        }
+        lm = m;
+    }
+    if (lm && tick >= lm->tick() && tick <= lm->endTick()) {
+        return lm;
+    }
+    return nullptr;
+}
+
+//---------------------------------------------------------
+//   tick2measure
+//    compares the indexed lookup with walking the measure
+//    list
+//---------------------------------------------------------
+
+TEST_F(Engraving_MeasureBenchmarks, tick2measure)
+{
+    MasterScore* score = ScoreRW::readScore(MEASURE_DATA_DIR + u"measure-1.mscx");
+    ASSERT_TRUE(score);
+
+    score->startCmd();
+    score->appendMeasures(2000);
+    score->endCmd();
+
+    const Fraction endTick = score->lastMeasure()->endTick();
+    const Fraction step(1, 4);
+
+    using clock = std::chrono::steady_clock;
+    size_t found = 0;
+
+    clock::time_point start = clock::now();
+    for (Fraction tick = step; tick < endTick; tick += step) {
+        found += linearTick2measure(score, tick) ? 1 : 0;
+    }
+    long long linearUs = std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - start).count();
+
+    start = clock::now();
+    for (Fraction tick = step; tick < endTick; tick += step) {
+        found -= score->tick2measure(tick) ? 1 : 0;
+    }
+    long long indexedUs = std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - start).count();
+
+    EXPECT_EQ(found, 0);
+    LOGI() << "tick2measure over " << score->nmeasures() << " measures: linear " << linearUs
+           << " us, indexed " << indexedUs << " us";
+
+    delete score;
+}
@@ -0,0 +1,122 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <chrono>
+
+#include "concurrency.h"
+#include "io/buffer.h"
+#include "infrastructure/mscwriter.h"
+#include "infrastructure/mscreader.h"
+
+#include "log.h"
+
+using namespace mu;
+using namespace mu::io;
+using namespace mu::engraving;
+
+class Engraving_MsczFileBenchmarks : public ::testing::Test
+{
+public:
+};
+
+TEST_F(Engraving_MsczFileBenchmarks, MsczFile_ReadExcerpts_Concurrently)
+{
+    //! CASE Reading the excerpts of a large score one by one and from several threads, like ScoreReader::loadMscz does
+
+    //! GIVEN A file with many large excerpts
+    const size_t excerptCount = 40;
+
+    std::vector<ByteArray> originExcerptDatas;
+    uint32_t seed = 1;
+    for (size_t i = 0; i < excerptCount; ++i) {
+        std::string data = "<museScore version=\"4.00\">\n<Score>\n";
+        for (int m = 0; m < 5000; ++m) {
+            seed = seed * 1103515245 + 12345;
+            data += "<Measure><voice><Chord><durationType>quarter</durationType><Note><pitch>"
+                    + std::to_string(seed % 128) + "</pitch><tpc>" + std::to_string((seed >> 8) % 35)
+                    + "</tpc></Note></Chord></voice></Measure>\n";
+        }
+        data += "</Score>\n</museScore>\n";
+        originExcerptDatas.push_back(ByteArray(data.c_str()));
+    }
+
+    ByteArray msczData;
+    {
+        Buffer buf(&msczData);
+        MscWriter::Params params;
+        params.device = &buf;
+        params.filePath = "excerpts.mscz";
+        params.mode = MscIoMode::Zip;
+
+        MscWriter writer(params);
+        writer.open();
+
+        writer.writeScoreFile(ByteArray("score"));
+        for (size_t i = 0; i < excerptCount; ++i) {
+            String name = u"Part " + String::number(int(i));
+            writer.addExcerptStyleFile(name, ByteArray("style"));
+            writer.addExcerptFile(name, originExcerptDatas.at(i));
+        }
+    }
+
+    Buffer buf(&msczData);
+    MscReader::Params params;
+    params.device = &buf;
+    params.filePath = "excerpts.mscz";
+    params.mode = MscIoMode::Zip;
+
+    MscReader reader(params);
+    reader.open();
+
+    std::vector<String> names = reader.excerptNames();
+    ASSERT_EQ(names.size(), excerptCount);
+
+    using clock = std::chrono::steady_clock;
+
+    //! DO Read the excerpts one by one
+    std::vector<ByteArray> serialDatas(excerptCount);
+    clock::time_point serialStart = clock::now();
+    for (size_t i = 0; i < excerptCount; ++i) {
+        serialDatas[i] = reader.readExcerptFile(names.at(i));
+    }
+    clock::duration serialTime = clock::now() - serialStart;
+
+    //! DO Read the excerpts concurrently
+    std::vector<ByteArray> concurrentDatas(excerptCount);
+    std::vector<ByteArray> concurrentStyleDatas(excerptCount);
+    clock::time_point concurrentStart = clock::now();
+    concurrency::parallelFor(excerptCount, [&](size_t i) {
+        concurrentStyleDatas[i] = reader.readExcerptStyleFile(names.at(i));
+        concurrentDatas[i] = reader.readExcerptFile(names.at(i));
+    }, std::max<size_t>(concurrency::idealThreadCount(), 4));
+    clock::duration concurrentTime = clock::now() - concurrentStart;
+
+    for (size_t i = 0; i < excerptCount; ++i) {
+        EXPECT_EQ(serialDatas.at(i), concurrentDatas.at(i));
+    }
+
+    using ms = std::chrono::milliseconds;
+    LOGI() << "excerpts: " << excerptCount
+           << ", one by one: " << std::chrono::duration_cast<ms>(serialTime).count() << " ms"
+           << ", concurrently: " << std::chrono::duration_cast<ms>(concurrentTime).count() << " ms";
+}
@@ -0,0 +1,100 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <chrono>
+#include <memory>
+
+#include "mpe/tests/mocks/articulationprofilesrepositorymock.h"
+
+#include "utils/scorerw.h"
+#include "libmscore/part.h"
+
+#include "playback/playbackmodel.h"
+
+#include "log.h"
+
+using ::testing::NiceMock;
+using ::testing::Return;
+using ::testing::_;
+
+using namespace mu::engraving;
+using namespace mu::mpe;
+using namespace mu;
+
+static const String PLAYBACK_MODEL_TEST_FILES_DIR("playbackmodel_data/");
+
+class Engraving_PlaybackModelBenchmarks : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        m_repositoryMock = std::make_shared<NiceMock<ArticulationProfilesRepositoryMock> >();
+        ON_CALL(*m_repositoryMock, defaultProfile(_)).WillByDefault(Return(std::make_shared<ArticulationsProfile>()));
+    }
+
+    std::shared_ptr<NiceMock<ArticulationProfilesRepositoryMock> > m_repositoryMock = nullptr;
+};
+
+/**
+ * @brief PlaybackModelBenchmarks_Parallel_Rendering
+ * @details Every test score is loaded several times with the parts rendered on a single thread and in parallel,
+ *          the timings are logged to see the scaling
+ */
+TEST_F(Engraving_PlaybackModelBenchmarks, Parallel_Rendering)
+{
+    const std::vector<String> scoreNames = {
+        u"repeat_range", u"repeat_with_2_voltas", u"da_capo_al_fine", u"dal_segno_al_coda", u"dal_segno_al_fine",
+        u"da_capo_al_coda", u"pizz_to_arco", u"metronome_4_4", u"metronome_6_4_with_repeat", u"note_entry_playback_note",
+        u"note_entry_playback_chord", u"playback_setup_instruments"
+    };
+
+    static constexpr int LOADS_COUNT = 20;
+
+    for (const String& scoreName : scoreNames) {
+        Score* score = ScoreRW::readScore(PLAYBACK_MODEL_TEST_FILES_DIR + scoreName + u"/" + scoreName + u".mscx");
+        ASSERT_TRUE(score);
+
+        std::unordered_map<size_t, std::chrono::microseconds> loadTimes;
+
+        for (size_t threadCount : { 1, 0 }) {
+            auto start = std::chrono::steady_clock::now();
+
+            for (int i = 0; i < LOADS_COUNT; ++i) {
+                PlaybackModel model;
+                model.setprofilesRepository(m_repositoryMock);
+                model.setMaxRenderThreadCount(threadCount);
+                model.load(score);
+            }
+
+            loadTimes[threadCount] = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+        }
+
+        LOGI() << scoreName.toStdString() << ": " << score->parts().size() << " parts, "
+               << loadTimes[1].count() / LOADS_COUNT << " us on one thread, "
+               << loadTimes[0].count() / LOADS_COUNT << " us in parallel";
+
+        delete score;
+    }
+}
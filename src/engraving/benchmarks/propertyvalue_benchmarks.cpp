@@ -0,0 +1,147 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+
+#include "types/propertyvalue.h"
+
+#include "libmscore/engravingitem.h"
+#include "libmscore/masterscore.h"
+
+#include "utils/scorerw.h"
+
+#include "log.h"
+
+using namespace mu;
+using namespace mu::engraving;
+
+static const String ALL_ELEMENTS_DATA_DIR("all_elements_data/");
+
+//---------------------------------------------------------
+//   allocation counter
+//    the global operator new is replaced for the whole benchmark
+//    executable, it only counts the allocations
+//---------------------------------------------------------
+
+static std::atomic<size_t> s_allocations { 0 };
+
+void* operator new(size_t size)
+{
+    ++s_allocations;
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept
+{
+    std::free(p);
+}
+
+class Engraving_PropertyValueBenchmarks : public ::testing::Test
+{
+};
+
+static void collectItem(void* data, EngravingItem* e)
+{
+    static_cast<std::vector<EngravingItem*>*>(data)->push_back(e);
+}
+
+//---------------------------------------------------------
+//   noAllocationsForInlineTypes
+//    scalars, points, fractions, colors and enums must not
+//    touch the heap
+//---------------------------------------------------------
+
+TEST_F(Engraving_PropertyValueBenchmarks, noAllocationsForInlineTypes)
+{
+    size_t before = s_allocations;
+    for (int i = 0; i < 1000; ++i) {
+        PropertyValue values[] = {
+            PropertyValue(i % 2 == 0),
+            PropertyValue(i),
+            PropertyValue(double(i)),
+            PropertyValue(PointF(i, i)),
+            PropertyValue(Fraction(i, 4)),
+            PropertyValue(Color(i % 256, 0, 0)),
+            PropertyValue(Spatium(i)),
+            PropertyValue(DirectionV::UP),
+            PropertyValue(Align(AlignH::HCENTER, AlignV::BASELINE)),
+        };
+        for (const PropertyValue& v : values) {
+            PropertyValue copy = v;
+            EXPECT_EQ(copy, v);
+        }
+    }
+    EXPECT_EQ(s_allocations - before, 0);
+}
+
+//---------------------------------------------------------
+//   layoutAllocationsBenchmark
+//    allocations done by a full layout and by reading the
+//    common properties of every item of a large score
+//---------------------------------------------------------
+
+TEST_F(Engraving_PropertyValueBenchmarks, layoutAllocationsBenchmark)
+{
+    MasterScore* score = ScoreRW::readScore(ALL_ELEMENTS_DATA_DIR + u"moonlight.mscx");
+    ASSERT_TRUE(score);
+
+    size_t before = s_allocations;
+    auto start = std::chrono::steady_clock::now();
+    score->doLayout();
+    auto end = std::chrono::steady_clock::now();
+    size_t layoutAllocations = s_allocations - before;
+
+    std::vector<EngravingItem*> items;
+    score->scanElements(&items, collectItem, /* all */ true);
+
+    static const Pid pids[] = { Pid::VISIBLE, Pid::COLOR, Pid::Z, Pid::OFFSET, Pid::PLACEMENT, Pid::AUTOPLACE, Pid::MIN_DISTANCE };
+
+    before = s_allocations;
+    size_t properties = 0;
+    for (const EngravingItem* item : items) {
+        for (Pid pid : pids) {
+            PropertyValue v = item->getProperty(pid);
+            PropertyValue d = item->propertyDefault(pid);
+            properties += v == d ? 1 : 2;
+        }
+    }
+    size_t propertyAllocations = s_allocations - before;
+
+    LOGI() << "full layout: " << layoutAllocations << " allocations, "
+           << std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() << " us";
+    LOGI() << "property sweep over " << items.size() << " items: " << propertyAllocations << " allocations (" << properties << ")";
+
+    delete score;
+}
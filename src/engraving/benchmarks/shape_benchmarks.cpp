@@ -0,0 +1,87 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+
+#include "libmscore/masterscore.h"
+#include "libmscore/measure.h"
+#include "libmscore/segment.h"
+#include "libmscore/shape.h"
+
+#include "utils/scorerw.h"
+
+#include "log.h"
+
+using namespace mu;
+using namespace mu::engraving;
+
+static const String ALL_ELEMENTS_DATA_DIR("all_elements_data/");
+
+class Engraving_ShapeBenchmarks : public ::testing::Test
+{
+public:
+    void benchmarkMinHorizontalDistance(const String& file);
+};
+
+//---------------------------------------------------------
+//   benchmarkMinHorizontalDistance
+//    distance between the shapes of all adjacent segments
+//    of every staff, like the horizontal spacing needs it
+//---------------------------------------------------------
+
+void Engraving_ShapeBenchmarks::benchmarkMinHorizontalDistance(const String& file)
+{
+    MasterScore* score = ScoreRW::readScore(ALL_ELEMENTS_DATA_DIR + file);
+    ASSERT_TRUE(score);
+
+    std::vector<std::pair<const Shape*, const Shape*> > pairs;
+    for (Measure* m = score->firstMeasure(); m; m = m->nextMeasure()) {
+        for (Segment* s = m->first(); s && s->next(); s = s->next()) {
+            for (staff_idx_t staffIdx = 0; staffIdx < score->nstaves(); ++staffIdx) {
+                pairs.push_back({ &s->staffShape(staffIdx), &s->next()->staffShape(staffIdx) });
+            }
+        }
+    }
+
+    double sum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (const auto& p : pairs) {
+        sum += p.first->minHorizontalDistance(*p.second, score);
+    }
+    auto us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+    LOGI() << file << ": " << pairs.size() << " shape pairs in " << us << " us (sum " << sum << ")";
+
+    delete score;
+}
+
+TEST_F(Engraving_ShapeBenchmarks, MinHorizontalDistance_Moonlight)
+{
+    benchmarkMinHorizontalDistance(u"moonlight.mscx");
+}
+
+TEST_F(Engraving_ShapeBenchmarks, MinHorizontalDistance_Goldberg)
+{
+    benchmarkMinHorizontalDistance(u"goldberg.mscx");
+}
@@ -0,0 +1,99 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+
+#include "libmscore/masterscore.h"
+#include "libmscore/measure.h"
+#include "libmscore/segment.h"
+#include "libmscore/shape.h"
+#include "libmscore/skyline.h"
+
+#include "utils/scorerw.h"
+
+#include "log.h"
+
+using namespace mu;
+using namespace mu::engraving;
+
+static const String ALL_ELEMENTS_DATA_DIR("all_elements_data/");
+
+class Engraving_SkylineBenchmarks : public ::testing::Test
+{
+public:
+    void benchmarkMinDistanceBySegment(const String& file);
+};
+
+//---------------------------------------------------------
+//   benchmarkMinDistanceBySegment
+//    replays the skyline use of the layout: the shape of
+//    each segment is compared with the skyline of the
+//    segments before it, and then added to it
+//---------------------------------------------------------
+
+void Engraving_SkylineBenchmarks::benchmarkMinDistanceBySegment(const String& file)
+{
+    MasterScore* score = ScoreRW::readScore(ALL_ELEMENTS_DATA_DIR + file);
+    ASSERT_TRUE(score);
+
+    std::vector<Shape> shapes;
+    for (Measure* m = score->firstMeasure(); m; m = m->nextMeasure()) {
+        for (Segment* s = m->first(); s; s = s->next()) {
+            for (staff_idx_t staffIdx = 0; staffIdx < score->nstaves(); ++staffIdx) {
+                shapes.push_back(s->staffShape(staffIdx).translated(s->pos() + m->pos()));
+            }
+        }
+    }
+
+    size_t rectCount = 0;
+    double dist = 0.0;
+
+    auto start = std::chrono::steady_clock::now();
+
+    SkylineLine south(false);
+    for (const Shape& shape : shapes) {
+        SkylineLine north(true);
+        north.add(shape);
+        dist = std::max(dist, south.minDistance(north));
+
+        south.add(shape);
+        rectCount += shape.size();
+    }
+
+    auto us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    LOGI() << file << ": " << shapes.size() << " shapes, " << rectCount << " rectangles added and queried in " << us << " us"
+           << " (max distance " << dist << ")";
+
+    delete score;
+}
+
+TEST_F(Engraving_SkylineBenchmarks, MinDistanceBySegment_Moonlight)
+{
+    benchmarkMinDistanceBySegment(u"moonlight.mscx");
+}
+
+TEST_F(Engraving_SkylineBenchmarks, MinDistanceBySegment_Goldberg)
+{
+    benchmarkMinDistanceBySegment(u"goldberg.mscx");
+}
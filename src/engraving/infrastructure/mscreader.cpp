@@ -67,6 +67,10 @@ const MscReader::Params& MscReader::params() const
 
 bool MscReader::open()
 {
+    if (!m_params.device && !m_params.filePath.empty()) {
+        m_fileStamp = fileStamp(m_params.filePath);
+    }
+
     return reader()->open(m_params.device, m_params.filePath);
 }
 
@@ -85,6 +89,11 @@ bool MscReader::isOpened() const
     return m_reader ? m_reader->isOpened() : false;
 }
 
+bool MscReader::isContainer() const
+{
+    return reader()->isContainer();
+}
+
 MscReader::IReader* MscReader::reader() const
 {
     if (!m_reader) {
@@ -220,6 +229,55 @@ ByteArray MscReader::readAudioFile() const
     return fileData(u"audio.ogg");
 }
 
+MscReader::FileLoader MscReader::fileLoader(const String& fileName) const
+{
+    //! NOTE Only a zip file opened by its path can be opened again later
+    if (m_params.mode != MscIoMode::Zip || m_params.device || m_params.filePath.empty()) {
+        return FileLoader();
+    }
+
+    path_t filePath = m_params.filePath;
+    FileStamp openedStamp = m_fileStamp;
+    return [filePath, fileName, openedStamp]() {
+        if (fileStamp(filePath) != openedStamp) {
+            LOGE() << "the file was changed or removed since it was opened, can't read " << fileName << " from " << filePath;
+            return ByteArray();
+        }
+
+        ZipFileReader zipReader;
+        if (!zipReader.open(nullptr, filePath)) {
+            return ByteArray();
+        }
+
+        ByteArray data = zipReader.fileData(fileName);
+        zipReader.close();
+        return data;
+    };
+}
+
+MscReader::FileStamp MscReader::fileStamp(const path_t& filePath)
+{
+    FileStamp stamp;
+    RetVal<uint64_t> size = fileSystem()->fileSize(filePath);
+    if (!size.ret) {
+        return stamp;
+    }
+
+    stamp.size = size.val;
+    stamp.lastModified = fileSystem()->lastModified(filePath);
+    return stamp;
+}
+
+MscReader::FileLoader MscReader::imageFileLoader(const String& fileName) const
+{
+    return fileLoader(u"Pictures/" + fileName);
+}
+
+MscReader::FileLoader MscReader::audioFileLoader() const
+{
+    return fileLoader(u"audio.ogg");
+}
+
 ByteArray MscReader::readAudioSettingsJsonFile() const
 {
     return fileData(u"audiosettings.json");
@@ -422,6 +480,8 @@ StringList MscReader::XmlFileReader::fileList() const
         return StringList();
     }
 
+    std::lock_guard<std::mutex> lock(m_deviceMutex);
+
     StringList files;
 
     m_device->seek(0);
@@ -453,6 +513,9 @@ ByteArray MscReader::XmlFileReader::fileData(const String& fileName) const
         return ByteArray();
     }
 
+    //! NOTE All files are read from the one device
+    std::lock_guard<std::mutex> lock(m_deviceMutex);
+
     m_device->seek(0);
     XmlStreamReader xml(m_device);
     while (xml.readNextStartElement()) {
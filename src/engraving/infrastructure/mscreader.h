@@ -22,9 +22,15 @@
 #ifndef MU_ENGRAVING_MSCREADER_H
 #define MU_ENGRAVING_MSCREADER_H
 
+#include <functional>
+#include <mutex>
+
+#include "modularity/ioc.h"
 #include "types/string.h"
+#include "types/datetime.h"
 #include "io/path.h"
 #include "io/iodevice.h"
+#include "io/ifilesystem.h"
 #include "mscio.h"
 
 namespace mu {
@@ -34,6 +40,8 @@ class ZipReader;
 namespace mu::engraving {
 class MscReader
 {
+    INJECT_STATIC(engraving, io::IFileSystem, fileSystem)
+
 public:
 
     struct Params
@@ -54,7 +62,9 @@ public:
     bool open();
     void close();
     bool isOpened() const;
+    bool isContainer() const;
 
+    //! NOTE Once opened, the files can be read from several threads at once
     ByteArray readStyleFile() const;
     ByteArray readScoreFile() const;
 
@@ -72,6 +82,14 @@ public:
     ByteArray readAudioSettingsJsonFile() const;
     ByteArray readViewSettingsJsonFile() const;
 
+    //! NOTE A loader opens the container again by its path and reads the file when it is called,
+    //! so the data can be loaded on first use without keeping the container in memory.
+    //! If the container was changed, moved or removed since it was opened, the loader returns no data.
+    //! Returns an empty loader if the container isn't a zip file read by its path
+    using FileLoader = std::function<ByteArray()>;
+    FileLoader imageFileLoader(const String& fileName) const;
+    FileLoader audioFileLoader() const;
+
 private:
 
     struct IReader {
@@ -126,14 +144,28 @@ private:
     private:
         io::IODevice* m_device = nullptr;
         bool m_selfDeviceOwner = false;
+        mutable std::mutex m_deviceMutex;
     };
 
     IReader* reader() const;
     ByteArray fileData(const String& fileName) const;
+    FileLoader fileLoader(const String& fileName) const;
 
     String mainFileName() const;
 
+    //! NOTE Identifies the version of the file the container was opened from
+    struct FileStamp {
+        uint64_t size = 0;
+        DateTime lastModified;
+
+        bool operator==(const FileStamp& s) const { return size == s.size && lastModified == s.lastModified; }
+        bool operator!=(const FileStamp& s) const { return !operator==(s); }
+    };
+
+    static FileStamp fileStamp(const io::path_t& filePath);
+
     Params m_params;
+    FileStamp m_fileStamp;
     mutable IReader* m_reader = nullptr;
 };
 }
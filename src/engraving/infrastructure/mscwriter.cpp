@@ -94,7 +94,7 @@ MscWriter::IWriter* MscWriter::writer() const
     if (!m_writer) {
         switch (m_params.mode) {
         case MscIoMode::Zip:
-            m_writer = new ZipFileWriter();
+            m_writer = new ZipFileWriter(m_params.compressionLevel);
             break;
         case MscIoMode::Dir:
             m_writer = new DirWriter();
@@ -123,6 +123,51 @@ bool MscWriter::addFileData(const String& fileName, const ByteArray& data)
     return true;
 }
 
+io::IODevice* MscWriter::beginFile(const String& fileName)
+{
+    IF_ASSERT_FAILED(m_streamFileName.empty()) {
+        return nullptr;
+    }
+
+    m_streamFileName = fileName;
+
+    //! NOTE If the writer can't write by stream, the file is collected in memory
+    IODevice* device = writer()->beginFileData(fileName);
+    if (!device) {
+        m_streamData.clear();
+        m_streamBuffer.open(IODevice::WriteOnly);
+        device = &m_streamBuffer;
+    }
+
+    return device;
+}
+
+bool MscWriter::endFile()
+{
+    IF_ASSERT_FAILED(!m_streamFileName.empty()) {
+        return false;
+    }
+
+    String fileName = m_streamFileName;
+    m_streamFileName.clear();
+
+    if (m_streamBuffer.isOpen()) {
+        m_streamBuffer.close();
+        ByteArray data = m_streamData;
+        m_streamData = ByteArray();
+        return addFileData(fileName, data);
+    }
+
+    if (!writer()->endFileData()) {
+        LOGE() << "failed write file: " << fileName;
+        return false;
+    }
+
+    m_meta.addFile(fileName);
+
+    return true;
+}
+
 void MscWriter::writeStyleFile(const ByteArray& data)
 {
     addFileData(u"score_style.mss", data);
@@ -152,6 +197,11 @@ void MscWriter::writeScoreFile(const ByteArray& data)
     addFileData(mainFileName(), data);
 }
 
+IODevice* MscWriter::beginScoreFile()
+{
+    return beginFile(mainFileName());
+}
+
 void MscWriter::addExcerptStyleFile(const String& name, const ByteArray& data)
 {
     String fileName = name + u".mss";
@@ -164,6 +214,12 @@ void MscWriter::addExcerptFile(const String& name, const ByteArray& data)
     addFileData(u"Excerpts/" + fileName, data);
 }
 
+IODevice* MscWriter::beginExcerptFile(const String& name)
+{
+    String fileName = name + u".mscx";
+    return beginFile(u"Excerpts/" + fileName);
+}
+
 void MscWriter::writeChordListFile(const ByteArray& data)
 {
     addFileData(u"chordlist.xml", data);
@@ -245,6 +301,11 @@ void MscWriter::Meta::addFile(const String& file)
 // Writers
 // =======================================================================
 
+MscWriter::ZipFileWriter::ZipFileWriter(int compressionLevel)
+    : m_compressionLevel(compressionLevel)
+{
+}
+
 MscWriter::ZipFileWriter::~ZipFileWriter()
 {
     delete m_zip;
@@ -269,6 +330,7 @@ bool MscWriter::ZipFileWriter::open(io::IODevice* device, const path_t& filePath
     }
 
     m_zip = new ZipWriter(m_device);
+    m_zip->setCompressionLevel(m_compressionLevel);
 
     return true;
 }
@@ -303,6 +365,29 @@ bool MscWriter::ZipFileWriter::addFileData(const String& fileName, const ByteArr
     return true;
 }
 
+IODevice* MscWriter::ZipFileWriter::beginFileData(const String& fileName)
+{
+    IF_ASSERT_FAILED(m_zip) {
+        return nullptr;
+    }
+
+    return m_zip->beginFile(fileName.toStdString());
+}
+
+bool MscWriter::ZipFileWriter::endFileData()
+{
+    IF_ASSERT_FAILED(m_zip) {
+        return false;
+    }
+
+    m_zip->endFile();
+    if (m_zip->hasError()) {
+        LOGE() << "failed write files to zip";
+        return false;
+    }
+    return true;
+}
+
 bool MscWriter::DirWriter::open(io::IODevice* device, const io::path_t& filePath)
 {
     if (device) {
@@ -25,6 +25,7 @@
 #include "types/string.h"
 #include "io/path.h"
 #include "io/iodevice.h"
+#include "io/buffer.h"
 #include "mscio.h"
 
 namespace mu {
@@ -43,6 +44,8 @@ public:
         io::path_t filePath;
         String mainFileName;
         MscIoMode mode = MscIoMode::Zip;
+        //! NOTE For the Zip mode; zlib levels: 1 is the fastest, 9 the smallest, -1 is the default
+        int compressionLevel = -1;
     };
 
     MscWriter() = default;
@@ -67,6 +70,13 @@ public:
     void writeAudioSettingsJsonFile(const ByteArray& data);
     void writeViewSettingsJsonFile(const ByteArray& data);
 
+    //! NOTE The score can be written straight into the container by these devices,
+    //! in the Zip mode the data is compressed as it is written.
+    //! The device is valid until endFile()
+    io::IODevice* beginScoreFile();
+    io::IODevice* beginExcerptFile(const String& name);
+    bool endFile();
+
 private:
 
     struct IWriter {
@@ -76,20 +86,28 @@ private:
         virtual void close() = 0;
         virtual bool isOpened() const = 0;
         virtual bool addFileData(const String& fileName, const ByteArray& data) = 0;
+
+        //! NOTE Returns nullptr, if the writer can't write a file by stream
+        virtual io::IODevice* beginFileData(const String& /*fileName*/) { return nullptr; }
+        virtual bool endFileData() { return false; }
     };
 
     struct ZipFileWriter : public IWriter
     {
+        ZipFileWriter(int compressionLevel);
         ~ZipFileWriter() override;
         bool open(io::IODevice* device, const io::path_t& filePath) override;
         void close() override;
         bool isOpened() const override;
         bool addFileData(const String& fileName, const ByteArray& data) override;
+        io::IODevice* beginFileData(const String& fileName) override;
+        bool endFileData() override;
 
     private:
         io::IODevice* m_device = nullptr;
         bool m_selfDeviceOwner = false;
         ZipWriter* m_zip = nullptr;
+        int m_compressionLevel = -1;
     };
 
     struct DirWriter : public IWriter
@@ -126,6 +144,7 @@ private:
     IWriter* writer() const;
 
     bool addFileData(const String& fileName, const ByteArray& data);
+    io::IODevice* beginFile(const String& fileName);
 
     void writeMeta();
     void writeContainer(const std::vector<String>& paths);
@@ -135,6 +154,10 @@ private:
     Params m_params;
     mutable IWriter* m_writer = nullptr;
     Meta m_meta;
+
+    String m_streamFileName;
+    ByteArray m_streamData;
+    io::Buffer m_streamBuffer { &m_streamData };
 };
 }
 
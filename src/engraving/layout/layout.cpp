@@ -266,6 +266,9 @@ void Layout::doLayout(const LayoutOptions& options, LayoutContext& lc)
         }
     }
     lc.score()->systems().insert(lc.score()->systems().end(), lc.systemList.begin(), lc.systemList.end());
+
+    DeleteAll(lc.obsoleteSystems);
+    lc.obsoleteSystems.clear();
 }
 
 //---------------------------------------------------------
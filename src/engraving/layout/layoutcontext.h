@@ -53,6 +53,7 @@ public:
     Fraction tick{ 0, 1 };
 
     std::vector<System*> systemList; // reusable systems
+    std::vector<System*> obsoleteSystems; // systems of previous layout whose measures moved elsewhere
     std::set<Spanner*> processedSpanners;
 
     System* prevSystem = nullptr; // used during page layout
@@ -309,7 +309,9 @@ System* LayoutSystem::collectSystem(const LayoutOptions& options, LayoutContext&
     if (ctx.endTick < ctx.prevMeasure->tick()) {
         // we've processed the entire range
         // but we need to continue layout until we reach a system whose last measure is the same as previous layout
-        if (ctx.prevMeasure == ctx.systemOldMeasure) {
+        // or until the next system of the previous layout starts right after this system
+        dropObsoleteSystems(ctx);
+        if (ctx.prevMeasure == ctx.systemOldMeasure || oldSystemStartsAt(ctx, ctx.curMeasure)) {
             // this system ends in the same place as the previous layout
             // ok to stop
             if (ctx.curMeasure && ctx.curMeasure->isMeasure()) {
@@ -491,7 +493,13 @@ System* LayoutSystem::getNextSystem(LayoutContext& ctx)
     Score* score = ctx.score();
     bool isVBox = ctx.curMeasure->isVBox();
     System* system = nullptr;
-    if (ctx.systemList.empty()) {
+    dropObsoleteSystems(ctx);
+    // if the edit pushed measures down, the next old system may still be
+    // reused unchanged later on, so don't recycle it for an earlier system
+    const System* oldSystem = ctx.systemList.empty() ? nullptr : ctx.systemList.front();
+    bool oldSystemAhead = oldSystem && !oldSystem->measures().empty()
+                          && oldSystem->measures().front()->tick() > ctx.curMeasure->tick();
+    if (ctx.systemList.empty() || oldSystemAhead) {
         system = Factory::createSystem(score->dummy()->page());
         ctx.systemOldMeasure = 0;
     } else {
@@ -510,6 +518,49 @@ System* LayoutSystem::getNextSystem(LayoutContext& ctx)
     return system;
 }
 
+//---------------------------------------------------------
+//   dropObsoleteSystems
+//    remove systems of the previous layout from the reusable
+//    list once all their measures have been collected into
+//    earlier systems (the edit pulled measures up)
+//---------------------------------------------------------
+
+void LayoutSystem::dropObsoleteSystems(LayoutContext& ctx)
+{
+    if (!ctx.curMeasure) {
+        return;
+    }
+    const Fraction tick = ctx.curMeasure->tick();
+    while (!ctx.systemList.empty()) {
+        System* system = ctx.systemList.front();
+        if (system->measures().empty()) {
+            break;
+        }
+        const MeasureBase* last = system->measures().back();
+        // frames have no duration, they are never considered obsolete
+        if (last == ctx.curMeasure || last->ticks().isZero() || last->endTick() > tick) {
+            break;
+        }
+        ctx.obsoleteSystems.push_back(mu::takeFirst(ctx.systemList));
+    }
+}
+
+//---------------------------------------------------------
+//   oldSystemStartsAt
+//    return true if the next reusable system of the previous
+//    layout starts with mb, i.e. all systems from here on
+//    can be taken over unchanged
+//---------------------------------------------------------
+
+bool LayoutSystem::oldSystemStartsAt(const LayoutContext& ctx, const MeasureBase* mb)
+{
+    if (!mb || ctx.systemList.empty()) {
+        return false;
+    }
+    const System* system = ctx.systemList.front();
+    return !system->measures().empty() && system->measures().front() == mb;
+}
+
 void LayoutSystem::hideEmptyStaves(Score* score, System* system, bool isFirstSystem)
 {
     size_t staves = score->nstaves();
@@ -43,6 +43,8 @@ public:
 
 private:
     static System* getNextSystem(LayoutContext& lc);
+    static void dropObsoleteSystems(LayoutContext& lc);
+    static bool oldSystemStartsAt(const LayoutContext& lc, const MeasureBase* mb);
     static void hideEmptyStaves(Score* score, System* system, bool isFirstSystem);
     static void processLines(System* system, std::vector<Spanner*> lines, bool align);
     static void layoutTies(Chord* ch, System* system, const Fraction& stick);
@@ -23,6 +23,8 @@
 #include "audio.h"
 #include "rw/xml.h"
 
+#include "log.h"
+
 using namespace mu;
 
 namespace mu::engraving {
@@ -34,6 +36,24 @@ Audio::Audio()
 {
 }
 
+//---------------------------------------------------------
+//   loadData
+//---------------------------------------------------------
+
+void Audio::loadData() const
+{
+    if (!_dataLoader) {
+        return;
+    }
+
+    _data = _dataLoader();
+    _dataLoader = nullptr;
+
+    if (_data.empty()) {
+        LOGE() << "failed load audio: " << _path;
+    }
+}
+
 //---------------------------------------------------------
 //   read
 //---------------------------------------------------------
@@ -23,6 +23,8 @@
 #ifndef MU_ENGRAVING_AUDIO_H
 #define MU_ENGRAVING_AUDIO_H
 
+#include <functional>
+
 #include "global/allocator.h"
 #include "types/bytearray.h"
 #include "types/string.h"
@@ -39,19 +41,27 @@ class Audio
 {
     OBJECT_ALLOCATOR(engraving, Audio)
 
-    String _path;
-    ByteArray _data;
-
 public:
+    using DataLoader = std::function<ByteArray()>;
+
     Audio();
     const String& path() const { return _path; }
     void setPath(const String& s) { _path = s; }
-    const ByteArray& data() const { return _data; }
-    ByteArray data() { return _data; }
-    void setData(const ByteArray& ba) { _data = ba; }
+    const ByteArray& data() const { loadData(); return _data; }
+    ByteArray data() { loadData(); return _data; }
+    void setData(const ByteArray& ba) { _data = ba; _dataLoader = nullptr; }
+    //! NOTE The data is read by the loader on first use
+    void setDataLoader(const DataLoader& loader) { _data = ByteArray(); _dataLoader = loader; }
 
     void read(XmlReader&);
     void write(XmlWriter&) const;
+
+private:
+    void loadData() const;
+
+    String _path;
+    mutable ByteArray _data;
+    mutable DataLoader _dataLoader;
 };
 } // namespace mu::engraving
 #endif // MU_ENGRAVING_AUDIO_H
@@ -20,6 +20,7 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
 #include <cmath>
 
 #include "bsp.h"
@@ -38,7 +39,7 @@ class InsertItemBspTreeVisitor : public BspTreeVisitor
 public:
     EngravingItem* item;
 
-    inline void visit(std::list<EngravingItem*>* items) { items->push_front(item); }
+    inline void visit(std::vector<EngravingItem*>* items) { items->push_back(item); }
 };
 
 //---------------------------------------------------------
@@ -51,7 +52,13 @@ class RemoveItemBspTreeVisitor : public BspTreeVisitor
 public:
     EngravingItem* item;
 
-    inline void visit(std::list<EngravingItem*>* items) { items->remove(item); }
+    inline void visit(std::vector<EngravingItem*>* items)
+    {
+        auto it = std::find(items->begin(), items->end(), item);
+        if (it != items->end()) {
+            items->erase(it);
+        }
+    }
 };
 
 //---------------------------------------------------------
@@ -62,15 +69,14 @@ class FindItemBspTreeVisitor : public BspTreeVisitor
 {
     OBJECT_ALLOCATOR(engraving, FindItemBspTreeVisitor)
 public:
-    std::list<EngravingItem*> foundItems;
+    std::vector<EngravingItem*> foundItems;
 
-    void visit(std::list<EngravingItem*>* items)
+    void visit(std::vector<EngravingItem*>* items)
     {
-        for (auto it = items->begin(); it != items->end(); ++it) {
-            EngravingItem* item = *it;
+        for (EngravingItem* item : *items) {
             if (!item->itemDiscovered) {
                 item->itemDiscovered = true;
-                foundItems.push_front(item);
+                foundItems.push_back(item);
             }
         }
     }
@@ -106,8 +112,8 @@ void BspTree::initialize(const RectF& rec, int n)
     leafCnt    = 0;
 
     nodes.resize((1 << (depth + 1)) - 1);
-    leaves.resize(1LL << depth);
-    std::fill(leaves.begin(), leaves.end(), std::list<EngravingItem*>());
+    leaves.assign(1LL << depth, std::vector<EngravingItem*>());
+    itemEntries.clear();
     initialize(rec, depth, 0);
 }
 
@@ -120,6 +126,72 @@ void BspTree::clear()
     leafCnt = 0;
     nodes.clear();
     leaves.clear();
+    itemEntries.clear();
+}
+
+//---------------------------------------------------------
+//   rebuild
+//    bring the tree up to date with the given items;
+//    the tree is only initialized from scratch when the
+//    covered rectangle or the depth needed changes
+//---------------------------------------------------------
+
+void BspTree::rebuild(const RectF& rec, const std::vector<EngravingItem*>& items)
+{
+    int n = int(items.size());
+    if (nodes.empty() || rec != rect || intmaxlog(n) != int(depth)) {
+        initialize(rec, n);
+        for (EngravingItem* e : items) {
+            insert(e);
+        }
+        ++_stats.fullRebuilds;
+    } else {
+        update(items);
+        ++_stats.incrementalUpdates;
+    }
+}
+
+//---------------------------------------------------------
+//   update
+//    insert new items, move the items whose bounding rect
+//    changed and drop the items that are gone. Items that
+//    are gone may already be deleted, so they are only
+//    looked up by pointer and by their stored rect.
+//---------------------------------------------------------
+
+void BspTree::update(const std::vector<EngravingItem*>& items)
+{
+    ++generation;
+
+    for (EngravingItem* e : items) {
+        RectF r = e->pageBoundingRect();
+        auto it = itemEntries.find(e);
+        if (it == itemEntries.end()) {
+            insert(e, r);
+            itemEntries.emplace(e, ItemEntry { r, generation });
+            ++_stats.insertedItems;
+            continue;
+        }
+
+        ItemEntry& entry = it->second;
+        entry.generation = generation;
+        if (entry.rect != r) {
+            remove(e, entry.rect);
+            insert(e, r);
+            entry.rect = r;
+            ++_stats.movedItems;
+        }
+    }
+
+    for (auto it = itemEntries.begin(); it != itemEntries.end();) {
+        if (it->second.generation != generation) {
+            remove(it->first, it->second.rect);
+            it = itemEntries.erase(it);
+            ++_stats.removedItems;
+        } else {
+            ++it;
+        }
+    }
 }
 
 //---------------------------------------------------------
@@ -127,10 +199,21 @@ void BspTree::clear()
 //---------------------------------------------------------
 
 void BspTree::insert(EngravingItem* element)
+{
+    RectF r = element->pageBoundingRect();
+    auto res = itemEntries.emplace(element, ItemEntry { r, generation });
+    if (!res.second) {
+        // already in the tree
+        return;
+    }
+    insert(element, r);
+}
+
+void BspTree::insert(EngravingItem* element, const RectF& r)
 {
     InsertItemBspTreeVisitor insertVisitor;
     insertVisitor.item = element;
-    climbTree(&insertVisitor, element->pageBoundingRect());
+    climbTree(&insertVisitor, r);
 }
 
 //---------------------------------------------------------
@@ -138,10 +221,20 @@ void BspTree::insert(EngravingItem* element)
 //---------------------------------------------------------
 
 void BspTree::remove(EngravingItem* element)
+{
+    auto it = itemEntries.find(element);
+    if (it == itemEntries.end()) {
+        return;
+    }
+    remove(element, it->second.rect);
+    itemEntries.erase(it);
+}
+
+void BspTree::remove(EngravingItem* element, const RectF& r)
 {
     RemoveItemBspTreeVisitor removeVisitor;
     removeVisitor.item = element;
-    climbTree(&removeVisitor, element->pageBoundingRect());
+    climbTree(&removeVisitor, r);
 }
 
 //---------------------------------------------------------
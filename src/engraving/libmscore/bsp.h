@@ -23,7 +23,8 @@
 #ifndef __BSP_H__
 #define __BSP_H__
 
-#include <list>
+#include <unordered_map>
+#include <vector>
 
 #include "global/allocator.h"
 #include "types/string.h"
@@ -40,6 +41,10 @@ class EngravingItem;
 //---------------------------------------------------------
 //   BspTree
 //    binary space partitioning
+//    The tree remembers the rectangle each item was inserted
+//    with, so it can be brought up to date incrementally:
+//    only the items that were added, removed or moved since
+//    the last update touch the leaves.
 //---------------------------------------------------------
 
 class BspTree
@@ -55,27 +60,49 @@ public:
         };
         Type type;
     };
+
+    struct Stats {
+        size_t fullRebuilds = 0;
+        size_t incrementalUpdates = 0;
+        size_t insertedItems = 0;
+        size_t removedItems = 0;
+        size_t movedItems = 0;
+    };
+
 private:
+    struct ItemEntry {
+        mu::RectF rect;
+        unsigned generation = 0;
+    };
+
     uint depth;
     void initialize(const mu::RectF& rect, int depth, int index);
     void climbTree(BspTreeVisitor* visitor, const mu::PointF& pos, int index = 0);
     void climbTree(BspTreeVisitor* visitor, const mu::RectF& rect, int index = 0);
 
-    void findItems(std::list<EngravingItem*>* foundItems, const mu::RectF& rect, int index);
-    void findItems(std::list<EngravingItem*>* foundItems, const mu::PointF& pos, int index);
     mu::RectF rectForIndex(int index) const;
 
+    void insert(EngravingItem* item, const mu::RectF& rect);
+    void remove(EngravingItem* item, const mu::RectF& rect);
+    void update(const std::vector<EngravingItem*>& items);
+
     std::vector<Node> nodes;
-    std::vector<std::list<EngravingItem*> > leaves;
+    std::vector<std::vector<EngravingItem*> > leaves;
     int leafCnt;
     mu::RectF rect;
 
+    std::unordered_map<EngravingItem*, ItemEntry> itemEntries;
+    unsigned generation = 0;
+    Stats _stats;
+
 public:
     BspTree();
 
     void initialize(const mu::RectF& rect, int depth);
     void clear();
 
+    void rebuild(const mu::RectF& rect, const std::vector<EngravingItem*>& items);
+
     void insert(EngravingItem* item);
     void remove(EngravingItem* item);
 
@@ -83,6 +110,11 @@ public:
     std::vector<EngravingItem*> items(const mu::PointF& pos);
 
     int leafCount() const { return leafCnt; }
+    size_t itemCount() const { return itemEntries.size(); }
+
+    const Stats& stats() const { return _stats; }
+    void resetStats() { _stats = Stats(); }
+
     inline int firstChildIndex(int index) const { return index * 2 + 1; }
 
     inline int parentIndex(int index) const
@@ -104,7 +136,7 @@ class BspTreeVisitor
     OBJECT_ALLOCATOR(engraving, BspTreeVisitor)
 public:
     virtual ~BspTreeVisitor() {}
-    virtual void visit(std::list<EngravingItem*>* items) = 0;
+    virtual void visit(std::vector<EngravingItem*>* items) = 0;
 };
 } // namespace mu::engraving
 #endif
@@ -428,7 +428,12 @@ void Score::update(bool resetCmdState)
         ms->deletePostponed();
         if (cs.layoutRange()) {
             for (Score* s : ms->scoreList()) {
-                s->doLayoutRange(cs.startTick(), cs.endTick());
+                // excerpts which are not open are laid out when they are needed
+                if (s == this || s->isMaster() || s->isOpen()) {
+                    s->doLayoutRange(cs.startTick(), cs.endTick());
+                } else {
+                    s->deferLayoutRange(cs.startTick(), cs.endTick());
+                }
             }
             updateAll = true;
         }
@@ -131,6 +131,8 @@ void Image::setImageType(ImageType t)
 
 SizeF Image::imageSize() const
 {
+    loadDoc();
+
     if (!isValid()) {
         return SizeF();
     }
@@ -150,6 +152,8 @@ SizeF Image::imageSize() const
 void Image::draw(mu::draw::Painter* painter) const
 {
     TRACE_OBJ_DRAW;
+    loadDoc();
+
     bool emptyImage = false;
     if (imageType == ImageType::SVG) {
         if (!svgDoc) {
@@ -540,24 +544,34 @@ SizeF Image::size2pixel(const SizeF& s) const
 }
 
 //---------------------------------------------------------
-//   layout
+//   loadDoc
 //---------------------------------------------------------
 
-void Image::layout()
+void Image::loadDoc() const
 {
-    setPos(0.0, 0.0);
+    if (!_storeItem) {
+        return;
+    }
+
     if (imageType == ImageType::SVG && !svgDoc) {
-        if (_storeItem) {
-            svgDoc = new SvgRenderer(_storeItem->buffer());
-        }
+        svgDoc = new SvgRenderer(_storeItem->buffer());
     } else if (imageType == ImageType::RASTER && !rasterDoc) {
-        if (_storeItem) {
-            rasterDoc = imageProvider()->createPixmap(_storeItem->buffer());
-            if (!rasterDoc->isNull()) {
-                _dirty = true;
-            }
+        rasterDoc = imageProvider()->createPixmap(_storeItem->buffer());
+        if (!rasterDoc->isNull()) {
+            _dirty = true;
         }
     }
+}
+
+//---------------------------------------------------------
+//   layout
+//---------------------------------------------------------
+
+void Image::layout()
+{
+    setPos(0.0, 0.0);
+
+    //! NOTE The image data is only loaded here if its size is needed
     if (_size.isNull()) {
         _size = pixel2size(imageSize());
     }
@@ -116,9 +116,11 @@ protected:
 private:
     mu::SizeF pixel2size(const mu::SizeF& s) const;
     mu::SizeF size2pixel(const mu::SizeF& s) const;
+    void loadDoc() const;
 
-    std::shared_ptr<mu::draw::Pixmap> rasterDoc;
-    mu::draw::SvgRenderer* svgDoc = nullptr;
+    //! NOTE Created from the image data on first use (drawing or measuring)
+    mutable std::shared_ptr<mu::draw::Pixmap> rasterDoc;
+    mutable mu::draw::SvgRenderer* svgDoc = nullptr;
 
     ImageType imageType = ImageType::NONE;
 };
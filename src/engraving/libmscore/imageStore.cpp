@@ -79,12 +79,29 @@ bool ImageStoreItem::isUsed(Score* score) const
     return false;
 }
 
+//---------------------------------------------------------
+//   isReferenced
+//    check if item is referenced by an image of the score,
+//    also one removed from it that undo can restore
+//---------------------------------------------------------
+
+bool ImageStoreItem::isReferenced(Score* score) const
+{
+    for (Image* image : _references) {
+        if (image->score() == score) {
+            return true;
+        }
+    }
+    return false;
+}
+
 //---------------------------------------------------------
 //   load
 //---------------------------------------------------------
 
 void ImageStoreItem::load()
 {
+    loadLazily();
     if (!_buffer.empty()) {
         return;
     }
@@ -99,6 +116,33 @@ void ImageStoreItem::load()
     _hash = cryptographicHash()->hash(_buffer, ICryptographicHash::Algorithm::Md4);
 }
 
+//---------------------------------------------------------
+//   loadLazily
+//---------------------------------------------------------
+
+void ImageStoreItem::loadLazily() const
+{
+    if (!_loader) {
+        return;
+    }
+
+    _buffer = _loader();
+    _loader = nullptr;
+
+    if (_buffer.empty()) {
+        LOGE() << "failed load image: " << _path;
+        _lost = true;
+        return;
+    }
+
+    //! NOTE The hash was taken from the name of the file, it is only trusted if it matches the data
+    ByteArray hash = cryptographicHash()->hash(_buffer, ICryptographicHash::Algorithm::Md4);
+    if (hash != _hash) {
+        LOGW() << "the name of the image doesn't match its data: " << _path;
+        _hash = hash;
+    }
+}
+
 //---------------------------------------------------------
 //   hashName
 //---------------------------------------------------------
@@ -137,6 +181,24 @@ inline static int toInt(char c)
     return c - 'a' + 10;
 }
 
+//---------------------------------------------------------
+//   hashFromName
+//    images are stored under the hash of their data
+//---------------------------------------------------------
+
+static bool hashFromName(const path_t& path, ByteArray& hash)
+{
+    String s = FileInfo(path).completeBaseName();
+    if (s.size() != 32) {
+        return false;
+    }
+    hash = ByteArray(16);
+    for (int i = 0; i < 16; ++i) {
+        hash[i] = toInt(s.at(i * 2).toAscii()) * 16 + toInt(s.at(i * 2 + 1).toAscii());
+    }
+    return true;
+}
+
 //---------------------------------------------------------
 //   ~ImageStore
 //---------------------------------------------------------
@@ -152,8 +214,8 @@ ImageStore::~ImageStore()
 
 ImageStoreItem* ImageStore::getImage(const path_t& path) const
 {
-    String s = FileInfo(path).completeBaseName();
-    if (s.size() != 32) {
+    ByteArray hash;
+    if (!hashFromName(path, hash)) {
         //
         // some limited support for backward compatibility
         //
@@ -164,10 +226,6 @@ ImageStoreItem* ImageStore::getImage(const path_t& path) const
         }
         return nullptr;
     }
-    ByteArray hash(16);
-    for (int i = 0; i < 16; ++i) {
-        hash[i] = toInt(s.at(i * 2).toAscii()) * 16 + toInt(s.at(i * 2 + 1).toAscii());
-    }
     for (ImageStoreItem* item : _items) {
         if (item->hash() == hash) {
             return item;
@@ -195,6 +253,29 @@ ImageStoreItem* ImageStore::add(const path_t& path, const ByteArray& ba)
     return item;
 }
 
+//---------------------------------------------------------
+//   addLazily
+//    the data is read by the loader on first use,
+//    returns nullptr if the hash can't be taken from the name
+//---------------------------------------------------------
+
+ImageStoreItem* ImageStore::addLazily(const path_t& path, const ImageStoreItem::Loader& loader)
+{
+    ByteArray hash;
+    if (!hashFromName(path, hash)) {
+        return nullptr;
+    }
+    for (ImageStoreItem* item : _items) {
+        if (item->hash() == hash) {
+            return item;
+        }
+    }
+    ImageStoreItem* item = new ImageStoreItem(path);
+    item->setLoader(loader, hash);
+    _items.push_back(item);
+    return item;
+}
+
 //---------------------------------------------------------
 //   clearUnused
 //---------------------------------------------------------
@@ -23,6 +23,7 @@
 #ifndef __IMAGE_CACHE_H__
 #define __IMAGE_CACHE_H__
 
+#include <functional>
 #include <list>
 #include "types/string.h"
 #include "types/bytearray.h"
@@ -43,11 +44,20 @@ class ImageStoreItem
 {
     INJECT(engraving, ICryptographicHash, cryptographicHash)
 
+public:
+    using Loader = std::function<mu::ByteArray()>;
+
+private:
     std::list<Image*> _references;
     io::path_t _path;                  // original location of image
     String _type;                  // image type (file extension)
-    mu::ByteArray _buffer;
-    mu::ByteArray _hash;               // 16 byte md4 hash of _buffer
+    mutable mu::ByteArray _buffer;
+    mutable Loader _loader;            // reads _buffer on first use
+    mutable bool _lost = false;        // the loader couldn't read _buffer
+    bool _lossReported = false;
+    mutable mu::ByteArray _hash;       // 16 byte md4 hash of _buffer
+
+    void loadLazily() const;
 
 public:
     ImageStoreItem(const io::path_t& p);
@@ -55,16 +65,21 @@ public:
     void reference(Image*);
 
     const io::path_t& path() const { return _path; }
-    mu::ByteArray& buffer() { return _buffer; }
-    const mu::ByteArray& buffer() const { return _buffer; }
+    mu::ByteArray& buffer() { loadLazily(); return _buffer; }
+    const mu::ByteArray& buffer() const { loadLazily(); return _buffer; }
     bool loaded() const { return !_buffer.empty(); }
+    bool isLost() const { return _lost; }
+    bool lossReported() const { return _lossReported; }
+    void setLossReported() { _lossReported = true; }
     void setPath(const io::path_t& val);
     bool isUsed(Score*) const;
+    bool isReferenced(Score*) const;
     bool isUsed() const { return !_references.empty(); }
     void load();
     String hashName() const;
     const mu::ByteArray& hash() const { return _hash; }
-    void set(const mu::ByteArray& b, const mu::ByteArray& h) { _buffer = b; _hash = h; }
+    void set(const mu::ByteArray& b, const mu::ByteArray& h) { _buffer = b; _hash = h; _loader = nullptr; _lost = false; }
+    void setLoader(const Loader& loader, const mu::ByteArray& h) { _buffer.clear(); _hash = h; _loader = loader; _lost = false; }
 };
 
 //---------------------------------------------------------
@@ -86,6 +101,7 @@ public:
 
     ImageStoreItem* getImage(const io::path_t& path) const;
     ImageStoreItem* add(const io::path_t& path, const mu::ByteArray&);
+    ImageStoreItem* addLazily(const io::path_t& path, const ImageStoreItem::Loader& loader);
     void clearUnused();
 
     typedef ItemList::iterator iterator;
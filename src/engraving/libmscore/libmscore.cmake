@@ -172,6 +172,8 @@ set(LIBMSCORE_SRC
     ${CMAKE_CURRENT_LIST_DIR}/measurebase.h
     ${CMAKE_CURRENT_LIST_DIR}/measure.cpp
     ${CMAKE_CURRENT_LIST_DIR}/measure.h
+    ${CMAKE_CURRENT_LIST_DIR}/measuretickindex.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/measuretickindex.h
     ${CMAKE_CURRENT_LIST_DIR}/measurenumber.cpp
     ${CMAKE_CURRENT_LIST_DIR}/measurenumber.h
     ${CMAKE_CURRENT_LIST_DIR}/measurenumberbase.cpp
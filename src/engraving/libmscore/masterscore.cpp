@@ -32,6 +32,8 @@
 #include "rw/scorereader.h"
 
 #include "engravingproject.h"
+#include "translation.h"
+#include "infrastructure/messagebox.h"
 
 #include "repeatlist.h"
 #include "undo.h"
@@ -235,14 +237,17 @@ bool MasterScore::writeMscz(MscWriter& mscWriter, bool onlySelection, bool doCre
 
     // Write MasterScore
     {
-        ByteArray scoreData;
-        Buffer scoreBuf(&scoreData);
-        scoreBuf.open(IODevice::ReadWrite);
+        IODevice* scoreDevice = mscWriter.beginScoreFile();
+        IF_ASSERT_FAILED(scoreDevice) {
+            return false;
+        }
 
         compat::WriteScoreHook hook;
-        Score::writeScore(&scoreBuf, false, onlySelection, hook, ctx);
+        Score::writeScore(scoreDevice, false, onlySelection, hook, ctx);
 
-        mscWriter.writeScoreFile(scoreData);
+        if (!mscWriter.endFile()) {
+            return false;
+        }
     }
 
     // Write Excerpts
@@ -263,14 +268,17 @@ bool MasterScore::writeMscz(MscWriter& mscWriter, bool onlySelection, bool doCre
 
                     // Write excerpt
                     {
-                        ByteArray excerptData;
-                        Buffer excerptBuf(&excerptData);
-                        excerptBuf.open(IODevice::ReadWrite);
+                        IODevice* excerptDevice = mscWriter.beginExcerptFile(excerpt->name());
+                        IF_ASSERT_FAILED(excerptDevice) {
+                            return false;
+                        }
 
                         compat::WriteScoreHook hook;
-                        excerpt->excerptScore()->writeScore(&excerptBuf, false, onlySelection, hook, ctx);
+                        excerpt->excerptScore()->writeScore(excerptDevice, false, onlySelection, hook, ctx);
 
-                        mscWriter.addExcerptFile(excerpt->name(), excerptData);
+                        if (!mscWriter.endFile()) {
+                            return false;
+                        }
                     }
                 }
             }
@@ -291,12 +299,32 @@ bool MasterScore::writeMscz(MscWriter& mscWriter, bool onlySelection, bool doCre
 
     // Write images
     {
+        bool hasLostImages = false;
         for (ImageStoreItem* ip : imageStore) {
-            if (!ip->isUsed(this)) {
+            if (!ip->isReferenced(this)) {
                 continue;
             }
+
+            //! NOTE A removed image can be restored by undo after its file is overwritten by this one,
+            //! so it must not be loaded from the file later
             ByteArray data = ip->buffer();
-            mscWriter.addImageFile(ip->hashName(), data);
+
+            //! NOTE An image read on first use is lost if its file was changed since the score was opened
+            if (ip->isLost() && !ip->lossReported()) {
+                ip->setLossReported();
+                hasLostImages = true;
+            }
+
+            if (ip->isUsed(this)) {
+                mscWriter.addImageFile(ip->hashName(), data);
+            }
+        }
+
+        if (hasLostImages) {
+            MessageBox::warning(trc("engraving", "Some images could not be saved"),
+                                trc("engraving", "The file this score was opened from has been changed, moved or deleted, "
+                                                 "so some of its images could not be read. They are missing from the saved file."),
+                                { MessageBox::Ok });
         }
     }
 
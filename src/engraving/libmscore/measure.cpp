@@ -28,6 +28,7 @@
 #include "measure.h"
 
 #include <cmath>
+#include <cstring>
 
 #include "realfn.h"
 
@@ -1015,7 +1016,7 @@ void Measure::add(EngravingItem* e)
         break;
 
     case ElementType::MEASURE:
-        m_mmRest = toMeasure(e);
+        setMMRest(toMeasure(e));
         break;
 
     case ElementType::STAFFTYPE_CHANGE:
@@ -1134,7 +1135,7 @@ void Measure::remove(EngravingItem* e)
         break;
 
     case ElementType::MEASURE:
-        m_mmRest = 0;
+        setMMRest(nullptr);
         break;
 
     case ElementType::STAFFTYPE_CHANGE:
@@ -2962,6 +2963,18 @@ Measure* Measure::mmRestLast() const
     return score()->lastMeasure();
 }
 
+//---------------------------------------------------------
+//   setMMRest
+//---------------------------------------------------------
+
+void Measure::setMMRest(Measure* m)
+{
+    if (m_mmRest != m) {
+        m_mmRest = m;
+        setTickIndexDirty();
+    }
+}
+
 //---------------------------------------------------------
 //   mmRest1
 //    return the multi measure rest this measure is covered
@@ -4354,6 +4367,19 @@ void Measure::computeWidth(Fraction minTicks, double stretchCoeff)
         setWidth(0.0);
         return;
     }
+
+    LayoutChords::updateGraceNotes(this);
+    LayoutChords::updateLineAttachPoints(this);
+
+    double minWidth = isMMRest() ? score()->styleMM(Sid::minMMRestWidth) : score()->styleMM(Sid::minMeasureWidth);
+    double maxWidth = system()->width() - system()->leftMargin(); // maximum available system width (left margin accounts for possible indentation)
+
+    // The segments are laid out again only if something they depend on changed since a previous call
+    WidthCacheKey cacheKey = widthCacheKey(minTicks, stretchCoeff, maxWidth);
+    if (restoreWidthFromCache(cacheKey)) {
+        return;
+    }
+
     double x;
     bool first = isFirstInSystem();
 
@@ -4376,9 +4402,6 @@ void Measure::computeWidth(Fraction minTicks, double stretchCoeff)
         }
     }
 
-    LayoutChords::updateGraceNotes(this);
-    LayoutChords::updateLineAttachPoints(this);
-
     x = computeFirstSegmentXPosition(s);
     bool isSystemHeader = s->header();
 
@@ -4386,8 +4409,6 @@ void Measure::computeWidth(Fraction minTicks, double stretchCoeff)
     computeWidth(s, x, isSystemHeader, minTicks, stretchCoeff);
 
     // Check against minimum width and increase if needed
-    double minWidth = isMMRest() ? score()->styleMM(Sid::minMMRestWidth) : score()->styleMM(Sid::minMeasureWidth);
-    double maxWidth = system()->width() - system()->leftMargin(); // maximum available system width (left margin accounts for possible indentation)
 
     // System width may not yet be available for the linear mode (e.g. continuous view)
     // Will use the minimum width from the style in this case
@@ -4403,6 +4424,159 @@ void Measure::computeWidth(Fraction minTicks, double stretchCoeff)
     } else {
         setWidthLocked(false);
     }
+
+    storeWidthInCache(std::move(cacheKey));
+}
+
+//---------------------------------------------------------
+//   WidthCacheKey
+//---------------------------------------------------------
+
+void Measure::WidthCacheKey::addInt(int64_t v)
+{
+    values.push_back(static_cast<uint64_t>(v));
+    hash ^= std::hash<int64_t> {}(v) + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+}
+
+void Measure::WidthCacheKey::addDouble(double v)
+{
+    int64_t bits = 0;
+    static_assert(sizeof(bits) == sizeof(v));
+    std::memcpy(&bits, &v, sizeof(bits));
+    addInt(bits);
+}
+
+void Measure::WidthCacheKey::addPointer(const void* p)
+{
+    addInt(static_cast<int64_t>(reinterpret_cast<uintptr_t>(p)));
+}
+
+void Measure::WidthCacheKey::addShape(const Shape& shape)
+{
+    addInt(shape.size());
+    for (const ShapeElement& r : shape) {
+        addDouble(r.x());
+        addDouble(r.y());
+        addDouble(r.width());
+        addDouble(r.height());
+        addPointer(r.toItem);
+    }
+}
+
+//---------------------------------------------------------
+//   widthCacheKey
+//    the state computeWidth() depends on: the segments and
+//    their shapes, the previous measure end, the staff
+//    visibility, the style and the parameters
+//---------------------------------------------------------
+
+Measure::WidthCacheKey Measure::widthCacheKey(Fraction minTicks, double stretchCoeff, double maxWidth) const
+{
+    WidthCacheKey key;
+    key.addInt(score()->style().spacingGeneration());
+    key.addInt(minTicks.numerator());
+    key.addInt(minTicks.denominator());
+    key.addDouble(stretchCoeff);
+    key.addDouble(maxWidth);
+    key.addDouble(m_userStretch);
+    key.addDouble(mag());
+    key.addInt(isFirstInSystem());
+
+    for (staff_idx_t staffIdx = 0; staffIdx < score()->nstaves(); ++staffIdx) {
+        key.addInt(score()->staff(staffIdx)->show());
+    }
+
+    const Measure* prevMeasure = (prev() && prev()->isMeasure()) ? toMeasure(prev()) : nullptr;
+    if (prevMeasure) {
+        key.addInt(prevMeasure->repeatEnd());
+        key.addInt(prevMeasure->system() == system());
+        if (const Segment* prevEnd = prevMeasure->last()) {
+            key.addPointer(prevEnd);
+            key.addInt(int(prevEnd->segmentType()));
+            for (const Shape& shape : prevEnd->shapes()) {
+                key.addShape(shape);
+            }
+        }
+    }
+
+    for (const Segment* s = first(); s; s = s->next()) {
+        key.addPointer(s);
+        key.addInt(int(s->segmentType()));
+        key.addInt(s->enabled());
+        key.addInt(s->visible());
+        key.addInt(s->header());
+        key.addInt(s->allElementsInvisible());
+        key.addInt(s->ticks().ticks());
+        key.addDouble(s->extraLeadingSpace().val());
+        if (s->isChordRestType()) {
+            key.addInt(s->shortestChordRest().ticks());
+            CrossStaffContent cs = s->crossStaffContent();
+            key.addInt(cs.movedUp);
+            key.addInt(cs.movedDown);
+        }
+        for (const Shape& shape : s->shapes()) {
+            key.addShape(shape);
+        }
+    }
+
+    return key;
+}
+
+//---------------------------------------------------------
+//   restoreWidthFromCache
+//---------------------------------------------------------
+
+bool Measure::restoreWidthFromCache(const WidthCacheKey& key)
+{
+    auto it = std::find_if(m_widthCache.begin(), m_widthCache.end(), [&key](const WidthCacheEntry& e) { return e.key == key; });
+    if (it == m_widthCache.end()) {
+        return false;
+    }
+
+    const WidthCacheEntry& entry = *it;
+    size_t i = 0;
+    for (Segment* s = first(); s; s = s->next(), ++i) {
+        IF_ASSERT_FAILED(i < entry.segments.size()) {
+            return false;
+        }
+        s->setPosX(entry.segments[i].first);
+        s->setWidth(entry.segments[i].second);
+    }
+
+    _squeezableSpace = entry.squeezableSpace;
+    setLayoutStretch(entry.layoutStretch);
+    setWidthLocked(entry.widthLocked);
+    setWidth(entry.width);
+    return true;
+}
+
+//---------------------------------------------------------
+//   storeWidthInCache
+//---------------------------------------------------------
+
+void Measure::storeWidthInCache(WidthCacheKey&& key)
+{
+    // computeWidth() is called with a few different parameters while collecting a system
+    static constexpr size_t MAX_ENTRIES = 4;
+
+    auto it = std::find_if(m_widthCache.begin(), m_widthCache.end(), [&key](const WidthCacheEntry& e) { return e.key == key; });
+    if (it != m_widthCache.end()) {
+        m_widthCache.erase(it);
+    } else if (m_widthCache.size() >= MAX_ENTRIES) {
+        m_widthCache.erase(m_widthCache.begin());
+    }
+
+    WidthCacheEntry entry;
+    entry.key = std::move(key);
+    for (const Segment* s = first(); s; s = s->next()) {
+        entry.segments.emplace_back(s->x(), s->width());
+    }
+    entry.width = width();
+    entry.squeezableSpace = _squeezableSpace;
+    entry.layoutStretch = layoutStretch();
+    entry.widthLocked = isWidthLocked();
+
+    m_widthCache.push_back(std::move(entry));
 }
 
 void Measure::setWidthToTargetValue(Segment* s, double x, bool isSystemHeader, Fraction minTicks, double stretchCoeff, double targetWidth)
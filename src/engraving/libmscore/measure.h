@@ -49,6 +49,7 @@ class MuseScoreView;
 class System;
 class Note;
 class Spacer;
+class Shape;
 class TieMap;
 class AccidentalState;
 class Spanner;
@@ -308,7 +309,7 @@ public:
     bool isMMRest() const { return m_mmRestCount > 0; }
     Measure* mmRest() const { return m_mmRest; }
     const Measure* mmRest1() const;
-    void setMMRest(Measure* m) { m_mmRest = m; }
+    void setMMRest(Measure* m);
     int mmRestCount() const { return m_mmRestCount; }            // number of measures m_mmRest spans
     void setMMRestCount(int n) { m_mmRestCount = n; }
     Measure* mmRestFirst() const;
@@ -348,6 +349,7 @@ public:
     double basicWidth() const;
     float durationStretch(Fraction curTicks, const Fraction minTicks) const;
     void computeWidth(Fraction minTicks, double stretchCoeff);
+    void invalidateWidthCache() { m_widthCache.clear(); }
     void checkHeader();
     void checkTrailer();
     void layoutStaffLines();
@@ -386,6 +388,34 @@ private:
     void computeWidth(Segment* s, double x, bool isSystemHeader, Fraction minTicks, double stretchCoeff);
     void setWidthToTargetValue(Segment* s, double x, bool isSystemHeader, Fraction minTicks, double stretchCoeff, double targetWidth);
 
+    // Everything the result of computeWidth() depends on. The values are compared exactly,
+    // the hash only makes the comparison of different keys cheap
+    struct WidthCacheKey {
+        size_t hash = 0;
+        std::vector<uint64_t> values;
+
+        void addInt(int64_t v);
+        void addDouble(double v);
+        void addPointer(const void* p);
+        void addShape(const Shape& shape);
+
+        bool operator==(const WidthCacheKey& k) const { return hash == k.hash && values == k.values; }
+    };
+
+    // Cache of computeWidth() results
+    struct WidthCacheEntry {
+        WidthCacheKey key;
+        std::vector<std::pair<double, double> > segments;   // x position and width of every segment
+        double width = 0.0;
+        double squeezableSpace = 0.0;
+        double layoutStretch = 1.0;
+        bool widthLocked = false;
+    };
+
+    WidthCacheKey widthCacheKey(Fraction minTicks, double stretchCoeff, double maxWidth) const;
+    bool restoreWidthFromCache(const WidthCacheKey& key);
+    void storeWidthInCache(WidthCacheKey&& key);
+
     MStaff* mstaff(staff_idx_t staffIndex) const;
 
     std::vector<MStaff*> m_mstaves;
@@ -412,6 +442,8 @@ private:
 
     double m_layoutStretch = 1.0;
     bool _isWidthLocked = false;
+
+    std::vector<WidthCacheEntry> m_widthCache;   // most recently stored last
 };
 } // namespace mu::engraving
 #endif
@@ -350,7 +350,47 @@ Fraction MeasureBase::tick() const
 
 void MeasureBase::setTick(const Fraction& f)
 {
-    _tick = f;
+    if (_tick != f) {
+        _tick = f;
+        setTickIndexDirty();
+    }
+}
+
+//---------------------------------------------------------
+//   setNext
+//---------------------------------------------------------
+
+void MeasureBase::setNext(MeasureBase* e)
+{
+    if (_next != e) {
+        _next = e;
+        setTickIndexDirty();
+    }
+}
+
+//---------------------------------------------------------
+//   setPrev
+//---------------------------------------------------------
+
+void MeasureBase::setPrev(MeasureBase* e)
+{
+    if (_prev != e) {
+        _prev = e;
+        setTickIndexDirty();
+    }
+}
+
+//---------------------------------------------------------
+//   setTickIndexDirty
+//    the score's tick -> measure lookup tables depend on
+//    the measure chain and on the measure ticks
+//---------------------------------------------------------
+
+void MeasureBase::setTickIndexDirty() const
+{
+    if (score()) {
+        score()->measures()->setTickIndexDirty();
+    }
 }
 
 //---------------------------------------------------------
@@ -91,6 +91,7 @@ protected:
 
     Fraction _len  { Fraction(0, 1) };    ///< actual length of measure
     void cleanupLayoutBreaks(bool undo);
+    void setTickIndexDirty() const;
 
 public:
 
@@ -108,10 +109,10 @@ public:
 
     MeasureBase* next() const { return _next; }
     MeasureBase* nextMM() const;
-    void setNext(MeasureBase* e) { _next = e; }
+    void setNext(MeasureBase* e);
     MeasureBase* prev() const { return _prev; }
     MeasureBase* prevMM() const;
-    void setPrev(MeasureBase* e) { _prev = e; }
+    void setPrev(MeasureBase* e);
     MeasureBase* top() const;
 
     Measure* nextMeasure() const;
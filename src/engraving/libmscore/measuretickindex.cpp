@@ -0,0 +1,104 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "measuretickindex.h"
+
+#include <algorithm>
+
+#include "measure.h"
+
+using namespace mu;
+
+namespace mu::engraving {
+//---------------------------------------------------------
+//   update
+//    rebuild the lookup table from the measure chain
+//    starting at first
+//---------------------------------------------------------
+
+void MeasureTickIndex::update(Measure* first, bool useMMRests) const
+{
+    ticks.clear();
+    measures.clear();
+    sorted = true;
+
+    for (Measure* m = first; m; m = useMMRests ? m->nextMeasureMM() : m->nextMeasure()) {
+        Fraction tick = m->tick();
+        if (!ticks.empty() && tick < ticks.back()) {
+            sorted = false;         // chain is being rebuilt, fall back to a linear search
+        }
+        ticks.push_back(tick);
+        measures.push_back(m);
+    }
+
+    mmRests = useMMRests;
+    dirty = false;
+}
+
+//---------------------------------------------------------
+//   find
+//    return the last measure starting at or before tick;
+//    the last measure is only returned if tick lies
+//    within it
+//---------------------------------------------------------
+
+Measure* MeasureTickIndex::find(const Fraction& tick, Measure* first, bool useMMRests) const
+{
+    prepare(first, useMMRests);
+    if (measures.empty()) {
+        return nullptr;
+    }
+
+    size_t idx = 0;
+    if (sorted) {
+        idx = std::upper_bound(ticks.begin(), ticks.end(), tick) - ticks.begin();
+    } else {
+        while (idx < ticks.size() && !(tick < ticks[idx])) {
+            ++idx;
+        }
+    }
+
+    if (idx < measures.size()) {
+        return idx > 0 ? measures[idx - 1] : nullptr;
+    }
+
+    // check last measure
+    Measure* lm = measures.back();
+    if (tick >= lm->tick() && tick <= lm->endTick()) {
+        return lm;
+    }
+    return nullptr;
+}
+
+//---------------------------------------------------------
+//   prepare
+//    rebuild the lookup table now if it is out of date,
+//    so that the following lookups only read it
+//---------------------------------------------------------
+
+void MeasureTickIndex::prepare(Measure* first, bool useMMRests) const
+{
+    if (dirty || mmRests != useMMRests) {
+        update(first, useMMRests);
+    }
+}
+} // namespace mu::engraving
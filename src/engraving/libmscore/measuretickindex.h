@@ -0,0 +1,62 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef __MEASURETICKINDEX_H__
+#define __MEASURETICKINDEX_H__
+
+#include <vector>
+
+#include "types/fraction.h"
+
+namespace mu::engraving {
+class Measure;
+
+//---------------------------------------------------------
+//   MeasureTickIndex
+//    sorted tick -> measure lookup table used by
+//    Score::tick2measure() and Score::tick2measureMM().
+//    The table is rebuilt lazily on the first lookup
+//    after the measure chain was changed.
+//---------------------------------------------------------
+
+class MeasureTickIndex
+{
+    mutable bool dirty = true;
+    mutable bool sorted = false;
+    mutable bool mmRests = false;
+    mutable std::vector<Fraction> ticks;
+    mutable std::vector<Measure*> measures;
+
+    void update(Measure* first, bool useMMRests) const;
+
+public:
+    MeasureTickIndex() = default;
+
+    Measure* find(const Fraction& tick, Measure* first, bool useMMRests) const;
+    void prepare(Measure* first, bool useMMRests) const;
+    void setDirty() const { dirty = true; }     // must be called if a measure changes tick or the chain is relinked
+    bool isDirty() const { return dirty; }
+    size_t size() const { return measures.size(); }
+};
+} // namespace mu::engraving
+
+#endif
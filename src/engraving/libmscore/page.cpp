@@ -330,28 +330,14 @@ void Page::scanElements(void* data, void (* func)(void*, EngravingItem*), bool a
     func(data, this);
 }
 
-//---------------------------------------------------------
-//   bspInsert
-//---------------------------------------------------------
-
-static void bspInsert(void* bspTree, EngravingItem* e)
-{
-    ((BspTree*)bspTree)->insert(e);
-}
-
-static void countElements(void* data, EngravingItem* /*e*/)
-{
-    ++(*(int*)data);
-}
-
 //---------------------------------------------------------
 //   doRebuildBspTree
 //---------------------------------------------------------
 
 void Page::doRebuildBspTree()
 {
-    int n = 0;
-    scanElements(&n, countElements, false);
+    std::vector<EngravingItem*> elements;
+    scanElements(&elements, collectElements, false);
 
     RectF r;
     if (score()->linearMode()) {
@@ -369,8 +355,7 @@ void Page::doRebuildBspTree()
         r = abbox();
     }
 
-    bspTree.initialize(r, n);
-    scanElements(&bspTree, &bspInsert, false);
+    bspTree.rebuild(r, elements);
     bspTreeValid = true;
 }
 
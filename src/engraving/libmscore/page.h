@@ -94,6 +94,7 @@ public:
     std::vector<EngravingItem*> items(const mu::RectF& r);
     std::vector<EngravingItem*> items(const mu::PointF& p);
     void invalidateBspTree() { bspTreeValid = false; }
+    const BspTree::Stats& bspTreeStats() const { return bspTree.stats(); }
     mu::PointF pagePos() const override { return mu::PointF(); }       ///< position in page coordinates
     std::vector<EngravingItem*> elements() const;              ///< list of visible elements
     mu::RectF tbbox();                             // tight bounding box, excluding white space
@@ -131,6 +131,7 @@ MeasureBaseList::MeasureBaseList()
 
 void MeasureBaseList::push_back(MeasureBase* e)
 {
+    setTickIndexDirty();
     ++_size;
     if (_last) {
         _last->setNext(e);
@@ -151,6 +152,7 @@ void MeasureBaseList::push_back(MeasureBase* e)
 
 void MeasureBaseList::push_front(MeasureBase* e)
 {
+    setTickIndexDirty();
     ++_size;
     if (_first) {
         _first->setPrev(e);
@@ -182,6 +184,7 @@ void MeasureBaseList::add(MeasureBase* e)
         return;
     }
     ++_size;
+    setTickIndexDirty();
     e->setPrev(el->prev());
     el->prev()->setNext(e);
     el->setPrev(e);
@@ -194,6 +197,7 @@ void MeasureBaseList::add(MeasureBase* e)
 
 void MeasureBaseList::remove(MeasureBase* el)
 {
+    setTickIndexDirty();
     --_size;
     if (el->prev()) {
         el->prev()->setNext(el->next());
@@ -213,6 +217,7 @@ void MeasureBaseList::remove(MeasureBase* el)
 
 void MeasureBaseList::insert(MeasureBase* fm, MeasureBase* lm)
 {
+    setTickIndexDirty();
     ++_size;
     for (MeasureBase* m = fm; m != lm; m = m->next()) {
         ++_size;
@@ -238,6 +243,7 @@ void MeasureBaseList::insert(MeasureBase* fm, MeasureBase* lm)
 
 void MeasureBaseList::remove(MeasureBase* fm, MeasureBase* lm)
 {
+    setTickIndexDirty();
     --_size;
     for (MeasureBase* m = fm; m != lm; m = m->next()) {
         --_size;
@@ -262,6 +268,7 @@ void MeasureBaseList::remove(MeasureBase* fm, MeasureBase* lm)
 
 void MeasureBaseList::change(MeasureBase* ob, MeasureBase* nb)
 {
+    setTickIndexDirty();
     nb->setPrev(ob->prev());
     nb->setNext(ob->next());
     if (ob->prev()) {
@@ -903,6 +910,9 @@ bool Score::isOpen() const
 void Score::setIsOpen(bool open)
 {
     _isOpen = open;
+    if (_isOpen) {
+        doDeferredLayout();
+    }
 }
 
 //---------------------------------------------------------
@@ -5477,15 +5487,100 @@ void Score::doLayout()
     doLayoutRange(Fraction(0, 1), Fraction(-1, 1));
 }
 
+//---------------------------------------------------------
+//   mergeLayoutRange
+//    extend [st, et] to also cover [st2, et2]
+//    a negative end tick means "to the end of the score"
+//---------------------------------------------------------
+
+static void mergeLayoutRange(Fraction& st, Fraction& et, const Fraction& st2, const Fraction& et2)
+{
+    st = std::max(Fraction(0, 1), std::min(st, st2));
+    if (et < Fraction(0, 1) || et2 < Fraction(0, 1)) {
+        et = Fraction(-1, 1);
+    } else {
+        et = std::max(et, et2);
+    }
+}
+
+//---------------------------------------------------------
+//   deferLayoutRange
+//    postpone layout of an excerpt which is not shown
+//    until doDeferredLayout() is called; successive ranges
+//    are merged
+//---------------------------------------------------------
+
+void Score::deferLayoutRange(const Fraction& st, const Fraction& et)
+{
+    if (_hasDeferredLayout) {
+        mergeLayoutRange(_deferredLayoutStart, _deferredLayoutEnd, st, et);
+        return;
+    }
+    _deferredLayoutStart = std::max(Fraction(0, 1), st);
+    _deferredLayoutEnd = et;
+    _hasDeferredLayout = true;
+}
+
+//---------------------------------------------------------
+//   doDeferredLayout
+//    lay out the range postponed by deferLayoutRange(), if any;
+//    must be called before the layout of an excerpt is used
+//---------------------------------------------------------
+
+void Score::doDeferredLayout()
+{
+    if (!_hasDeferredLayout) {
+        return;
+    }
+
+    //! NOTE The layout may change the model (e.g. add or remove mmrests). The changes are recorded
+    //! in the last command, which needed the layout, so undoing it undoes them too,
+    //! even if the layout is done later, e.g. on paint or while another command is active
+    UndoStack* stack = undoStack();
+    stack->beginAppendToLast();
+    doLayoutRange(_deferredLayoutStart, _deferredLayoutEnd);
+    stack->endAppendToLast();
+}
+
+//---------------------------------------------------------
+//   doDeferredLayoutIfIdle
+//    do the postponed layout on use of the pages or systems,
+//    unless the model is being changed, loaded or laid out
+//---------------------------------------------------------
+
+void Score::doDeferredLayoutIfIdle()
+{
+    const UndoStack* stack = undoStack();
+    if (ScoreLoad::loading() || stack->active() || stack->undoRedoRunning()) {
+        return;
+    }
+
+    doDeferredLayout();
+}
+
 void Score::doLayoutRange(const Fraction& st, const Fraction& et)
 {
     TRACEFUNC;
 
+    Fraction stick(st);
+    Fraction etick(et);
+    if (_hasDeferredLayout) {
+        mergeLayoutRange(stick, etick, _deferredLayoutStart, _deferredLayoutEnd);
+        _hasDeferredLayout = false;
+    }
+
     m_symbolFont = SymbolFonts::fontByName(style().value(Sid::MusicalSymbolFont).value<String>());
     _noteHeadWidth = m_symbolFont->width(SymId::noteheadBlack, spatium() / SPATIUM20);
 
+    // the cached measure widths of the edited range are stale
+    if (stick >= Fraction(0, 1) && etick >= stick) {
+        for (Measure* m = tick2measure(stick); m && m->tick() <= etick; m = m->nextMeasure()) {
+            m->invalidateWidthCache();
+        }
+    }
+
     m_layoutOptions.updateFromStyle(style());
-    m_layout.doLayoutRange(m_layoutOptions, st, et);
+    m_layout.doLayoutRange(m_layoutOptions, stick, etick);
     if (_resetAutoplace) {
         _resetAutoplace = false;
         resetAutoplace();
@@ -36,6 +36,7 @@
 #include "chordlist.h"
 #include "input.h"
 #include "layoutbreak.h"
+#include "measuretickindex.h"
 #include "mscore.h"
 #include "property.h"
 #include "scoreorder.h"
@@ -166,6 +167,8 @@ class MeasureBaseList
     int _size;
     MeasureBase* _first = nullptr;
     MeasureBase* _last = nullptr;
+    MeasureTickIndex _tickIndex;
+    MeasureTickIndex _tickIndexMM;
 
     void push_back(MeasureBase* e);
     void push_front(MeasureBase* e);
@@ -174,7 +177,7 @@ public:
     MeasureBaseList();
     MeasureBase* first() const { return _first; }
     MeasureBase* last()  const { return _last; }
-    void clear() { _first = _last = 0; _size = 0; }
+    void clear() { _first = _last = 0; _size = 0; setTickIndexDirty(); }
     void add(MeasureBase*);
     void remove(MeasureBase*);
     void insert(MeasureBase*, MeasureBase*);
@@ -183,6 +186,10 @@ public:
     int size() const { return _size; }
     bool empty() const { return _size == 0; }
     void fixupSystems();
+
+    const MeasureTickIndex& tickIndex() const { return _tickIndex; }
+    const MeasureTickIndex& tickIndexMM() const { return _tickIndexMM; }
+    void setTickIndexDirty() const { _tickIndex.setDirty(); _tickIndexMM.setDirty(); }
 };
 
 //---------------------------------------------------------
@@ -451,6 +458,10 @@ private:
 
     bool _isOpen { false };
 
+    bool _hasDeferredLayout { false };          ///< layout of this excerpt was postponed until it is needed
+    Fraction _deferredLayoutStart;
+    Fraction _deferredLayoutEnd;
+
     std::map<String, String> _metaTags;
 
     Selection _selection;
@@ -512,6 +523,7 @@ private:
     ChordRest* deleteRange(Segment* segStart, Segment* segEnd, track_idx_t trackStart, track_idx_t trackEnd, const SelectionFilter& filter);
 
     void update(bool resetCmdState);
+    void doDeferredLayoutIfIdle();
 
     ID newStaffId() const;
     ID newPartId() const;
@@ -852,6 +864,7 @@ public:
     Fraction pos();
     Measure* tick2measure(const Fraction& tick) const;
     Measure* tick2measureMM(const Fraction& tick) const;
+    void prepareTick2Measure() const;
     MeasureBase* tick2measureBase(const Fraction& tick) const;
     Segment* tick2segment(const Fraction& tick, bool first, SegmentType st, bool useMMrest = false) const;
     Segment* tick2segment(const Fraction& tick) const;
@@ -1018,13 +1031,14 @@ public:
     void nextInputPos(ChordRest* cr, bool);
     void cmdMirrorNoteHead();
 
-    virtual size_t npages() const { return _pages.size(); }
-    virtual page_idx_t pageIdx(Page* page) const { return mu::indexOf(_pages, page); }
-    virtual const std::vector<Page*>& pages() const { return _pages; }
-    virtual std::vector<Page*>& pages() { return _pages; }
+    // the layout of an excerpt, which was postponed, is done when its pages or systems are used
+    virtual size_t npages() const { doDeferredLayoutOnUse(); return _pages.size(); }
+    virtual page_idx_t pageIdx(Page* page) const { doDeferredLayoutOnUse(); return mu::indexOf(_pages, page); }
+    virtual const std::vector<Page*>& pages() const { doDeferredLayoutOnUse(); return _pages; }
+    virtual std::vector<Page*>& pages() { doDeferredLayoutOnUse(); return _pages; }
 
-    const std::vector<System*>& systems() const { return _systems; }
-    std::vector<System*>& systems() { return _systems; }
+    const std::vector<System*>& systems() const { doDeferredLayoutOnUse(); return _systems; }
+    std::vector<System*>& systems() { doDeferredLayoutOnUse(); return _systems; }
 
     MeasureBaseList* measures() { return &_measures; }
     bool checkHasMeasures() const;
@@ -1068,6 +1082,15 @@ public:
 
     void doLayout();
     void doLayoutRange(const Fraction& st, const Fraction& et);
+    void deferLayoutRange(const Fraction& st, const Fraction& et);
+    bool hasDeferredLayout() const { return _hasDeferredLayout; }
+    void doDeferredLayout();
+    void doDeferredLayoutOnUse() const
+    {
+        if (_hasDeferredLayout) {
+            const_cast<Score*>(this)->doDeferredLayoutIfIdle();
+        }
+    }
 
     SynthesizerState& synthesizerState() { return _synthesizerState; }
     void setSynthesizerState(const SynthesizerState& s);
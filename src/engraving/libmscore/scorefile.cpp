@@ -377,6 +377,9 @@ bool Score::writeScore(io::IODevice* f, bool msczFormat, bool onlySelection, com
 
 bool Score::writeScore(io::IODevice* f, bool msczFormat, bool onlySelection, compat::WriteScoreHook& hook, WriteContext& ctx)
 {
+    // layout may create or remove elements (e.g. mmrests)
+    doDeferredLayout();
+
     XmlWriter xml(f);
     xml.context()->setIsMsczMode(msczFormat);
     xml.setContext(&ctx);
@@ -2530,9 +2530,9 @@ double Segment::elementsTopOffsetFromSkyline(staff_idx_t staffIndex) const
         return 0;
     }
 
-    SkylineLine north = staffSystem->skyline().north();
+    const SkylineLine& north = staffSystem->skyline().north();
     int topOffset = INT_MAX;
-    for (SkylineSegment segment: north) {
+    for (const SkylineSegment& segment: north) {
         Segment* seg = prev1enabled();
         if (!seg) {
             continue;
@@ -2563,9 +2563,9 @@ double Segment::elementsBottomOffsetFromSkyline(staff_idx_t staffIndex) const
         return 0;
     }
 
-    SkylineLine south = staffSystem->skyline().south();
+    const SkylineLine& south = staffSystem->skyline().south();
     int bottomOffset = INT_MIN;
-    for (SkylineSegment segment: south) {
+    for (const SkylineSegment& segment: south) {
         Segment* seg = prev1enabled();
         if (!seg) {
             continue;
@@ -107,26 +107,47 @@ double Shape::minHorizontalDistance(const Shape& a, Score* score) const
         const EngravingItem* item2 = r2.toItem;
         double by1 = r2.top();
         double by2 = r2.bottom();
+        double bx1 = r2.left();
+        bool zeroWidth2 = r2.width() == 0;
+        bool isLyrics2 = item2 && item2->isLyrics();
+
+        // Kerning type and padding only depend on the pair of items. Consecutive
+        // rectangles of this shape usually belong to the same item, so compute
+        // them once per item, and the padding only if it is actually used.
+        const EngravingItem* pairItem1 = nullptr;
+        KerningType pairKerningType = KerningType::NON_KERNING;
+        double pairPadding = 0;
+        bool pairPaddingValid = false;
+
         for (const ShapeElement& r1 : *this) {
             const EngravingItem* item1 = r1.toItem;
-            double ay1 = r1.top();
-            double ay2 = r1.bottom();
-            bool intersection = mu::engraving::intersects(ay1, ay2, by1, by2, verticalClearance);
-            double padding = 0;
+            bool intersection = mu::engraving::intersects(r1.top(), r1.bottom(), by1, by2, verticalClearance);
             KerningType kerningType = KerningType::NON_KERNING;
             if (item1 && item2) {
-                padding = item1->computePadding(item2);
-                kerningType = item1->computeKerningType(item2);
+                if (item1 != pairItem1) {
+                    pairItem1 = item1;
+                    pairKerningType = item1->computeKerningType(item2);
+                    pairPaddingValid = false;
+                }
+                kerningType = pairKerningType;
             }
             if (intersection
-                || (r1.width() == 0 || r2.width() == 0) // Temporary hack: shapes of zero-width are assumed to collide with everyghin
-                || (!item1 && item2 && item2->isLyrics()) // Temporary hack: avoids collision with melisma line
+                || (r1.width() == 0 || zeroWidth2) // Temporary hack: shapes of zero-width are assumed to collide with everyghin
+                || (!item1 && isLyrics2) // Temporary hack: avoids collision with melisma line
                 || kerningType == KerningType::NON_KERNING) {
-                dist = std::max(dist, r1.right() - r2.left() + padding);
+                double padding = 0;
+                if (item1 && item2) {
+                    if (!pairPaddingValid) {
+                        pairPadding = item1->computePadding(item2);
+                        pairPaddingValid = true;
+                    }
+                    padding = pairPadding;
+                }
+                dist = std::max(dist, r1.right() - bx1 + padding);
             }
             if (kerningType == KerningType::KERNING_UNTIL_ORIGIN) { //prepared for future user option, for now always false
                 double origin = r1.left();
-                dist = std::max(dist, origin - r2.left());
+                dist = std::max(dist, origin - bx1);
             }
         }
     }
@@ -21,6 +21,10 @@
  */
 
 #include "skyline.h"
+
+#include <algorithm>
+#include <limits>
+
 #include "segment.h"
 
 #include "draw/painter.h"
@@ -52,48 +56,6 @@ void Skyline::add(const RectF& r)
     _south.add(r.x(), r.bottom(), r.width());
 }
 
-//---------------------------------------------------------
-//   insert
-//---------------------------------------------------------
-
-SkylineLine::SegIter SkylineLine::insert(SegIter i, double x, double y, double w)
-{
-    const double xr = x + w;
-    // Only x coordinate change is handled here as width change gets handled
-    // in SkylineLine::add().
-    if (i != seg.end() && xr > i->x) {
-        i->x = xr;
-    }
-    return seg.emplace(i, x, y, w);
-}
-
-//---------------------------------------------------------
-//   append
-//---------------------------------------------------------
-
-void SkylineLine::append(double x, double y, double w)
-{
-    seg.emplace_back(x, y, w);
-}
-
-//---------------------------------------------------------
-//   getApproxPosition
-//---------------------------------------------------------
-
-SkylineLine::SegIter SkylineLine::find(double x)
-{
-    auto it = std::upper_bound(seg.begin(), seg.end(), x, [](double x, const SkylineSegment& s) { return x < s.x; });
-    if (it == seg.begin()) {
-        return it;
-    }
-    return --it;
-}
-
-SkylineLine::SegConstIter SkylineLine::find(double x) const
-{
-    return const_cast<SkylineLine*>(this)->find(x);
-}
-
 //---------------------------------------------------------
 //   add
 //---------------------------------------------------------
@@ -131,77 +93,198 @@ void SkylineLine::add(double x, double y, double w)
             return;
         }
     }
+    if (w < 0.0) {
+        return;
+    }
 
     DP("===add  %f %f %f\n", x, y, w);
 
-    SegIter i = find(x);
-    double cx = seg.empty() ? 0.0 : i->x;
-    for (; i != seg.end(); ++i) {
-        double cy = i->y;
-        if ((x + w) <= cx) {                                            // A
-            return;       // break;
+    pending.emplace_back(x, y, w);
+}
+
+//---------------------------------------------------------
+//   merge
+//    merge all pending rectangles into the segment list:
+//    a sweep over the edges of the pending rectangles gives
+//    their own profile, which is merged with the segments
+//    in one pass, since both are sorted and don't overlap.
+//    Zero-width rectangles have no width to sweep, they are
+//    inserted afterwards as zero-width segments
+//---------------------------------------------------------
+
+void SkylineLine::merge() const
+{
+    struct Rect {
+        double x1;
+        double x2;
+        double y;
+    };
+
+    const bool isNorth = north;
+    const double invalidY = north ? MAXIMUM_Y : MINIMUM_Y;
+    // the highest (north) or lowest (south) of two heights
+    auto top = [isNorth](double y1, double y2) { return isNorth ? std::min(y1, y2) : std::max(y1, y2); };
+
+    // zero-width rectangles, pending and already merged
+    std::vector<Rect> spikes;
+
+    // profile of the pending rectangles
+    std::vector<Rect> added;
+    {
+        std::vector<Rect> rects;
+        std::vector<double> edges;
+        rects.reserve(pending.size());
+        edges.reserve(2 * pending.size());
+        for (const SkylineSegment& s : pending) {
+            if (s.w == 0.0) {
+                spikes.push_back({ s.x, s.x, s.y });
+                continue;
+            }
+            rects.push_back({ s.x, s.x + s.w, s.y });
+            edges.push_back(s.x);
+            edges.push_back(s.x + s.w);
         }
-        if (x > (cx + i->w)) {                                          // B
-            cx += i->w;
-            continue;
+        pending.clear();
+
+        std::sort(rects.begin(), rects.end(), [](const Rect& a, const Rect& b) { return a.x1 < b.x1; });
+        std::sort(edges.begin(), edges.end());
+        edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+        // heap of the rectangles covering the current edge, the top one is the highest (north) or lowest (south)
+        auto lower = [isNorth](const Rect& a, const Rect& b) { return isNorth ? a.y > b.y : a.y < b.y; };
+        std::vector<Rect> heap;
+
+        size_t ri = 0;
+        for (size_t ei = 0; ei + 1 < edges.size(); ++ei) {
+            const double x = edges[ei];
+            while (ri < rects.size() && rects[ri].x1 <= x) {
+                heap.push_back(rects[ri++]);
+                std::push_heap(heap.begin(), heap.end(), lower);
+            }
+            while (!heap.empty() && heap.front().x2 <= x) {
+                std::pop_heap(heap.begin(), heap.end(), lower);
+                heap.pop_back();
+            }
+            if (heap.empty()) {
+                continue;
+            }
+            const double y = heap.front().y;
+            const double xr = edges[ei + 1];
+            if (!added.empty() && added.back().x2 == x && added.back().y == y) {
+                added.back().x2 = xr;
+            } else {
+                added.push_back({ x, xr, y });
+            }
         }
-        if ((north && (cy <= y)) || (!north && (cy >= y))) {
-            cx += i->w;
+    }
+
+    std::vector<Rect> current;
+    current.reserve(seg.size());
+    for (size_t i = 0; i < seg.size(); ++i) {
+        if (!valid(seg[i])) {
             continue;
         }
-        if ((x >= cx) && ((x + w) < (cx + i->w))) {                     // (E) insert segment
-            DP("    insert at %f %f   x:%f w:%f\n", cx, i->w, x, w);
-            double w1 = x - cx;
-            double w2 = w;
-            double w3 = i->w - (w1 + w2);
-            if (w1 > 0.0000001) {
-                i->w = w1;
-                ++i;
-                i = insert(i, x, y, w2);
-                DP("       A w1 %f w2 %f\n", w1, w2);
-            } else {
-                i->w = w2;
-                i->y = y;
-                DP("       B w2 %f\n", w2);
-            }
-            if (w3 > 0.0000001) {
-                ++i;
-                DP("       C w3 %f\n", w3);
-                insert(i, x + w2, cy, w3);
+        const double end = segmentEnd(i);
+        if (end == seg[i].x) {
+            spikes.push_back({ seg[i].x, end, seg[i].y });
+        } else {
+            current.push_back({ seg[i].x, end, seg[i].y });
+        }
+    }
+    seg.clear();
+
+    // append a segment, filling a gap before it and coalescing equal heights
+    auto append = [this, invalidY](double x1, double x2, double y) {
+        if (!seg.empty()) {
+            const double end = seg.back().x + seg.back().w;
+            if (end < x1) {
+                if (seg.back().y == invalidY) {
+                    seg.back().w = x1 - seg.back().x;
+                } else {
+                    seg.emplace_back(end, invalidY, x1 - end);
+                }
             }
-            return;
-        } else if ((x <= cx) && ((x + w) >= (cx + i->w))) {                 // F
-            DP("    change(F) cx %f y %f\n", cx, y);
-            i->y = y;
-        } else if (x < cx) {                                            // C
-            double w1 = x + w - cx;
-            i->w    -= w1;
-            DP("    add(C) cx %f y %f w %f w1 %f\n", cx, y, w1, i->w);
-            insert(i, cx, y, w1);
-            return;
-        } else {                                                        // D
-            double w1 = x - cx;
-            double w2 = i->w - w1;
-            if (w2 > 0.0000001) {
-                i->w = w1;
-                cx  += w1;
-                DP("    add(D) %f %f\n", y, w2);
-                ++i;
-                i = insert(i, cx, y, w2);
+            if (seg.back().y == y) {
+                seg.back().w = x2 - seg.back().x;
+                return;
             }
         }
-        cx += i->w;
+        seg.emplace_back(x1, y, x2 - x1);
+    };
+
+    const double noX = std::numeric_limits<double>::max();
+    size_t i = 0;
+    size_t k = 0;
+    double x = -noX;
+    while (i < current.size() || k < added.size()) {
+        const Rect* c = i < current.size() ? &current[i] : nullptr;
+        const Rect* a = k < added.size() ? &added[k] : nullptr;
+        if (c && c->x2 <= x) {
+            ++i;
+            continue;
+        }
+        if (a && a->x2 <= x) {
+            ++k;
+            continue;
+        }
+
+        const bool inC = c && c->x1 <= x;
+        const bool inA = a && a->x1 <= x;
+        if (!inC && !inA) {
+            x = std::min(c ? c->x1 : noX, a ? a->x1 : noX);
+            continue;
+        }
+
+        double xr = noX;
+        if (c) {
+            xr = std::min(xr, inC ? c->x2 : c->x1);
+        }
+        if (a) {
+            xr = std::min(xr, inA ? a->x2 : a->x1);
+        }
+
+        const double y = inC && inA ? top(c->y, a->y) : (inC ? c->y : a->y);
+        append(x, xr, y);
+        x = xr;
     }
-    if (x >= cx) {
-        if (x > cx) {
-            double cy = north ? MAXIMUM_Y : MINIMUM_Y;
-            DP("    append1 %f %f\n", cy, x - cx);
-            append(cx, cy, x - cx);
+
+    //! NOTE A zero-width rectangle only collides with the segments of another line which it is strictly inside,
+    //! it is kept as a zero-width segment where it is higher than the segment it falls in
+    for (const Rect& p : spikes) {
+        auto it = std::upper_bound(seg.begin(), seg.end(), p.x1, [](double x, const SkylineSegment& s) { return x < s.x; });
+        if (it == seg.begin()) {
+            if (!seg.empty()) {
+                it = seg.emplace(it, p.x1, invalidY, seg.front().x - p.x1);
+            }
+            seg.emplace(it, p.x1, p.y, 0.0);
+            continue;
+        }
+
+        size_t idx = std::distance(seg.begin(), it) - 1;
+        if (idx > 0 && seg[idx].x == p.x1 && seg[idx - 1].x == p.x1) {
+            --idx;
+        }
+
+        SkylineSegment& s = seg[idx];
+        const double end = segmentEnd(idx);
+        if (s.x == p.x1 && end == p.x1) {
+            // another zero-width segment at the same x
+            s.y = top(s.y, p.y);
+        } else if (p.x1 >= end) {
+            if (p.x1 > end) {
+                append(end, p.x1, invalidY);
+            }
+            seg.emplace_back(p.x1, p.y, 0.0);
+        } else if (top(s.y, p.y) != s.y) {
+            if (p.x1 == s.x) {
+                seg.emplace(seg.begin() + idx, p.x1, p.y, 0.0);
+            } else {
+                const double y = s.y;
+                s.w = p.x1 - s.x;
+                seg.emplace(seg.begin() + idx + 1, p.x1, p.y, 0.0);
+                seg.emplace(seg.begin() + idx + 2, p.x1, y, end - p.x1);
+            }
         }
-        DP("    append2 %f %f\n", y, w);
-        append(x, y, w);
-    } else if (x + w > cx) {
-        append(cx, y, x + w - cx);
     }
 }
 
@@ -228,37 +311,26 @@ double Skyline::minDistance(const Skyline& s) const
 
 double SkylineLine::minDistance(const SkylineLine& sl) const
 {
+    flush();
+    sl.flush();
+
     double dist = MINIMUM_Y;
 
-    double x1 = 0.0;
-    double x2 = 0.0;
-    auto k   = sl.begin();
-    for (auto i = begin(); i != end(); ++i) {
-        while (k != sl.end() && (x2 + k->w) < x1) {
-            x2 += k->w;
-            ++k;
-        }
-        if (k == sl.end()) {
-            break;
-        }
-        for (;;) {
-            if ((x1 + i->w > x2) && (x1 < x2 + k->w)) {
-                dist = std::max(dist, i->y - k->y);
-            }
-            if (x2 + k->w < x1 + i->w) {
-                x2 += k->w;
-                ++k;
-                if (k == sl.end()) {
-                    break;
-                }
-            } else {
-                break;
-            }
+    size_t i = 0;
+    size_t k = 0;
+    while (i < seg.size() && k < sl.seg.size()) {
+        const SkylineSegment& s1 = seg[i];
+        const SkylineSegment& s2 = sl.seg[k];
+        const double x1r = segmentEnd(i);
+        const double x2r = sl.segmentEnd(k);
+        if ((x1r > s2.x) && (s1.x < x2r) && valid(s1) && sl.valid(s2)) {
+            dist = std::max(dist, s1.y - s2.y);
         }
-        if (k == sl.end()) {
-            break;
+        if (x2r < x1r) {
+            ++k;
+        } else {
+            ++i;
         }
-        x1 += i->w;
     }
     return dist;
 }
@@ -278,13 +350,12 @@ void Skyline::paint(Painter& painter, double lineWidth) const
 
 void SkylineLine::paint(Painter& painter) const
 {
-    double x1 = 0.0;
-    double x2;
     double y = 0.0;
 
     bool pvalid = false;
     for (const SkylineSegment& s : *this) {
-        x2 = x1 + s.w;
+        const double x1 = s.x;
+        const double x2 = s.x + s.w;
         if (valid(s)) {
             if (pvalid && !RealIsEqual(y, s.y)) {
                 painter.drawLine(LineF(x1, y, x1, s.y));
@@ -297,12 +368,12 @@ void SkylineLine::paint(Painter& painter) const
         } else {
             pvalid = false;
         }
-        x1 = x2;
     }
 }
 
 bool SkylineLine::valid() const
 {
+    flush();
     return !seg.empty();
 }
 
@@ -327,10 +398,8 @@ void Skyline::dump(const char* p, bool n) const
 
 void SkylineLine::dump() const
 {
-    double x = 0.0;
     for (const SkylineSegment& s : *this) {
-        printf("   x %f y %f w %f\n", x, s.y, s.w);
-        x += s.w;
+        printf("   x %f y %f w %f\n", s.x, s.y, s.w);
     }
 }
 
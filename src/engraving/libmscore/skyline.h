@@ -50,19 +50,24 @@ struct SkylineSegment {
 
 //---------------------------------------------------------
 //   SkylineLine
+//    Segments are sorted by x, contiguous and neighbouring
+//    segments never have the same y, apart from the two
+//    parts of a segment split by a zero-width segment, which
+//    comes from a zero-width rectangle. Added rectangles are
+//    collected and merged into the segments in one pass
+//    the next time the line is read.
 //---------------------------------------------------------
 
 class SkylineLine
 {
     const bool north;
-    std::vector<SkylineSegment> seg;
-    typedef std::vector<SkylineSegment>::iterator SegIter;
+    mutable std::vector<SkylineSegment> seg;
+    mutable std::vector<SkylineSegment> pending;     // added, but not yet merged into seg
     typedef std::vector<SkylineSegment>::const_iterator SegConstIter;
 
-    SegIter insert(SegIter i, double x, double y, double w);
-    void append(double x, double y, double w);
-    SegIter find(double x);
-    SegConstIter find(double x) const;
+    void flush() const { if (!pending.empty()) { merge(); } }
+    void merge() const;
+    double segmentEnd(size_t idx) const { return idx + 1 < seg.size() ? seg[idx + 1].x : seg[idx].x + seg[idx].w; }
 
 public:
     SkylineLine(bool n)
@@ -70,7 +75,7 @@ public:
     void add(const Shape& s);
     void add(const mu::RectF& r);
     void add(double x, double y, double w);
-    void clear() { seg.clear(); }
+    void clear() { seg.clear(); pending.clear(); }
     void paint(mu::draw::Painter& painter) const;
     void dump() const;
     double minDistance(const SkylineLine&) const;
@@ -79,10 +84,8 @@ public:
     bool valid(const SkylineSegment& s) const;
     bool isNorth() const { return north; }
 
-    SegIter begin() { return seg.begin(); }
-    SegConstIter begin() const { return seg.begin(); }
-    SegIter end() { return seg.end(); }
-    SegConstIter end() const { return seg.end(); }
+    SegConstIter begin() const { flush(); return seg.begin(); }
+    SegConstIter end() const { flush(); return seg.end(); }
 };
 
 //---------------------------------------------------------
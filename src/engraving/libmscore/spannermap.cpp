@@ -81,6 +81,15 @@ const std::vector<interval_tree::Interval<Spanner*> >& SpannerMap::findOverlappi
     return results;
 }
 
+void SpannerMap::findOverlapping(int start, int stop, std::vector<interval_tree::Interval<Spanner*> >& result) const
+{
+    if (dirty) {
+        update();
+    }
+    result.clear();
+    tree.findOverlapping(start, stop, result);
+}
+
 //---------------------------------------------------------
 //   addSpanner
 //---------------------------------------------------------
@@ -47,6 +47,8 @@ public:
 
     const std::vector<interval_tree::Interval<Spanner*> >& findContained(int start, int stop) const;
     const std::vector<interval_tree::Interval<Spanner*> >& findOverlapping(int start, int stop) const;
+    // doesn't touch the shared results, so it can be called from several threads once the map is updated
+    void findOverlapping(int start, int stop, std::vector<interval_tree::Interval<Spanner*> >& result) const;
     const std::multimap<int, Spanner*>& map() const { return *this; }
     const_reverse_it crbegin() const { return std::multimap<int, Spanner*>::crbegin(); }
     const_reverse_it crend() const { return std::multimap<int, Spanner*>::crend(); }
@@ -493,6 +493,32 @@ void UndoStack::reopen()
     }
 }
 
+//---------------------------------------------------------
+//   beginAppendToLast
+//    record the commands pushed until endAppendToLast()
+//    in the last command; without one they are only executed
+//---------------------------------------------------------
+
+void UndoStack::beginAppendToLast()
+{
+    assert(!isAppendingToLast);
+    isAppendingToLast = true;
+    activeCmd = curCmd;
+    curCmd = last();
+}
+
+//---------------------------------------------------------
+//   endAppendToLast
+//---------------------------------------------------------
+
+void UndoStack::endAppendToLast()
+{
+    assert(isAppendingToLast);
+    isAppendingToLast = false;
+    curCmd = activeCmd;
+    activeCmd = nullptr;
+}
+
 //---------------------------------------------------------
 //   setClean
 //---------------------------------------------------------
@@ -520,7 +546,9 @@ void UndoStack::undo(EditData* ed)
     if (curIdx) {
         --curIdx;
         assert(curIdx < list.size());
+        isUndoRedoRunning = true;
         list[curIdx]->undo(ed);
+        isUndoRedoRunning = false;
     }
 }
 
@@ -532,7 +560,9 @@ void UndoStack::redo(EditData* ed)
 {
     LOG_UNDO() << "called";
     if (canRedo()) {
+        isUndoRedoRunning = true;
         list[curIdx++]->redo(ed);
+        isUndoRedoRunning = false;
     }
 }
 
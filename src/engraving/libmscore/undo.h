@@ -213,6 +213,9 @@ class UndoStack
     int nextState;
     int cleanState;
     size_t curIdx = 0;
+    UndoMacro* activeCmd = nullptr;
+    bool isAppendingToLast = false;
+    bool isUndoRedoRunning = false;
 
     void remove(size_t idx);
 
@@ -221,6 +224,12 @@ public:
     ~UndoStack();
 
     bool active() const { return curCmd != 0; }
+
+    // commands pushed between these are recorded in the last command, even while another one is active
+    void beginAppendToLast();
+    void endAppendToLast();
+    bool undoRedoRunning() const { return isUndoRedoRunning; }
+
     void beginMacro(Score*);
     void endMacro(bool rollback);
     void push(UndoCommand*, EditData*);        // push & execute
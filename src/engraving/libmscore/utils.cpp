@@ -72,20 +72,24 @@ Measure* Score::tick2measure(const Fraction& tick) const
         return firstMeasure();
     }
 
-    Measure* lm = 0;
-    for (Measure* m = firstMeasure(); m; m = m->nextMeasure()) {
-        if (tick < m->tick()) {
-            assert(lm);
-            return lm;
-        }
-        lm = m;
-    }
-    // check last measure
-    if (lm && (tick >= lm->tick()) && (tick <= lm->endTick())) {
-        return lm;
+    Measure* m = _measures.tickIndex().find(tick, firstMeasure(), false);
+    if (!m) {
+        LOGD("tick2measure %d (max %d) not found", tick.ticks(), lastMeasure() ? lastMeasure()->tick().ticks() : -1);
     }
-    LOGD("tick2measure %d (max %d) not found", tick.ticks(), lm ? lm->tick().ticks() : -1);
-    return 0;
+    return m;
+}
+
+//---------------------------------------------------------
+//   prepareTick2Measure
+//    bring the lookup tables of tick2measure() and
+//    tick2measureMM() up to date, so that they can be
+//    used from several threads until the score changes
+//---------------------------------------------------------
+
+void Score::prepareTick2Measure() const
+{
+    _measures.tickIndex().prepare(firstMeasure(), false);
+    _measures.tickIndexMM().prepare(firstMeasureMM(), styleB(Sid::createMultiMeasureRests));
 }
 
 //---------------------------------------------------------
@@ -102,21 +106,11 @@ Measure* Score::tick2measureMM(const Fraction& t) const
         tick = Fraction(0, 1);
     }
 
-    Measure* lm = 0;
-
-    for (Measure* m = firstMeasureMM(); m; m = m->nextMeasureMM()) {
-        if (tick < m->tick()) {
-            assert(lm);
-            return lm;
-        }
-        lm = m;
-    }
-    // check last measure
-    if (lm && (tick >= lm->tick()) && (tick <= lm->endTick())) {
-        return lm;
+    Measure* m = _measures.tickIndexMM().find(tick, firstMeasureMM(), styleB(Sid::createMultiMeasureRests));
+    if (!m) {
+        LOGD("tick2measureMM %d (max %d) not found", tick.ticks(), lastMeasureMM() ? lastMeasureMM()->tick().ticks() : -1);
     }
-    LOGD("tick2measureMM %d (max %d) not found", tick.ticks(), lm ? lm->tick().ticks() : -1);
-    return 0;
+    return m;
 }
 
 //---------------------------------------------------------
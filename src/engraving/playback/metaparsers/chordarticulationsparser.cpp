@@ -95,7 +95,8 @@ void ChordArticulationsParser::parseSpanners(const Chord* chord, const Rendering
         return;
     }
 
-    auto intervals = spannerMap.findOverlapping(ctx.nominalPositionStartTick, ctx.nominalPositionEndTick);
+    std::vector<interval_tree::Interval<Spanner*> > intervals;
+    spannerMap.findOverlapping(ctx.nominalPositionStartTick, ctx.nominalPositionEndTick, intervals);
 
     for (const auto& interval : intervals) {
         Spanner* spanner = interval.value;
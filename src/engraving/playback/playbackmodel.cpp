@@ -22,6 +22,8 @@
 
 #include "playbackmodel.h"
 
+#include <limits>
+
 #include "libmscore/score.h"
 #include "libmscore/measure.h"
 #include "libmscore/repeatlist.h"
@@ -35,6 +37,8 @@
 
 #include "utils/pitchutils.h"
 
+#include "concurrency.h"
+
 #include "log.h"
 
 using namespace mu;
@@ -59,6 +63,18 @@ static const Harmony* findChordSymbol(const EngravingItem* item)
     return nullptr;
 }
 
+static bool isChordRestSegmentInRange(const Segment* segment, const int tickFrom, const int tickTo)
+{
+    if (!segment->isChordRestType()) {
+        return false;
+    }
+
+    int segmentStartTick = segment->tick().ticks();
+    int segmentEndTick = segmentStartTick + segment->ticks().ticks();
+
+    return segmentStartTick <= tickTo && segmentEndTick > tickFrom;
+}
+
 void PlaybackModel::load(Score* score)
 {
     if (!score || score->measures()->empty() || !score->lastMeasure()) {
@@ -107,14 +123,14 @@ void PlaybackModel::reload()
     clearExpiredContexts(trackFrom, trackTo);
 
     for (auto& pair : m_playbackDataMap) {
+        m_eventsDiffMap[pair.first].expiredEvents = std::move(pair.second.originEvents);
         pair.second.originEvents.clear();
     }
 
-    update(tickFrom, tickTo, trackFrom, trackTo);
+    ChangedTrackIdSet trackChanges;
+    update(tickFrom, tickTo, trackFrom, trackTo, &trackChanges);
 
-    for (auto& pair : m_playbackDataMap) {
-        pair.second.mainStream.send(pair.second.originEvents);
-    }
+    notifyAboutEventsChanges();
 
     m_dataChanged.notify();
 }
@@ -134,6 +150,11 @@ void PlaybackModel::setPlayRepeats(const bool isEnabled)
     m_expandRepeats = isEnabled;
 }
 
+void PlaybackModel::setMaxRenderThreadCount(const size_t count)
+{
+    m_maxRenderThreadCount = count;
+}
+
 const InstrumentTrackId& PlaybackModel::metronomeTrackId() const
 {
     return METRONOME_TRACK_ID;
@@ -295,6 +316,53 @@ void PlaybackModel::updateEvents(const int tickFrom, const int tickTo, const tra
 {
     std::set<ID> changedPartIdSet = m_score->partIdsFromRange(trackFrom, trackTo);
 
+    std::vector<const Part*> changedParts;
+    TrackRenderDataMap renderDataMap;
+
+    for (const Part* part : m_score->parts()) {
+        if (changedPartIdSet.find(part->id()) == changedPartIdSet.cend()) {
+            continue;
+        }
+
+        changedParts.push_back(part);
+
+        for (const InstrumentTrackId& trackId : part->instrumentTrackIdSet()) {
+            TrackRenderData& renderData = renderDataMap[trackId];
+            renderData.ctx = &m_playbackCtxMap[trackId];
+            renderData.profile = profilesRepository()->defaultProfile(m_playbackDataMap[trackId].setupData.category);
+
+            if (!renderData.profile) {
+                LOGE() << "unsupported instrument family: " << part->id();
+            }
+        }
+    }
+
+    //! NOTE Bring the lazily updated caches of the score up to date, so that the parts can be rendered concurrently.
+    //! Rendering only reads the score, so they stay valid until all jobs are done; a lookup that found one of them
+    //! out of date would rebuild it from several threads at once (e.g. tick2measure(), used by tick2beatType())
+    repeatList();
+    m_score->spannerMap().update();
+    m_score->prepareTick2Measure();
+
+    //! NOTE The first job renders the metronome and the chord symbols, every other job renders one part
+    std::vector<TrackEventsMap> jobResults(changedParts.size() + 1);
+    size_t maxThreadCount = changedParts.size() > 1 ? m_maxRenderThreadCount : 1;
+
+    concurrency::parallelFor(jobResults.size(), [&](size_t jobIdx) {
+        if (jobIdx == 0) {
+            renderCommonEvents(tickFrom, tickTo, changedPartIdSet, jobResults[jobIdx]);
+        } else {
+            renderPartEvents(changedParts[jobIdx - 1], tickFrom, tickTo, renderDataMap, jobResults[jobIdx]);
+        }
+    }, maxThreadCount);
+
+    for (TrackEventsMap& events : jobResults) {
+        mergeEvents(std::move(events), trackChanges);
+    }
+}
+
+void PlaybackModel::visitMeasures(const int tickFrom, const int tickTo, const MeasureVisitor& visitor) const
+{
     for (const RepeatSegment* repeatSegment : repeatList()) {
         int tickPositionOffset = repeatSegment->utick - repeatSegment->tick;
         int repeatStartTick = repeatSegment->tick;
@@ -312,74 +380,106 @@ void PlaybackModel::updateEvents(const int tickFrom, const int tickTo, const tra
                 continue;
             }
 
-            for (Segment* segment = measure->first(); segment; segment = segment->next()) {
-                if (!segment->isChordRestType()) {
+            visitor(measure, tickPositionOffset);
+        }
+    }
+}
+
+void PlaybackModel::renderCommonEvents(const int tickFrom, const int tickTo, const std::set<ID>& changedPartIdSet,
+                                       TrackEventsMap& result) const
+{
+    visitMeasures(tickFrom, tickTo, [&](const Measure* measure, const int tickPositionOffset) {
+        for (const Segment* segment = measure->first(); segment; segment = segment->next()) {
+            if (!isChordRestSegmentInRange(segment, tickFrom, tickTo)) {
+                continue;
+            }
+
+            for (const EngravingItem* item : segment->annotations()) {
+                if (!item || !item->part()) {
                     continue;
                 }
 
-                int segmentStartTick = segment->tick().ticks();
-                int segmentEndTick = segmentStartTick + segment->ticks().ticks();
+                const Harmony* chordSymbol = findChordSymbol(item);
+                if (!chordSymbol || !chordSymbol->isRealizable()) {
+                    continue;
+                }
 
-                if (segmentStartTick > tickTo || segmentEndTick <= tickFrom) {
+                if (changedPartIdSet.find(item->part()->id()) == changedPartIdSet.cend()) {
                     continue;
                 }
 
-                for (const EngravingItem* item : segment->annotations()) {
-                    if (!item || !item->part()) {
-                        continue;
-                    }
+                m_renderer.renderChordSymbol(chordSymbol, tickPositionOffset, result[CHORD_SYMBOLS_TRACK_ID]);
+            }
+        }
+
+        m_renderer.renderMetronome(m_score, measure->tick().ticks(), measure->endTick().ticks(), tickPositionOffset,
+                                   result[METRONOME_TRACK_ID]);
+    });
+}
 
-                    const Harmony* chordSymbol = findChordSymbol(item);
-                    if (!chordSymbol || !chordSymbol->isRealizable()) {
-                        continue;
-                    }
+void PlaybackModel::renderPartEvents(const Part* part, const int tickFrom, const int tickTo, const TrackRenderDataMap& renderDataMap,
+                                     TrackEventsMap& result) const
+{
+    visitMeasures(tickFrom, tickTo, [&](const Measure* measure, const int tickPositionOffset) {
+        for (const Segment* segment = measure->first(); segment; segment = segment->next()) {
+            if (!isChordRestSegmentInRange(segment, tickFrom, tickTo)) {
+                continue;
+            }
 
-                    ID partId = item->part()->id();
-                    if (changedPartIdSet.find(partId) == changedPartIdSet.cend()) {
-                        return;
-                    }
+            int segmentStartTick = segment->tick().ticks();
 
-                    m_renderer.renderChordSymbol(chordSymbol, tickPositionOffset, m_playbackDataMap[CHORD_SYMBOLS_TRACK_ID].originEvents);
-                    collectChangesTracks(CHORD_SYMBOLS_TRACK_ID, trackChanges);
-                }
+            for (track_idx_t track = part->startTrack(); track < part->endTrack(); ++track) {
+                const EngravingItem* item = segment->element(track);
 
-                for (const EngravingItem* item : segment->elist()) {
-                    if (!item || !item->isChordRest() || !item->part()) {
-                        continue;
-                    }
+                if (!item || !item->isChordRest() || !item->part()) {
+                    continue;
+                }
 
-                    ID partId = item->part()->id();
+                InstrumentTrackId trackId = idKey(item);
 
-                    if (changedPartIdSet.find(partId) == changedPartIdSet.cend()) {
-                        continue;
-                    }
+                if (!trackId.isValid()) {
+                    continue;
+                }
 
-                    InstrumentTrackId trackId = idKey(item);
+                auto renderData = renderDataMap.find(trackId);
+                if (renderData == renderDataMap.cend() || !renderData->second.profile) {
+                    continue;
+                }
 
-                    if (!trackId.isValid()) {
-                        continue;
-                    }
+                const PlaybackContext* ctx = renderData->second.ctx;
 
-                    const PlaybackContext& ctx = m_playbackCtxMap[trackId];
+                m_renderer.render(item, tickPositionOffset, ctx->appliableDynamicLevel(segmentStartTick + tickPositionOffset),
+                                  ctx->persistentArticulationType(segmentStartTick + tickPositionOffset), renderData->second.profile,
+                                  result[trackId]);
+            }
+        }
+    });
+}
 
-                    ArticulationsProfilePtr profile = profilesRepository()->defaultProfile(m_playbackDataMap[trackId].setupData.category);
-                    if (!profile) {
-                        LOGE() << "unsupported instrument family: " << partId;
-                        continue;
-                    }
+void PlaybackModel::mergeEvents(TrackEventsMap&& events, ChangedTrackIdSet* trackChanges)
+{
+    for (auto& pair : events) {
+        PlaybackEventsMap& destination = m_playbackDataMap[pair.first].originEvents;
 
-                    m_renderer.render(item, tickPositionOffset, ctx.appliableDynamicLevel(segmentStartTick + tickPositionOffset),
-                                      ctx.persistentArticulationType(segmentStartTick + tickPositionOffset), std::move(profile),
-                                      m_playbackDataMap[trackId].originEvents);
+        if (trackChanges) {
+            std::set<timestamp_t>& renderedTimestamps = m_eventsDiffMap[pair.first].renderedTimestamps;
 
-                    collectChangesTracks(trackId, trackChanges);
-                }
+            for (const auto& timestampEvents : pair.second) {
+                renderedTimestamps.insert(timestampEvents.first);
             }
+        }
 
-            m_renderer.renderMetronome(m_score, measureStartTick, measureEndTick, tickPositionOffset,
-                                       m_playbackDataMap[METRONOME_TRACK_ID].originEvents);
-            collectChangesTracks(METRONOME_TRACK_ID, trackChanges);
+        if (destination.empty()) {
+            destination = std::move(pair.second);
+        } else {
+            for (auto& timestampEvents : pair.second) {
+                PlaybackEventList& list = destination[timestampEvents.first];
+                list.insert(list.end(), std::make_move_iterator(timestampEvents.second.begin()),
+                            std::make_move_iterator(timestampEvents.second.end()));
+            }
         }
+
+        collectChangesTracks(pair.first, trackChanges);
     }
 }
 
@@ -480,8 +580,7 @@ void PlaybackModel::clearExpiredContexts(const track_idx_t trackFrom, const trac
 
 void PlaybackModel::clearExpiredEvents(const int tickFrom, const int tickTo, const track_idx_t trackFrom, const track_idx_t trackTo)
 {
-    timestamp_t timestampFrom = timestampFromTicks(m_score, tickFrom);
-    timestamp_t timestampTo = timestampFromTicks(m_score, tickTo);
+    std::vector<InstrumentTrackId> trackIds = { METRONOME_TRACK_ID, CHORD_SYMBOLS_TRACK_ID };
 
     for (const Part* part : m_score->parts()) {
         if (part->startTrack() > trackTo || part->endTrack() <= trackFrom) {
@@ -489,12 +588,38 @@ void PlaybackModel::clearExpiredEvents(const int tickFrom, const int tickTo, con
         }
 
         for (const InstrumentTrackId& trackId : part->instrumentTrackIdSet()) {
-            removeEvents(trackId, timestampFrom, timestampTo);
+            trackIds.push_back(trackId);
         }
     }
 
-    removeEvents(METRONOME_TRACK_ID, timestampFrom, timestampTo);
-    removeEvents(CHORD_SYMBOLS_TRACK_ID, timestampFrom, timestampTo);
+    const Measure* lastMeasure = m_score->lastMeasure();
+
+    if (tickFrom <= 0 && lastMeasure && tickTo >= lastMeasure->endTick().ticks()) {
+        for (const InstrumentTrackId& trackId : trackIds) {
+            removeEvents(trackId, 0, std::numeric_limits<timestamp_t>::max());
+        }
+
+        return;
+    }
+
+    //! NOTE The changed ticks are played once in every repeat segment they belong to,
+    //!      so the events rendered for them have to be expired in all of those segments
+    for (const RepeatSegment* repeatSegment : repeatList()) {
+        int tickPositionOffset = repeatSegment->utick - repeatSegment->tick;
+        int repeatStartTick = repeatSegment->tick;
+        int repeatEndTick = repeatStartTick + repeatSegment->len();
+
+        if (repeatStartTick > tickTo || repeatEndTick <= tickFrom) {
+            continue;
+        }
+
+        timestamp_t timestampFrom = timestampFromTicks(m_score, std::max(tickFrom, repeatStartTick) + tickPositionOffset);
+        timestamp_t timestampTo = timestampFromTicks(m_score, std::min(tickTo, repeatEndTick - 1) + tickPositionOffset);
+
+        for (const InstrumentTrackId& trackId : trackIds) {
+            removeEvents(trackId, timestampFrom, timestampTo);
+        }
+    }
 }
 
 void PlaybackModel::collectChangesTracks(const InstrumentTrackId& trackId, ChangedTrackIdSet* result)
@@ -515,10 +640,11 @@ void PlaybackModel::notifyAboutChanges(const InstrumentTrackIdSet& oldTracks, co
             continue;
         }
 
-        search->second.mainStream.send(search->second.originEvents);
         search->second.dynamicLevelChanges.send(search->second.dynamicLevelMap);
     }
 
+    notifyAboutEventsChanges();
+
     for (auto it = m_playbackDataMap.cbegin(); it != m_playbackDataMap.cend(); ++it) {
         if (!mu::contains(oldTracks, it->first)) {
             m_trackAdded.send(it->first);
@@ -530,6 +656,25 @@ void PlaybackModel::notifyAboutChanges(const InstrumentTrackIdSet& oldTracks, co
     }
 }
 
+void PlaybackModel::notifyAboutEventsChanges()
+{
+    for (const auto& pair : m_eventsDiffMap) {
+        auto search = m_playbackDataMap.find(pair.first);
+
+        if (search == m_playbackDataMap.cend()) {
+            continue;
+        }
+
+        PlaybackEventsDelta delta = eventsDelta(search->second.originEvents, pair.second);
+
+        if (!delta.empty()) {
+            search->second.mainStream.send(std::move(delta));
+        }
+    }
+
+    m_eventsDiffMap.clear();
+}
+
 void PlaybackModel::removeEvents(const InstrumentTrackId& trackId, const mpe::timestamp_t timestampFrom, const mpe::timestamp_t timestampTo)
 {
     auto search = m_playbackDataMap.find(trackId);
@@ -552,9 +697,45 @@ void PlaybackModel::removeEvents(const InstrumentTrackId& trackId, const mpe::ti
 
     auto upperBound = trackPlaybackData.originEvents.upper_bound(timestampTo);
 
+    if (lowerBound == upperBound) {
+        return;
+    }
+
+    //! NOTE The expired events are kept until the range is re-rendered, so that only the actual changes are sent to the audio
+    PlaybackEventsMap& expiredEvents = m_eventsDiffMap[trackId].expiredEvents;
+
     for (auto it = lowerBound; it != upperBound;) {
-        it = trackPlaybackData.originEvents.erase(it);
+        auto next = std::next(it);
+        expiredEvents.insert(trackPlaybackData.originEvents.extract(it));
+        it = next;
+    }
+}
+
+PlaybackEventsDelta PlaybackModel::eventsDelta(const PlaybackEventsMap& events, const TrackEventsDiff& diff)
+{
+    PlaybackEventsDelta result;
+
+    for (const timestamp_t timestamp : diff.renderedTimestamps) {
+        auto actual = events.find(timestamp);
+        if (actual == events.cend()) {
+            continue;
+        }
+
+        auto expired = diff.expiredEvents.find(timestamp);
+        if (expired != diff.expiredEvents.cend() && expired->second == actual->second) {
+            continue;
+        }
+
+        result.changedEvents.emplace(actual->first, actual->second);
     }
+
+    for (const auto& pair : diff.expiredEvents) {
+        if (events.find(pair.first) == events.cend()) {
+            result.removedTimestamps.push_back(pair.first);
+        }
+    }
+
+    return result;
 }
 
 PlaybackModel::TrackBoundaries PlaybackModel::trackBoundaries(const ScoreChangesRange& changesRange) const
@@ -25,6 +25,8 @@
 
 #include <unordered_map>
 #include <map>
+#include <set>
+#include <vector>
 #include <functional>
 
 #include "async/asyncable.h"
@@ -47,6 +49,8 @@ class EngravingItem;
 class Segment;
 class Instrument;
 class RepeatList;
+class Measure;
+class Part;
 
 class PlaybackModel : public async::Asyncable
 {
@@ -61,6 +65,9 @@ public:
     bool isPlayRepeatsEnabled() const;
     void setPlayRepeats(const bool isEnabled);
 
+    //! NOTE The parts are rendered in parallel on up to this amount of threads, 0 means as many as the hardware allows
+    void setMaxRenderThreadCount(const size_t count);
+
     const InstrumentTrackId& metronomeTrackId() const;
     const InstrumentTrackId& chordSymbolsTrackId() const;
 
@@ -90,6 +97,25 @@ private:
         track_idx_t trackTo = mu::nidx;
     };
 
+    using TrackEventsMap = std::unordered_map<InstrumentTrackId, mpe::PlaybackEventsMap>;
+
+    struct TrackRenderData
+    {
+        const PlaybackContext* ctx = nullptr;
+        mpe::ArticulationsProfilePtr profile = nullptr;
+    };
+
+    using TrackRenderDataMap = std::unordered_map<InstrumentTrackId, TrackRenderData>;
+
+    //! NOTE The events taken out of a track before its range is re-rendered, and the timestamps the new events were put at.
+    //!      Comparing both lets only the timestamps whose events have actually changed go to the audio
+    struct TrackEventsDiff
+    {
+        mpe::PlaybackEventsMap expiredEvents;
+        std::set<mpe::timestamp_t> renderedTimestamps;
+    };
+    using MeasureVisitor = std::function<void (const Measure* measure, const int tickPositionOffset)>;
+
     InstrumentTrackId idKey(const EngravingItem* item) const;
     InstrumentTrackId idKey(const ID& partId, const std::string& instrumentId) const;
 
@@ -100,6 +126,12 @@ private:
     void updateEvents(const int tickFrom, const int tickTo, const track_idx_t trackFrom, const track_idx_t trackTo,
                       ChangedTrackIdSet* trackChanges = nullptr);
 
+    void visitMeasures(const int tickFrom, const int tickTo, const MeasureVisitor& visitor) const;
+    void renderCommonEvents(const int tickFrom, const int tickTo, const std::set<ID>& changedPartIdSet, TrackEventsMap& result) const;
+    void renderPartEvents(const Part* part, const int tickFrom, const int tickTo, const TrackRenderDataMap& renderDataMap,
+                          TrackEventsMap& result) const;
+    void mergeEvents(TrackEventsMap&& events, ChangedTrackIdSet* trackChanges);
+
     bool hasToReloadTracks(const std::unordered_set<ElementType>& changedTypes) const;
     bool hasToReloadScore(const std::unordered_set<ElementType>& changedTypes) const;
 
@@ -109,8 +141,10 @@ private:
     void clearExpiredEvents(const int tickFrom, const int tickTo, const track_idx_t trackFrom, const track_idx_t trackTo);
     void collectChangesTracks(const InstrumentTrackId& trackId, ChangedTrackIdSet* result);
     void notifyAboutChanges(const InstrumentTrackIdSet& oldTracks, const InstrumentTrackIdSet& changedTracks);
+    void notifyAboutEventsChanges();
 
     void removeEvents(const InstrumentTrackId& trackId, const mpe::timestamp_t timestampFrom, const mpe::timestamp_t timestampTo);
+    static mpe::PlaybackEventsDelta eventsDelta(const mpe::PlaybackEventsMap& events, const TrackEventsDiff& diff);
 
     TrackBoundaries trackBoundaries(const ScoreChangesRange& changesRange) const;
     TickBoundaries tickBoundaries(const ScoreChangesRange& changesRange) const;
@@ -119,12 +153,14 @@ private:
 
     Score* m_score = nullptr;
     bool m_expandRepeats = true;
+    size_t m_maxRenderThreadCount = 0;
 
     PlaybackEventsRenderer m_renderer;
     PlaybackSetupDataResolver m_setupResolver;
 
     std::unordered_map<InstrumentTrackId, PlaybackContext> m_playbackCtxMap;
     std::unordered_map<InstrumentTrackId, mpe::PlaybackData> m_playbackDataMap;
+    std::unordered_map<InstrumentTrackId, TrackEventsDiff> m_eventsDiffMap;
 
     async::Notification m_dataChanged;
     async::Channel<InstrumentTrackId> m_trackAdded;
@@ -21,6 +21,10 @@
  */
 #include "scorereader.h"
 
+#include <algorithm>
+#include <thread>
+
+#include "concurrency.h"
 #include "io/buffer.h"
 
 #include "compat/readstyle.h"
@@ -73,9 +77,13 @@ Err ScoreReader::loadMscz(MasterScore* masterScore, const MscReader& mscReader,
     // Read images
     {
         if (!MScore::noImages) {
+            //! NOTE The images are read on first use, if they are named by their hash (as we write them)
             std::vector<String> images = mscReader.imageFileNames();
             for (const String& name : images) {
-                imageStore.add(name, mscReader.readImageFile(name));
+                MscReader::FileLoader loader = mscReader.imageFileLoader(name);
+                if (!loader || !imageStore.addLazily(name, loader)) {
+                    imageStore.add(name, mscReader.readImageFile(name));
+                }
             }
         }
     }
@@ -85,9 +93,35 @@ Err ScoreReader::loadMscz(MasterScore* masterScore, const MscReader& mscReader,
 
     Err retval = Err::NoError;
 
+    ByteArray scoreData = mscReader.readScoreFile();
+
+    //! NOTE The excerpt files are inflated in the background, while the master score is being read.
+    //! The scores themselves are created afterwards on this thread, in the order of the excerpts,
+    //! because they are linked to the master score
+    struct ExcerptFiles {
+        ByteArray styleData;
+        ByteArray scoreData;
+    };
+
+    std::vector<String> excerptNames;
+    if (mscReader.isContainer()) {
+        excerptNames = mscReader.excerptNames();
+    }
+
+    std::vector<ExcerptFiles> excerptFiles(excerptNames.size());
+    std::thread excerptFilesReader;
+    if (!excerptNames.empty()) {
+        excerptFilesReader = std::thread([&mscReader, &excerptNames, &excerptFiles]() {
+            size_t maxThreadCount = std::max<size_t>(concurrency::idealThreadCount() - 1, 1);
+            concurrency::parallelFor(excerptNames.size(), [&](size_t idx) {
+                excerptFiles[idx].styleData = mscReader.readExcerptStyleFile(excerptNames[idx]);
+                excerptFiles[idx].scoreData = mscReader.readExcerptFile(excerptNames[idx]);
+            }, maxThreadCount);
+        });
+    }
+
     // Read score
     {
-        ByteArray scoreData = mscReader.readScoreFile();
         String docName = masterScore->fileInfo()->fileName().toString();
 
         compat::ReadStyleHook styleHook(masterScore, scoreData, docName);
@@ -99,10 +133,16 @@ Err ScoreReader::loadMscz(MasterScore* masterScore, const MscReader& mscReader,
         retval = read(masterScore, xml, masterScoreCtx, &styleHook);
     }
 
+    if (excerptFilesReader.joinable()) {
+        excerptFilesReader.join();
+    }
+
     // Read excerpts
     if (masterScore->mscVersion() >= 400) {
-        std::vector<String> excerptNames = mscReader.excerptNames();
-        for (const String& excerptName : excerptNames) {
+        for (size_t idx = 0; idx < excerptNames.size(); ++idx) {
+            const String& excerptName = excerptNames.at(idx);
+            ExcerptFiles& files = excerptFiles.at(idx);
+
             Score* partScore = masterScore->createScore();
 
             compat::ReadStyleHook::setupDefaultStyle(partScore);
@@ -110,17 +150,14 @@ Err ScoreReader::loadMscz(MasterScore* masterScore, const MscReader& mscReader,
             Excerpt* ex = new Excerpt(masterScore);
             ex->setExcerptScore(partScore);
 
-            ByteArray excerptStyleData = mscReader.readExcerptStyleFile(excerptName);
-            Buffer excerptStyleBuf(&excerptStyleData);
+            Buffer excerptStyleBuf(&files.styleData);
             excerptStyleBuf.open(IODevice::ReadOnly);
             partScore->style().read(&excerptStyleBuf);
 
-            ByteArray excerptData = mscReader.readExcerptFile(excerptName);
-
             ReadContext ctx(partScore);
             ctx.initLinks(masterScoreCtx);
 
-            XmlReader xml(excerptData);
+            XmlReader xml(files.scoreData);
             xml.setDocName(excerptName);
             xml.setContext(&ctx);
 
@@ -138,8 +175,13 @@ Err ScoreReader::loadMscz(MasterScore* masterScore, const MscReader& mscReader,
     //  Read audio
     {
         if (masterScore->audio()) {
-            ByteArray dbuf1 = mscReader.readAudioFile();
-            masterScore->audio()->setData(dbuf1);
+            MscReader::FileLoader loader = mscReader.audioFileLoader();
+            if (loader) {
+                masterScore->audio()->setDataLoader(loader);
+            } else {
+                ByteArray dbuf1 = mscReader.readAudioFile();
+                masterScore->audio()->setData(dbuf1);
+            }
         }
     }
 
@@ -22,6 +22,8 @@
 
 #include "style.h"
 
+#include <atomic>
+
 #include "compat/pageformat.h"
 #include "rw/compat/readchordlisthook.h"
 #include "rw/xml.h"
@@ -37,6 +39,14 @@ using namespace mu;
 using namespace mu::io;
 using namespace mu::engraving;
 
+static std::atomic<uint64_t> s_spacingGeneration { 0 };
+
+MStyle::MStyle()
+{
+    m_spacingGeneration = ++s_spacingGeneration;
+    precomputeValues();
+}
+
 const PropertyValue& MStyle::value(Sid idx) const
 {
     if (idx == Sid::NOSTYLE) {
@@ -69,13 +79,14 @@ void MStyle::set(const Sid t, const PropertyValue& val)
 
     const size_t idx = size_t(t);
     m_values[idx] = val;
+    if (affectsHorizontalSpacing(t)) {
+        m_spacingGeneration = ++s_spacingGeneration;
+    }
+
     if (t == Sid::spatium) {
         precomputeValues();
     } else {
-        if (StyleDef::styleValues[idx].valueType() == P_TYPE::SPATIUM) {
-            double _spatium = value(Sid::spatium).toReal();
-            m_precomputedValues[idx] = m_values[idx].value<Spatium>().val() * _spatium;
-        }
+        precomputeValue(t, value(Sid::spatium).toReal());
     }
 }
 
@@ -83,12 +94,78 @@ void MStyle::precomputeValues()
 {
     double _spatium = value(Sid::spatium).toReal();
     for (const StyleDef::StyleValue& t : StyleDef::styleValues) {
-        if (t.valueType() == P_TYPE::SPATIUM) {
-            m_precomputedValues[t.idx()] = value(t.styleIdx()).value<Spatium>().val() * _spatium;
+        precomputeValue(t.styleIdx(), _spatium);
+    }
+}
+
+void MStyle::precomputeValue(Sid idx, double spatium)
+{
+    const size_t i = size_t(idx);
+    const PropertyValue& val = value(idx);
+
+    m_precomputedReals[i] = 0.0;
+    m_precomputedInts[i] = 0;
+    m_hasPrecomputedInt[i] = false;
+
+    switch (StyleDef::styleValues[i].valueType()) {
+    case P_TYPE::SPATIUM: {
+        double sp = val.value<Spatium>().val();
+        m_precomputedReals[i] = sp;
+        m_precomputedValues[i] = sp * spatium;
+    } break;
+    case P_TYPE::REAL:
+        m_precomputedReals[i] = val.toReal();
+        break;
+    case P_TYPE::BOOL:
+    case P_TYPE::INT:
+        m_precomputedInts[i] = val.toInt();
+        m_hasPrecomputedInt[i] = true;
+        break;
+    default:
+        if (val.isEnum()) {
+            m_precomputedInts[i] = val.toInt();
+            m_hasPrecomputedInt[i] = true;
         }
+        break;
     }
 }
 
+bool MStyle::affectsHorizontalSpacing(Sid idx)
+{
+    switch (idx) {
+    case Sid::pageWidth:
+    case Sid::pageHeight:
+    case Sid::pagePrintableWidth:
+    case Sid::pageEvenLeftMargin:
+    case Sid::pageOddLeftMargin:
+    case Sid::pageEvenTopMargin:
+    case Sid::pageEvenBottomMargin:
+    case Sid::pageOddTopMargin:
+    case Sid::pageOddBottomMargin:
+    case Sid::pageTwosided:
+    case Sid::staffUpperBorder:
+    case Sid::staffLowerBorder:
+    case Sid::minSystemDistance:
+    case Sid::maxSystemDistance:
+    case Sid::enableVerticalSpread:
+    case Sid::spreadSystem:
+    case Sid::spreadSquareBracket:
+    case Sid::spreadCurlyBracket:
+    case Sid::minSystemSpread:
+    case Sid::maxSystemSpread:
+    case Sid::minStaffSpread:
+    case Sid::maxStaffSpread:
+    case Sid::maxPageFillSpread:
+    case Sid::systemFrameDistance:
+    case Sid::frameSystemDistance:
+    case Sid::lastSystemFillLimit:
+        return false;
+    default:
+        break;
+    }
+    return true;
+}
+
 bool MStyle::isDefault(Sid idx) const
 {
     return value(idx) == DefaultStyle::resolveStyleDefaults(defaultStyleVersion()).value(idx);
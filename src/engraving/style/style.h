@@ -24,6 +24,7 @@
 #define MU_ENGRAVING_STYLE_H
 
 #include <array>
+#include <bitset>
 #include <cassert>
 
 #include "io/iodevice.h"
@@ -48,20 +49,27 @@ class XmlWriter;
 class MStyle
 {
 public:
-    MStyle() = default;
+    MStyle();
 
     const PropertyValue& styleV(Sid idx) const { return value(idx); }
     Spatium styleS(Sid idx) const
     {
         assert(MStyle::valueType(idx) == P_TYPE::SPATIUM);
-        return value(idx).value<Spatium>();
+        return Spatium(precomputedReal(idx));
     }
 
     Millimetre styleMM(Sid idx) const { assert(MStyle::valueType(idx) == P_TYPE::SPATIUM); return valueMM(idx); }
     String  styleSt(Sid idx) const { assert(MStyle::valueType(idx) == P_TYPE::STRING); return value(idx).value<String>(); }
-    bool     styleB(Sid idx) const { assert(MStyle::valueType(idx) == P_TYPE::BOOL); return value(idx).toBool(); }
-    double   styleD(Sid idx) const { assert(MStyle::valueType(idx) == P_TYPE::REAL); return value(idx).toReal(); }
-    int      styleI(Sid idx) const { /* can be int or enum, so no assert */ return value(idx).toInt(); }
+    bool     styleB(Sid idx) const { assert(MStyle::valueType(idx) == P_TYPE::BOOL); return precomputedInt(idx) != 0; }
+    double   styleD(Sid idx) const { assert(MStyle::valueType(idx) == P_TYPE::REAL); return precomputedReal(idx); }
+    int      styleI(Sid idx) const
+    {
+        /* can be int or enum, so no assert */
+        if (idx != Sid::NOSTYLE && m_hasPrecomputedInt[size_t(idx)]) {
+            return m_precomputedInts[size_t(idx)];
+        }
+        return value(idx).toInt();
+    }
 
     const PropertyValue& value(Sid idx) const;
     Millimetre valueMM(Sid idx) const;
@@ -79,6 +87,11 @@ public:
 
     void precomputeValues();
 
+    //! NOTE Changes whenever a value that can affect the horizontal spacing changes (everything
+    //! except the page geometry and the vertical distances). The numbers are unique among all
+    //! styles, so equal numbers mean equal values, also for copies.
+    uint64_t spacingGeneration() const { return m_spacingGeneration; }
+
     static P_TYPE valueType(const Sid);
     static const char* valueName(const Sid);
     static Sid styleIdx(const String& name);
@@ -93,8 +106,22 @@ private:
     bool readStyleValCompat(XmlReader&);
     bool readTextStyleValCompat(XmlReader&);
 
+    void precomputeValue(Sid idx, double spatium);
+    static bool affectsHorizontalSpacing(Sid idx);
+
+    double precomputedReal(Sid idx) const { return idx == Sid::NOSTYLE ? 0.0 : m_precomputedReals[size_t(idx)]; }
+    int precomputedInt(Sid idx) const { return idx == Sid::NOSTYLE ? 0 : m_precomputedInts[size_t(idx)]; }
+
     std::array<PropertyValue, size_t(Sid::STYLES)> m_values;
-    std::array<Millimetre, size_t(Sid::STYLES)> m_precomputedValues;
+
+    //! NOTE Typed copies of the values, so that the frequently used accessors don't
+    //! go through PropertyValue. Kept in sync by set() and precomputeValues().
+    std::array<Millimetre, size_t(Sid::STYLES)> m_precomputedValues;   // spatium values resolved to mm
+    std::array<double, size_t(Sid::STYLES)> m_precomputedReals = {};   // real values and spatium values in sp
+    std::array<int, size_t(Sid::STYLES)> m_precomputedInts = {};       // bool, int and enum values
+    std::bitset<size_t(Sid::STYLES)> m_hasPrecomputedInt;
+
+    uint64_t m_spacingGeneration = 0;
 };
 } // namespace mu::engraving
 
@@ -79,7 +79,7 @@ bool PropertyValue::operator ==(const PropertyValue& v) const
         return false;
     }
 
-    return v.m_type == m_type && v.m_data->equal(m_data.get());
+    return v.m_type == m_type && v.m_data.equal(m_data);
 }
 
 #ifndef NO_QT_SUPPORT
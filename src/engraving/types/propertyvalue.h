@@ -23,8 +23,11 @@
 #define MU_ENGRAVING_PROPERTYVALUE_H
 
 #include <any>
+#include <cstddef>
 #include <string>
 #include <memory>
+#include <new>
+#include <type_traits>
 #include <cassert>
 
 #include "types/string.h"
@@ -266,7 +269,7 @@ public:
     bool isValid() const;
 
     P_TYPE type() const;
-    bool isEnum() const { return m_data ? m_data->isEnum() : false; }
+    bool isEnum() const { return m_data ? m_data.isEnum() : false; }
 
     template<typename T>
     T value() const
@@ -280,7 +283,7 @@ public:
             return T();
         }
 
-        Arg<T>* at = get<T>();
+        const T* at = get<T>();
         if (!at) {
             //! HACK Temporary hack for int to enum
             if constexpr (std::is_enum<T>::value) {
@@ -291,8 +294,8 @@ public:
 
             //! HACK Temporary hack for enum to int
             if constexpr (std::is_same<T, int>::value) {
-                if (m_data->isEnum()) {
-                    return m_data->enumToInt();
+                if (m_data.isEnum()) {
+                    return m_data.enumToInt();
                 }
             }
 
@@ -318,9 +321,9 @@ public:
             //! HACK Temporary hack for real to Spatium
             if constexpr (std::is_same<T, Spatium>::value) {
                 if (P_TYPE::REAL == m_type) {
-                    Arg<double>* srv = get<double>();
+                    const double* srv = get<double>();
                     assert(srv);
-                    return srv ? Spatium(srv->v) : Spatium();
+                    return srv ? Spatium(*srv) : Spatium();
                 }
             }
 
@@ -334,9 +337,9 @@ public:
             //! HACK Temporary hack for real to Millimetre
             if constexpr (std::is_same<T, Millimetre>::value) {
                 if (P_TYPE::REAL == m_type) {
-                    Arg<double>* mrv = get<double>();
+                    const double* mrv = get<double>();
                     assert(mrv);
-                    return mrv ? Millimetre(mrv->v) : Millimetre();
+                    return mrv ? Millimetre(*mrv) : Millimetre();
                 }
             }
 
@@ -373,7 +376,7 @@ public:
         if (!at) {
             return T();
         }
-        return at->v;
+        return *at;
     }
 
     bool toBool() const { return value<bool>(); }
@@ -394,59 +397,311 @@ public:
 #endif
 
 private:
-    struct IArg {
-        virtual ~IArg() = default;
 
-        virtual bool equal(const IArg* a) const = 0;
+    //! NOTE The value is kept inline in a small buffer, so the common scalar, geometry,
+    //! fraction and color values don't touch the heap. Types that don't fit the buffer
+    //! (vectors, paths) are kept behind a shared pointer to an immutable value, like before.
+    class Data
+    {
+    public:
+        Data() = default;
 
-        virtual bool isEnum() const = 0;
-        virtual int enumToInt() const = 0;
-    };
+        template<typename T>
+        explicit Data(const T& v)
+            : m_ops(&Handler<T>::ops)
+        {
+            new (m_buf) Stored<T>(Handler<T>::store(v));
+        }
 
-    template<typename T>
-    struct Arg : public IArg {
-        T v;
-        Arg(const T& v)
-            : IArg(), v(v) {}
+        Data(const Data& d)
+            : m_ops(d.m_ops)
+        {
+            if (m_ops) {
+                m_ops->copy(m_buf, d.m_buf);
+            }
+        }
 
-        bool equal(const IArg* a) const override
+        Data(Data&& d) noexcept
+            : m_ops(d.m_ops)
         {
-            assert(a);
-            const Arg<T>* at = dynamic_cast<const Arg<T>*>(a);
-            assert(at);
-            return at ? at->v == v : false;
+            if (m_ops) {
+                m_ops->move(m_buf, d.m_buf);
+            }
         }
 
-        //! HACK Temporary hack for enum to int
-        bool isEnum() const override
+        ~Data()
         {
-            return std::is_enum<T>::value;
+            reset();
         }
 
-        int enumToInt() const override
+        Data& operator=(const Data& d)
         {
-            if constexpr (std::is_enum<T>::value) {
-                return static_cast<int>(v);
-            } else {
-                return -1;
+            if (this != &d) {
+                reset();
+                if (d.m_ops) {
+                    d.m_ops->copy(m_buf, d.m_buf);
+                    m_ops = d.m_ops;
+                }
+            }
+            return *this;
+        }
+
+        Data& operator=(Data&& d) noexcept
+        {
+            if (this != &d) {
+                reset();
+                if (d.m_ops) {
+                    d.m_ops->move(m_buf, d.m_buf);
+                    m_ops = d.m_ops;
+                }
+            }
+            return *this;
+        }
+
+        explicit operator bool() const { return m_ops != nullptr; }
+
+        //! NOTE No type check here, the caller checks the type by P_TYPE
+        template<typename T>
+        const T* get() const
+        {
+            return m_ops ? &Handler<T>::ref(m_buf) : nullptr;
+        }
+
+        bool equal(const Data& d) const
+        {
+            assert(m_ops && m_ops == d.m_ops);
+            return m_ops ? m_ops->equal(m_buf, d.m_buf) : false;
+        }
+
+        //! HACK Temporary hack for enum to int
+        bool isEnum() const { return m_ops ? m_ops->isEnum : false; }
+        int enumToInt() const { return m_ops ? m_ops->enumToInt(m_buf) : -1; }
+
+    private:
+        static constexpr size_t BUF_SIZE = 2 * sizeof(double);
+
+        template<typename T>
+        static constexpr bool isInline = sizeof(T) <= BUF_SIZE
+                                         && alignof(T) <= alignof(std::max_align_t)
+                                         && std::is_nothrow_copy_constructible<T>::value
+                                         && std::is_nothrow_move_constructible<T>::value;
+
+        template<typename T>
+        using Stored = std::conditional_t<isInline<T>, T, std::shared_ptr<const T> >;
+
+        static_assert(isInline<std::shared_ptr<const int> >, "the buffer must hold the heap fallback");
+
+        struct Ops {
+            void (* copy)(void* dst, const void* src);
+            void (* move)(void* dst, void* src);
+            void (* destroy)(void* p);
+            bool (* equal)(const void* a, const void* b);
+            int (* enumToInt)(const void* p);
+            bool isEnum;
+        };
+
+        template<typename T>
+        struct Handler {
+            static Stored<T> store(const T& v)
+            {
+                if constexpr (isInline<T>) {
+                    return v;
+                } else {
+                    return std::make_shared<const T>(v);
+                }
+            }
+
+            static const T& ref(const void* p)
+            {
+                const Stored<T>* s = std::launder(static_cast<const Stored<T>*>(p));
+                if constexpr (isInline<T>) {
+                    return *s;
+                } else {
+                    return **s;
+                }
+            }
+
+            static void copy(void* dst, const void* src)
+            {
+                new (dst) Stored<T>(*std::launder(static_cast<const Stored<T>*>(src)));
+            }
+
+            static void move(void* dst, void* src)
+            {
+                new (dst) Stored<T>(std::move(*std::launder(static_cast<Stored<T>*>(src))));
+            }
+
+            static void destroy(void* p)
+            {
+                std::launder(static_cast<Stored<T>*>(p))->~Stored<T>();
+            }
+
+            static bool equal(const void* a, const void* b)
+            {
+                return ref(a) == ref(b);
+            }
+
+            static int enumToInt([[maybe_unused]] const void* p)
+            {
+                if constexpr (std::is_enum<T>::value) {
+                    return static_cast<int>(ref(p));
+                } else {
+                    return -1;
+                }
+            }
+
+            static constexpr Ops ops = { &copy, &move, &destroy, &equal, &enumToInt, std::is_enum<T>::value };
+        };
+
+        void reset()
+        {
+            if (m_ops) {
+                m_ops->destroy(m_buf);
+                m_ops = nullptr;
             }
         }
+
+        const Ops* m_ops = nullptr;
+        alignas(std::max_align_t) unsigned char m_buf[BUF_SIZE];
     };
 
     template<typename T>
-    inline std::shared_ptr<IArg> make_data(const T& v) const
+    static constexpr P_TYPE typeOf()
     {
-        return std::shared_ptr<IArg>(new Arg<T>(v));
+        // Base
+        if constexpr (std::is_same<T, bool>::value) {
+            return P_TYPE::BOOL;
+        } else if constexpr (std::is_same<T, int>::value) {
+            return P_TYPE::INT;
+        } else if constexpr (std::is_same<T, std::vector<int> >::value) {
+            return P_TYPE::INT_VEC;
+        } else if constexpr (std::is_same<T, size_t>::value) {
+            return P_TYPE::SIZE_T;
+        } else if constexpr (std::is_same<T, double>::value) {
+            return P_TYPE::REAL;
+        } else if constexpr (std::is_same<T, String>::value) {
+            return P_TYPE::STRING;
+        }
+        // Geometry
+        else if constexpr (std::is_same<T, PointF>::value) {
+            return P_TYPE::POINT;
+        } else if constexpr (std::is_same<T, SizeF>::value) {
+            return P_TYPE::SIZE;
+        } else if constexpr (std::is_same<T, PainterPath>::value) {
+            return P_TYPE::DRAW_PATH;
+        } else if constexpr (std::is_same<T, ScaleF>::value) {
+            return P_TYPE::SCALE;
+        } else if constexpr (std::is_same<T, Spatium>::value) {
+            return P_TYPE::SPATIUM;
+        } else if constexpr (std::is_same<T, Millimetre>::value) {
+            return P_TYPE::MILLIMETRE;
+        } else if constexpr (std::is_same<T, PairF>::value) {
+            return P_TYPE::PAIR_REAL;
+        }
+        // Draw
+        else if constexpr (std::is_same<T, SymId>::value) {
+            return P_TYPE::SYMID;
+        } else if constexpr (std::is_same<T, Color>::value) {
+            return P_TYPE::COLOR;
+        } else if constexpr (std::is_same<T, OrnamentStyle>::value) {
+            return P_TYPE::ORNAMENT_STYLE;
+        } else if constexpr (std::is_same<T, GlissandoStyle>::value) {
+            return P_TYPE::GLISS_STYLE;
+        }
+        // Layout
+        else if constexpr (std::is_same<T, Align>::value) {
+            return P_TYPE::ALIGN;
+        } else if constexpr (std::is_same<T, PlacementV>::value) {
+            return P_TYPE::PLACEMENT_V;
+        } else if constexpr (std::is_same<T, PlacementH>::value) {
+            return P_TYPE::PLACEMENT_H;
+        } else if constexpr (std::is_same<T, TextPlace>::value) {
+            return P_TYPE::TEXT_PLACE;
+        } else if constexpr (std::is_same<T, DirectionV>::value) {
+            return P_TYPE::DIRECTION_V;
+        } else if constexpr (std::is_same<T, DirectionH>::value) {
+            return P_TYPE::DIRECTION_H;
+        } else if constexpr (std::is_same<T, Orientation>::value) {
+            return P_TYPE::ORIENTATION;
+        } else if constexpr (std::is_same<T, BeamMode>::value) {
+            return P_TYPE::BEAM_MODE;
+        } else if constexpr (std::is_same<T, AccidentalRole>::value) {
+            return P_TYPE::ACCIDENTAL_ROLE;
+        }
+        // Sound
+        else if constexpr (std::is_same<T, Fraction>::value) {
+            return P_TYPE::FRACTION;
+        } else if constexpr (std::is_same<T, DurationTypeWithDots>::value) {
+            return P_TYPE::DURATION_TYPE_WITH_DOTS;
+        } else if constexpr (std::is_same<T, ChangeMethod>::value) {
+            return P_TYPE::CHANGE_METHOD;
+        } else if constexpr (std::is_same<T, PitchValues>::value) {
+            return P_TYPE::PITCH_VALUES;
+        } else if constexpr (std::is_same<T, BeatsPerSecond>::value) {
+            return P_TYPE::TEMPO;
+        }
+        // Types
+        else if constexpr (std::is_same<T, LayoutBreakType>::value) {
+            return P_TYPE::LAYOUTBREAK_TYPE;
+        } else if constexpr (std::is_same<T, VeloType>::value) {
+            return P_TYPE::VELO_TYPE;
+        } else if constexpr (std::is_same<T, BarLineType>::value) {
+            return P_TYPE::BARLINE_TYPE;
+        } else if constexpr (std::is_same<T, NoteHeadType>::value) {
+            return P_TYPE::NOTEHEAD_TYPE;
+        } else if constexpr (std::is_same<T, NoteHeadScheme>::value) {
+            return P_TYPE::NOTEHEAD_SCHEME;
+        } else if constexpr (std::is_same<T, NoteHeadGroup>::value) {
+            return P_TYPE::NOTEHEAD_GROUP;
+        } else if constexpr (std::is_same<T, ClefType>::value) {
+            return P_TYPE::CLEF_TYPE;
+        } else if constexpr (std::is_same<T, DynamicType>::value) {
+            return P_TYPE::DYNAMIC_TYPE;
+        } else if constexpr (std::is_same<T, DynamicRange>::value) {
+            return P_TYPE::DYNAMIC_RANGE;
+        } else if constexpr (std::is_same<T, DynamicSpeed>::value) {
+            return P_TYPE::DYNAMIC_SPEED;
+        } else if constexpr (std::is_same<T, LineType>::value) {
+            return P_TYPE::LINE_TYPE;
+        } else if constexpr (std::is_same<T, HookType>::value) {
+            return P_TYPE::HOOK_TYPE;
+        } else if constexpr (std::is_same<T, KeyMode>::value) {
+            return P_TYPE::KEY_MODE;
+        } else if constexpr (std::is_same<T, TextStyleType>::value) {
+            return P_TYPE::TEXT_STYLE;
+        } else if constexpr (std::is_same<T, PlayingTechniqueType>::value) {
+            return P_TYPE::PLAYTECH_TYPE;
+        } else if constexpr (std::is_same<T, GradualTempoChangeType>::value) {
+            return P_TYPE::TEMPOCHANGE_TYPE;
+        } else if constexpr (std::is_same<T, SlurStyleType>::value) {
+            return P_TYPE::SLUR_STYLE_TYPE;
+        }
+        // Other
+        else if constexpr (std::is_same<T, GroupNodes>::value) {
+            return P_TYPE::GROUPS;
+        } else {
+            return P_TYPE::UNDEFINED;
+        }
     }
 
     template<typename T>
-    inline Arg<T>* get() const
+    static inline Data make_data(const T& v)
     {
-        return dynamic_cast<Arg<T>*>(m_data.get());
+        static_assert(typeOf<T>() != P_TYPE::UNDEFINED, "add the type to PropertyValue::typeOf");
+        return Data(v);
+    }
+
+    template<typename T>
+    inline const T* get() const
+    {
+        if (m_type != typeOf<T>()) {
+            return nullptr;
+        }
+        return m_data.get<T>();
     }
 
     P_TYPE m_type = P_TYPE::UNDEFINED;
-    std::shared_ptr<IArg> m_data = nullptr;
+    Data m_data;
 };
 }
 
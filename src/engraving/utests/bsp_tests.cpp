@@ -0,0 +1,106 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+#include "libmscore/bsp.h"
+#include "libmscore/masterscore.h"
+#include "libmscore/page.h"
+
+#include "utils/scorerw.h"
+
+using namespace mu;
+using namespace mu::engraving;
+
+static const String ALL_ELEMENTS_DATA_DIR("all_elements_data/");
+
+class Engraving_BspTests : public ::testing::Test
+{
+};
+
+//---------------------------------------------------------
+//   checkPageItems
+//    the items found through the page tree must match the
+//    ones found through a tree built from scratch
+//---------------------------------------------------------
+
+static void checkPageItems(Page* page)
+{
+    std::vector<EngravingItem*> elements;
+    page->scanElements(&elements, collectElements, false);
+
+    RectF pageRect = page->abbox();
+    BspTree fresh;
+    fresh.initialize(pageRect, int(elements.size()));
+    for (EngravingItem* e : elements) {
+        fresh.insert(e);
+    }
+
+    const int steps = 8;
+    double w = pageRect.width() / steps;
+    double h = pageRect.height() / steps;
+    for (int i = 0; i < steps; ++i) {
+        for (int j = 0; j < steps; ++j) {
+            RectF r(pageRect.left() + i * w, pageRect.top() + j * h, w, h);
+            std::vector<EngravingItem*> expected = fresh.items(r);
+            std::vector<EngravingItem*> actual = page->items(r);
+            std::sort(expected.begin(), expected.end());
+            std::sort(actual.begin(), actual.end());
+            EXPECT_EQ(actual, expected);
+        }
+    }
+}
+
+TEST_F(Engraving_BspTests, incrementalUpdate)
+{
+    MasterScore* score = ScoreRW::readScore(ALL_ELEMENTS_DATA_DIR + u"moonlight.mscx");
+    ASSERT_TRUE(score);
+    ASSERT_FALSE(score->pages().empty());
+
+    for (Page* page : score->pages()) {
+        checkPageItems(page);
+    }
+
+    // move everything on the pages
+    score->startCmd();
+    score->undoChangeStyleVal(Sid::staffDistance, Spatium(8.0));
+    score->endCmd();
+
+    for (Page* page : score->pages()) {
+        checkPageItems(page);
+    }
+
+    // and back
+    score->undoRedo(true, nullptr);
+
+    // the trees were updated incrementally
+    size_t incremental = 0;
+    for (Page* page : score->pages()) {
+        checkPageItems(page);
+        incremental += page->bspTreeStats().incrementalUpdates;
+    }
+    EXPECT_GT(incremental, 0);
+
+    delete score;
+}
@@ -22,13 +22,16 @@
 
 #include <gtest/gtest.h>
 
+#include "libmscore/excerpt.h"
 #include "libmscore/measure.h"
 #include "libmscore/page.h"
 #include "libmscore/rest.h"
+#include "libmscore/segment.h"
 #include "libmscore/masterscore.h"
 #include "libmscore/staff.h"
 #include "libmscore/system.h"
 #include "libmscore/tuplet.h"
+#include "libmscore/undo.h"
 
 #include "utils/scorerw.h"
 #include "utils/scorecomp.h"
@@ -44,6 +47,8 @@ class Engraving_LayoutElementsTests : public ::testing::Test
 {
 public:
     void tstLayoutAll(String file);
+    void tstRangeLayoutMatchesFullLayout(String file, int measureIdx);
+    void tstMeasureWidthCache(String file);
 };
 
 //---------------------------------------------------------
@@ -132,3 +137,211 @@ TEST_F(Engraving_LayoutElementsTests, DISABLED_tstLayoutGoldberg)
 {
     tstLayoutAll(u"goldberg.mscx");
 }
+
+//---------------------------------------------------------
+//   systemLayout
+//    measures of every system with the index of its page
+//---------------------------------------------------------
+
+static std::vector<std::pair<size_t, std::vector<MeasureBase*> > > systemLayout(Score* score)
+{
+    std::vector<std::pair<size_t, std::vector<MeasureBase*> > > result;
+    for (System* system : score->systems()) {
+        result.push_back({ system->page() ? system->page()->no() : mu::nidx, system->measures() });
+    }
+    return result;
+}
+
+//---------------------------------------------------------
+//   tstRangeLayoutMatchesFullLayout
+//    Test that the incremental layout after an edit, which
+//    stops as soon as the systems of the previous layout
+//    can be taken over, gives the same systems and pages
+//    as a full layout. The edit adds accidentals to every
+//    note of a measure, which makes it wider and only
+//    triggers a range layout
+//---------------------------------------------------------
+
+void Engraving_LayoutElementsTests::tstRangeLayoutMatchesFullLayout(String file, int measureIdx)
+{
+    MasterScore* score = ScoreRW::readScore(ALL_ELEMENTS_DATA_DIR + file);
+    EXPECT_TRUE(score);
+
+    Measure* m = score->firstMeasure();
+    for (int i = 0; i < measureIdx && m->nextMeasure(); ++i) {
+        m = m->nextMeasure();
+    }
+
+    score->startCmd();
+    score->select(m, SelectType::SINGLE, 0);
+    score->select(m, SelectType::RANGE, score->nstaves() - 1);
+    score->changeAccidental(AccidentalType::SHARP);
+    EXPECT_TRUE(score->cmdState().layoutRange());
+    EXPECT_GE(score->cmdState().endTick(), Fraction(0, 1));
+    score->endCmd();
+
+    auto rangeLayout = systemLayout(score);
+    score->doLayout();
+    EXPECT_EQ(rangeLayout, systemLayout(score));
+
+    score->undoRedo(true, 0);
+
+    rangeLayout = systemLayout(score);
+    score->doLayout();
+    EXPECT_EQ(rangeLayout, systemLayout(score));
+
+    delete score;
+}
+
+TEST_F(Engraving_LayoutElementsTests, tstRangeLayoutMoonlight)
+{
+    tstRangeLayoutMatchesFullLayout(u"moonlight.mscx", 3);
+}
+
+//---------------------------------------------------------
+//   tstDeferredExcerptLayout
+//    Test that the layout of an excerpt, which is not open
+//    during an edit, is done when its systems are used, gives
+//    the same result as a full layout, and that the changes it
+//    makes are recorded in the edit, even if another command
+//    is active
+//---------------------------------------------------------
+
+TEST_F(Engraving_LayoutElementsTests, tstDeferredExcerptLayout)
+{
+    MasterScore* score = ScoreRW::readScore(ALL_ELEMENTS_DATA_DIR + u"moonlight.mscx");
+    EXPECT_TRUE(score);
+
+    // the part has multimeasure rests, which are added by the layout through undo commands
+    Excerpt* excerpt = Excerpt::createExcerptFromPart(score->parts().front());
+    score->initAndAddExcerpt(excerpt, true);
+    Score* part = excerpt->excerptScore();
+    part->doLayout();
+    EXPECT_FALSE(part->isOpen());
+    const size_t measureCount = part->nmeasures();
+
+    // two empty measures in the master score give a multimeasure rest in the part
+    Measure* m = score->firstMeasure()->nextMeasure()->nextMeasure();
+    score->startCmd();
+    score->insertMeasure(ElementType::MEASURE, m);
+    score->insertMeasure(ElementType::MEASURE, m);
+    score->endCmd();
+
+    EXPECT_TRUE(part->hasDeferredLayout());
+    const size_t undoIdx = score->undoStack()->getCurIdx();
+    const size_t editChildCount = score->undoStack()->last()->childCount();
+
+    // the systems of the part are laid out when they are used
+    auto deferredLayout = systemLayout(part);
+    EXPECT_FALSE(part->hasDeferredLayout());
+    EXPECT_TRUE(part->firstMeasure()->nextMeasure()->nextMeasure()->mmRest());
+    EXPECT_GT(score->undoStack()->last()->childCount(), editChildCount);
+
+    part->doLayout();
+    EXPECT_EQ(deferredLayout, systemLayout(part));
+
+    // undo of the edit also undoes the changes made by the layout of the part
+    score->undoRedo(true, 0);
+    EXPECT_EQ(part->nmeasures(), measureCount);
+    EXPECT_FALSE(part->firstMeasure()->nextMeasure()->nextMeasure()->mmRest());
+
+    deferredLayout = systemLayout(part);
+    part->doLayout();
+    EXPECT_EQ(deferredLayout, systemLayout(part));
+
+    // open the part while an unrelated command is active, like a paint during a drag
+    score->undoRedo(false, 0);
+    EXPECT_TRUE(part->hasDeferredLayout());
+
+    score->startCmd();
+    part->setIsOpen(true);
+    EXPECT_FALSE(part->hasDeferredLayout());
+    EXPECT_EQ(score->undoStack()->current()->childCount(), 0);
+    score->endCmd();
+
+    EXPECT_EQ(score->undoStack()->getCurIdx(), undoIdx);
+    EXPECT_TRUE(part->firstMeasure()->nextMeasure()->nextMeasure()->mmRest());
+
+    deferredLayout = systemLayout(part);
+    part->doLayout();
+    EXPECT_EQ(deferredLayout, systemLayout(part));
+
+    delete score;
+}
+
+//---------------------------------------------------------
+//   measureWidths
+//    width of every measure and position of its segments
+//---------------------------------------------------------
+
+static std::vector<std::vector<double> > measureWidths(Score* score)
+{
+    std::vector<std::vector<double> > result;
+    for (Measure* m = score->firstMeasure(); m; m = m->nextMeasure()) {
+        std::vector<double> widths { m->width() };
+        for (Segment* s = m->first(); s; s = s->next()) {
+            widths.push_back(s->x());
+            widths.push_back(s->width());
+        }
+        result.push_back(widths);
+    }
+    return result;
+}
+
+static void layoutWithoutWidthCache(Score* score)
+{
+    for (Measure* m = score->firstMeasure(); m; m = m->nextMeasure()) {
+        m->invalidateWidthCache();
+    }
+    score->doLayout();
+}
+
+//---------------------------------------------------------
+//   tstMeasureWidthCache
+//    Test that a layout reusing the cached measure widths
+//    after a page size change gives the same result as a
+//    layout computing all of them again
+//---------------------------------------------------------
+
+void Engraving_LayoutElementsTests::tstMeasureWidthCache(String file)
+{
+    MasterScore* score = ScoreRW::readScore(ALL_ELEMENTS_DATA_DIR + file);
+    EXPECT_TRUE(score);
+
+    const double pageWidth = score->styleD(Sid::pageWidth);
+    const double printableWidth = score->styleD(Sid::pagePrintableWidth);
+
+    for (double delta : { -1.0, 0.5 }) {
+        score->startCmd();
+        score->undoChangeStyleVal(Sid::pageWidth, pageWidth + delta);
+        score->undoChangeStyleVal(Sid::pagePrintableWidth, printableWidth + delta);
+        score->endCmd();
+
+        score->doLayout();
+
+        auto cachedLayout = systemLayout(score);
+        auto cachedWidths = measureWidths(score);
+
+        layoutWithoutWidthCache(score);
+        EXPECT_EQ(cachedLayout, systemLayout(score));
+        EXPECT_EQ(cachedWidths, measureWidths(score));
+    }
+
+    // a spacing style change must not reuse the cached widths
+    score->startCmd();
+    score->undoChangeStyleVal(Sid::minNoteDistance, Spatium(score->styleS(Sid::minNoteDistance).val() + 0.5));
+    score->endCmd();
+
+    auto layout = systemLayout(score);
+    auto widths = measureWidths(score);
+    layoutWithoutWidthCache(score);
+    EXPECT_EQ(layout, systemLayout(score));
+    EXPECT_EQ(widths, measureWidths(score));
+
+    delete score;
+}
+
+TEST_F(Engraving_LayoutElementsTests, tstMeasureWidthCacheMoonlight)
+{
+    tstMeasureWidthCache(u"moonlight.mscx");
+}
@@ -37,13 +37,49 @@
 #include "libmscore/engravingitem.h"
 #include "libmscore/system.h"
 #include "libmscore/durationtype.h"
+#include "libmscore/factory.h"
+#include "libmscore/timesig.h"
 
 #include "utils/scorerw.h"
 #include "utils/scorecomp.h"
 
+#include "log.h"
+
 using namespace mu;
 using namespace mu::engraving;
 
+//---------------------------------------------------------
+//   linearTick2measure
+//    reference implementation: walk the measure chain
+//---------------------------------------------------------
+
+static Measure* linearTick2measure(const Score* score, const Fraction& tick, bool useMMRests)
+{
+    Measure* lm = nullptr;
+    Measure* first = useMMRests ? score->firstMeasureMM() : score->firstMeasure();
+    for (Measure* m = first; m; m = useMMRests ? m->nextMeasureMM() : m->nextMeasure()) {
+        if (tick < m->tick()) {
+            return lm;
+        }
+        lm = m;
+    }
+    if (lm && tick >= lm->tick() && tick <= lm->endTick()) {
+        return lm;
+    }
+    return nullptr;
+}
+
+static void checkTick2measure(const Score* score)
+{
+    const Measure* last = score->lastMeasure();
+    ASSERT_TRUE(last);
+    const Fraction step(1, 8);
+    for (Fraction tick = step; tick <= last->endTick(); tick += step) {
+        EXPECT_EQ(score->tick2measure(tick), linearTick2measure(score, tick, false));
+        EXPECT_EQ(score->tick2measureMM(tick), linearTick2measure(score, tick, true));
+    }
+}
+
 static const String MEASURE_DATA_DIR("measure_data/");
 
 class Engraving_MeasureTests : public ::testing::Test
@@ -560,3 +596,67 @@ TEST_F(Engraving_MeasureTests, measureNumbers)
 
     delete score;
 }
+
+//---------------------------------------------------------
+///   tick2measureIndex
+///    indexed tick -> measure lookup stays valid through
+///    measure insertion, deletion, time signature changes
+///    and mmrest creation
+//---------------------------------------------------------
+
+TEST_F(Engraving_MeasureTests, tick2measureIndex)
+{
+    MasterScore* score = ScoreRW::readScore(MEASURE_DATA_DIR + u"mmrest.mscx");
+    EXPECT_TRUE(score);
+    checkTick2measure(score);
+
+    // insert
+    score->startCmd();
+    score->insertMeasure(ElementType::MEASURE, score->firstMeasure()->nextMeasure());
+    score->endCmd();
+    checkTick2measure(score);
+
+    // change time signature
+    TimeSig* ts = Factory::createTimeSig(score->dummy()->segment());
+    ts->setSig(Fraction(3, 4), TimeSigType::NORMAL);
+    score->startCmd();
+    score->cmdAddTimeSig(score->firstMeasure()->nextMeasure(), 0, ts, false);
+    score->endCmd();
+    checkTick2measure(score);
+
+    // delete
+    score->startCmd();
+    Measure* m = score->firstMeasure()->nextMeasure()->nextMeasure();
+    score->deleteMeasures(m, m);
+    score->endCmd();
+    checkTick2measure(score);
+
+    // mmrests
+    score->startCmd();
+    score->undo(new ChangeStyleVal(score, Sid::createMultiMeasureRests, true));
+    score->setLayoutAll();
+    score->endCmd();
+    checkTick2measure(score);
+
+    // remove and add a mmrest like undo does
+    Measure* mmrestMeasure = nullptr;
+    for (Measure* m2 = score->firstMeasure(); m2 && !mmrestMeasure; m2 = m2->nextMeasure()) {
+        if (m2->mmRest()) {
+            mmrestMeasure = m2;
+        }
+    }
+    ASSERT_TRUE(mmrestMeasure);
+    Measure* mmrest = mmrestMeasure->mmRest();
+    mmrestMeasure->remove(mmrest);
+    checkTick2measure(score);
+    mmrestMeasure->add(mmrest);
+    checkTick2measure(score);
+
+    // undo everything
+    for (int i = 0; i < 4; ++i) {
+        score->undoRedo(true, 0);
+        checkTick2measure(score);
+    }
+
+    delete score;
+}
@@ -21,11 +21,18 @@
  */
 #include <gtest/gtest.h>
 
+#include <cstdio>
+#include <fstream>
+
 #include <QByteArray>
 
+#include "concurrency.h"
 #include "io/buffer.h"
+#include "io/dir.h"
+#include "io/fileinfo.h"
 #include "infrastructure/mscwriter.h"
 #include "infrastructure/mscreader.h"
+#include "libmscore/imageStore.h"
 
 using namespace mu;
 using namespace mu::io;
@@ -87,3 +94,365 @@ TEST_F(Engraving_MsczFileTests, MsczFile_WriteRead)
         EXPECT_EQ(imageData, originImageData);
     }
 }
+
+TEST_F(Engraving_MsczFileTests, MsczFile_ReadExcerpts_Concurrently)
+{
+    //! CASE Reading the excerpts of a large score from several threads, like ScoreReader::loadMscz does
+
+    //! GIVEN A file with many large excerpts
+    const size_t excerptCount = 16;
+
+    std::vector<ByteArray> originExcerptDatas;
+    uint32_t seed = 1;
+    for (size_t i = 0; i < excerptCount; ++i) {
+        std::string data = "<museScore version=\"4.00\">\n<Score>\n";
+        for (int m = 0; m < 500; ++m) {
+            seed = seed * 1103515245 + 12345;
+            data += "<Measure><voice><Chord><durationType>quarter</durationType><Note><pitch>"
+                    + std::to_string(seed % 128) + "</pitch><tpc>" + std::to_string((seed >> 8) % 35)
+                    + "</tpc></Note></Chord></voice></Measure>\n";
+        }
+        data += "</Score>\n</museScore>\n";
+        originExcerptDatas.push_back(ByteArray(data.c_str()));
+    }
+
+    ByteArray msczData;
+    {
+        Buffer buf(&msczData);
+        MscWriter::Params params;
+        params.device = &buf;
+        params.filePath = "excerpts.mscz";
+        params.mode = MscIoMode::Zip;
+
+        MscWriter writer(params);
+        writer.open();
+
+        writer.writeScoreFile(ByteArray("score"));
+        for (size_t i = 0; i < excerptCount; ++i) {
+            String name = u"Part " + String::number(int(i));
+            writer.addExcerptStyleFile(name, ByteArray("style"));
+            writer.addExcerptFile(name, originExcerptDatas.at(i));
+        }
+    }
+
+    Buffer buf(&msczData);
+    MscReader::Params params;
+    params.device = &buf;
+    params.filePath = "excerpts.mscz";
+    params.mode = MscIoMode::Zip;
+
+    MscReader reader(params);
+    reader.open();
+
+    std::vector<String> names = reader.excerptNames();
+    ASSERT_EQ(names.size(), excerptCount);
+
+    //! DO Read the excerpts one by one
+    std::vector<ByteArray> serialDatas(excerptCount);
+    for (size_t i = 0; i < excerptCount; ++i) {
+        serialDatas[i] = reader.readExcerptFile(names.at(i));
+    }
+
+    //! DO Read the excerpts concurrently
+    std::vector<ByteArray> concurrentDatas(excerptCount);
+    std::vector<ByteArray> concurrentStyleDatas(excerptCount);
+    concurrency::parallelFor(excerptCount, [&](size_t i) {
+        concurrentStyleDatas[i] = reader.readExcerptStyleFile(names.at(i));
+        concurrentDatas[i] = reader.readExcerptFile(names.at(i));
+    }, std::max<size_t>(concurrency::idealThreadCount(), 4));
+
+    //! CHECK The same data
+    for (size_t i = 0; i < excerptCount; ++i) {
+        EXPECT_EQ(serialDatas.at(i), concurrentDatas.at(i));
+        EXPECT_EQ(concurrentStyleDatas.at(i), ByteArray("style"));
+    }
+
+    //! CHECK The data of every excerpt
+    for (size_t i = 0; i < excerptCount; ++i) {
+        size_t originIdx = static_cast<size_t>(names.at(i).mid(5).toInt());
+        EXPECT_EQ(concurrentDatas.at(i), originExcerptDatas.at(originIdx));
+    }
+}
+
+static void writeMsczWithImage(const path_t& filePath, const String& imageName, const ByteArray& imageData)
+{
+    ByteArray msczData;
+    Buffer buf(&msczData);
+    MscWriter::Params params;
+    params.device = &buf;
+    params.filePath = filePath;
+    params.mode = MscIoMode::Zip;
+
+    MscWriter writer(params);
+    writer.open();
+    writer.writeScoreFile(ByteArray("score"));
+    writer.addImageFile(imageName, imageData);
+    writer.close();
+
+    std::ofstream stream(filePath.toStdString(), std::ios::binary);
+    stream.write(reinterpret_cast<const char*>(msczData.constData()), msczData.size());
+}
+
+static ImageStoreItem* addImageLazily(const path_t& filePath, const String& imageName, int& loadCount)
+{
+    MscReader::Params params;
+    params.filePath = filePath;
+    params.mode = MscIoMode::Zip;
+
+    MscReader reader(params);
+    if (!reader.open()) {
+        return nullptr;
+    }
+
+    MscReader::FileLoader loader = reader.imageFileLoader(imageName);
+    if (!loader) {
+        return nullptr;
+    }
+
+    ImageStoreItem* item = imageStore.addLazily(imageName, [loader, &loadCount]() {
+        ++loadCount;
+        return loader();
+    });
+
+    reader.close();
+    return item;
+}
+
+TEST_F(Engraving_MsczFileTests, MsczFile_ReadImage_Lazily)
+{
+    //! CASE Reading an image on first use, after the file was closed
+
+    //! GIVEN A file with an image named by its hash, like we write them
+    const ByteArray originImageData("image");
+    const String imageName = imageStore.add(u"image.png", originImageData)->hashName();
+    imageStore.clearUnused();
+
+    path_t filePath("MsczFile_ReadImage_Lazily.mscz");
+    writeMsczWithImage(filePath, imageName, originImageData);
+
+    //! DO Add the image to the store by a loader and close the file
+    int loadCount = 0;
+    ASSERT_TRUE(addImageLazily(filePath, imageName, loadCount));
+
+    //! CHECK The image is found by its name, but not read yet
+    ImageStoreItem* item = imageStore.getImage(imageName);
+    ASSERT_TRUE(item);
+    EXPECT_EQ(item->hashName(), imageName);
+    EXPECT_EQ(loadCount, 0);
+
+    //! CHECK The image is read once, on first use, from the file opened again
+    EXPECT_EQ(item->buffer(), originImageData);
+    EXPECT_EQ(item->buffer(), originImageData);
+    EXPECT_EQ(loadCount, 1);
+    EXPECT_EQ(item->hashName(), imageName);
+
+    imageStore.clearUnused();
+    std::remove(filePath.toStdString().c_str());
+}
+
+TEST_F(Engraving_MsczFileTests, MsczFile_ReadImage_Lazily_WrongName)
+{
+    //! GIVEN A file with an image whose name isn't the hash of its data
+    const String imageName = u"0123456789abcdef0123456789abcdef.png";
+    const ByteArray originImageData("image");
+
+    path_t filePath("MsczFile_ReadImage_Lazily_WrongName.mscz");
+    writeMsczWithImage(filePath, imageName, originImageData);
+
+    int loadCount = 0;
+    ImageStoreItem* item = addImageLazily(filePath, imageName, loadCount);
+    ASSERT_TRUE(item);
+
+    //! DO Read the image
+    EXPECT_EQ(item->buffer(), originImageData);
+
+    //! CHECK The hash is taken from the data, not from the name
+    const String dataHashName = imageStore.add(u"image.png", originImageData)->hashName();
+    EXPECT_NE(dataHashName, imageName);
+    EXPECT_EQ(item->hashName(), dataHashName);
+
+    imageStore.clearUnused();
+    std::remove(filePath.toStdString().c_str());
+}
+
+TEST_F(Engraving_MsczFileTests, MsczFile_ReadImage_Lazily_FileChanged)
+{
+    //! GIVEN An image added to the store by a loader
+    const ByteArray originImageData("image");
+    const String imageName = imageStore.add(u"image.png", originImageData)->hashName();
+    imageStore.clearUnused();
+
+    path_t filePath("MsczFile_ReadImage_Lazily_FileChanged.mscz");
+    writeMsczWithImage(filePath, imageName, originImageData);
+
+    int loadCount = 0;
+    ImageStoreItem* item = addImageLazily(filePath, imageName, loadCount);
+    ASSERT_TRUE(item);
+
+    //! DO Overwrite the file before the image is used
+    writeMsczWithImage(filePath, imageName, ByteArray("another image"));
+
+    //! CHECK The image isn't read from the other file, and is known to be lost
+    EXPECT_TRUE(item->buffer().empty());
+    EXPECT_EQ(loadCount, 1);
+    EXPECT_TRUE(item->isLost());
+
+    //! DO Remove the file
+    imageStore.clearUnused();
+    item = addImageLazily(filePath, imageName, loadCount);
+    ASSERT_TRUE(item);
+    std::remove(filePath.toStdString().c_str());
+
+    //! CHECK The image is lost too
+    EXPECT_TRUE(item->buffer().empty());
+    EXPECT_TRUE(item->isLost());
+
+    imageStore.clearUnused();
+}
+
+TEST_F(Engraving_MsczFileTests, MsczFile_NoLoader_For_Foreign_Device)
+{
+    //! GIVEN A file read from a device which the reader doesn't own
+    ByteArray msczData;
+    {
+        Buffer buf(&msczData);
+        MscWriter::Params params;
+        params.device = &buf;
+        params.filePath = "foreign.mscz";
+        params.mode = MscIoMode::Zip;
+
+        MscWriter writer(params);
+        writer.open();
+        writer.writeScoreFile(ByteArray("score"));
+        writer.addImageFile(u"image1.png", ByteArray("image"));
+    }
+
+    Buffer buf(&msczData);
+    MscReader::Params params;
+    params.device = &buf;
+    params.filePath = "foreign.mscz";
+    params.mode = MscIoMode::Zip;
+
+    MscReader reader(params);
+    reader.open();
+
+    //! CHECK The device may be gone before the image is used, so it has to be read now
+    EXPECT_FALSE(reader.imageFileLoader(u"image1.png"));
+    EXPECT_FALSE(reader.audioFileLoader());
+}
+
+static void writeScoreByStream(MscWriter::Params params, const ByteArray& scoreData, const ByteArray& excerptData)
+{
+    MscWriter writer(params);
+    writer.open();
+
+    IODevice* scoreDevice = writer.beginScoreFile();
+    ASSERT_TRUE(scoreDevice);
+    scoreDevice->write(scoreData);
+    EXPECT_TRUE(writer.endFile());
+
+    IODevice* excerptDevice = writer.beginExcerptFile(u"excerpt1");
+    ASSERT_TRUE(excerptDevice);
+    excerptDevice->write(excerptData);
+    EXPECT_TRUE(writer.endFile());
+}
+
+TEST_F(Engraving_MsczFileTests, MsczFile_WriteScore_ByStream)
+{
+    //! GIVEN A score and an excerpt, written by stream, like MasterScore does
+    const ByteArray originScoreData("score");
+    const ByteArray originExcerptData("excerpt");
+
+    ByteArray msczData;
+    {
+        Buffer buf(&msczData);
+        MscWriter::Params params;
+        params.device = &buf;
+        params.filePath = "stream.mscz";
+        params.mode = MscIoMode::Zip;
+        params.compressionLevel = 1;
+
+        writeScoreByStream(params, originScoreData, originExcerptData);
+    }
+
+    //! DO Read it back
+    Buffer buf(&msczData);
+    MscReader::Params params;
+    params.device = &buf;
+    params.filePath = "stream.mscz";
+    params.mode = MscIoMode::Zip;
+
+    MscReader reader(params);
+    reader.open();
+
+    //! CHECK The files are the same as written
+    EXPECT_EQ(reader.readScoreFile(), originScoreData);
+    EXPECT_EQ(reader.readExcerptFile(u"excerpt1"), originExcerptData);
+}
+
+TEST_F(Engraving_MsczFileTests, MsczFile_WriteScore_ByStream_Dir)
+{
+    //! CASE The dir writer can't write by stream, so the files are collected in memory first
+
+    //! GIVEN A score and an excerpt, written by stream, like MasterScore does
+    const ByteArray originScoreData("score");
+    const ByteArray originExcerptData("excerpt");
+
+    const path_t filePath("MsczFile_WriteScore_ByStream_Dir/stream.mscx");
+    {
+        MscWriter::Params params;
+        params.filePath = filePath;
+        params.mode = MscIoMode::Dir;
+
+        writeScoreByStream(params, originScoreData, originExcerptData);
+    }
+
+    //! DO Read it back
+    MscReader::Params params;
+    params.filePath = filePath;
+    params.mode = MscIoMode::Dir;
+
+    MscReader reader(params);
+    reader.open();
+
+    //! CHECK The files are the same as written
+    EXPECT_EQ(reader.readScoreFile(), originScoreData);
+    EXPECT_EQ(reader.readExcerptFile(u"excerpt1"), originExcerptData);
+
+    reader.close();
+    Dir(FileInfo(filePath).absolutePath()).removeRecursively();
+}
+
+TEST_F(Engraving_MsczFileTests, MsczFile_WriteScore_ByStream_XmlFile)
+{
+    //! CASE The xml file writer can't write by stream, so the files are collected in memory first
+
+    //! GIVEN A score and an excerpt, written by stream, like MasterScore does
+    const ByteArray originScoreData("score");
+    const ByteArray originExcerptData("excerpt");
+
+    ByteArray mscsData;
+    {
+        Buffer buf(&mscsData);
+        MscWriter::Params params;
+        params.device = &buf;
+        params.filePath = "stream.mscs";
+        params.mode = MscIoMode::XmlFile;
+
+        writeScoreByStream(params, originScoreData, originExcerptData);
+    }
+
+    //! DO Read it back
+    Buffer buf(&mscsData);
+    MscReader::Params params;
+    params.device = &buf;
+    params.filePath = "stream.mscs";
+    params.mode = MscIoMode::XmlFile;
+
+    MscReader reader(params);
+    reader.open();
+
+    //! CHECK The files are the same as written
+    EXPECT_EQ(reader.readScoreFile(), originScoreData);
+    EXPECT_EQ(reader.readExcerptFile(u"excerpt1"), originExcerptData);
+}
@@ -379,8 +379,8 @@ TEST_F(Engraving_PlaybackModelTests, DISABLED_Repeat_Last_Measure)
  * @details In this case we're building up a playback model of a simple score - Violin, 4/4, 120bpm, Treble Cleff, 4 measures
  *          Additionally, there is a simple repeat from measure 2 up to measure 3. In total, we'll be playing 6 measures overall
  *
- *          When the model will be loaded we'll emulate a change notification on the 2-nd measure, so that there will be updated events
- *          on the main stream channel
+ *          When the model will be loaded we'll emulate a change notification on the 2-nd measure without any actual changes,
+ *          so that nothing will be sent on the main stream channel
  */
 TEST_F(Engraving_PlaybackModelTests, SimpleRepeat_Changes_Notification)
 {
@@ -397,9 +397,6 @@ TEST_F(Engraving_PlaybackModelTests, SimpleRepeat_Changes_Notification)
     // [GIVEN] The articulation profiles repository will be returning profiles for StringsArticulation family
     ON_CALL(*m_repositoryMock, defaultProfile(ArticulationFamily::Strings)).WillByDefault(Return(m_defaultProfile));
 
-    // [GIVEN] Expected amount of changed events
-    int expectedChangedEventsCount = 24;
-
     // [GIVEN] The playback model requested to be loaded
     PlaybackModel model;
     model.setprofilesRepository(m_repositoryMock);
@@ -407,9 +404,10 @@ TEST_F(Engraving_PlaybackModelTests, SimpleRepeat_Changes_Notification)
 
     PlaybackData result = model.resolveTrackPlaybackData(part->id(), part->instrumentId().toStdString());
 
-    // [THEN] Updated events map will match our expectations
-    result.mainStream.onReceive(this, [expectedChangedEventsCount](const PlaybackEventsMap& updatedEvents) {
-        EXPECT_EQ(updatedEvents.size(), expectedChangedEventsCount);
+    // [THEN] The events haven't changed, so there is nothing to send
+    bool deltaReceived = false;
+    result.mainStream.onReceive(this, [&deltaReceived](const PlaybackEventsDelta&) {
+        deltaReceived = true;
     });
 
     // [WHEN] Notation has been changed on the 2-nd measure
@@ -421,6 +419,86 @@ TEST_F(Engraving_PlaybackModelTests, SimpleRepeat_Changes_Notification)
     range.changedTypes = { ElementType::NOTE };
 
     score->changesChannel().send(range);
+
+    EXPECT_FALSE(deltaReceived);
+
+    // [THEN] The amount of events is still the same
+    EXPECT_EQ(model.resolveTrackPlaybackData(part->id(), part->instrumentId().toStdString()).originEvents.size(), 24);
+}
+
+/**
+ * @brief PlaybackModelTests_SimpleRepeat_Changed_Note_Delta
+ * @details In this case we're building up a playback model of a simple score - Violin, 4/4, 120bpm, Treble Cleff, 4 measures
+ *          Additionally, there is a simple repeat from measure 2 up to measure 3. In total, we'll be playing 6 measures overall
+ *
+ *          We'll move the first note of the 2-nd measure an octave up and make sure that the main stream channel carries
+ *          only the events of that note, once for every time the 2-nd measure is played
+ */
+TEST_F(Engraving_PlaybackModelTests, SimpleRepeat_Changed_Note_Delta)
+{
+    // [GIVEN] Simple piece of score (Violin, 4/4, 120 bpm, Treble Cleff)
+    Score* score = ScoreRW::readScore(PLAYBACK_MODEL_TEST_FILES_DIR + "repeat_range/repeat_range.mscx");
+
+    ASSERT_TRUE(score);
+    ASSERT_EQ(score->parts().size(), 1);
+
+    const Part* part = score->parts().at(0);
+    ASSERT_TRUE(part);
+    ASSERT_EQ(part->instruments().size(), 1);
+
+    // [GIVEN] The articulation profiles repository will be returning profiles for StringsArticulation family
+    ON_CALL(*m_repositoryMock, defaultProfile(ArticulationFamily::Strings)).WillByDefault(Return(m_defaultProfile));
+
+    // [GIVEN] The first note of the 2-nd measure
+    Measure* secondMeasure = score->firstMeasure()->nextMeasure();
+    ASSERT_TRUE(secondMeasure);
+
+    Segment* firstSegment = secondMeasure->segments().firstCRSegment();
+    ASSERT_TRUE(firstSegment);
+
+    Chord* chord = toChord(firstSegment->nextChordRest(0));
+    ASSERT_TRUE(chord);
+    ASSERT_FALSE(chord->notes().empty());
+
+    Note* note = chord->notes().front();
+
+    // [GIVEN] The playback model requested to be loaded
+    PlaybackModel model;
+    model.setprofilesRepository(m_repositoryMock);
+    model.load(score);
+
+    PlaybackData result = model.resolveTrackPlaybackData(part->id(), part->instrumentId().toStdString());
+    PlaybackEventsMap expectedEvents = result.originEvents;
+
+    // [THEN] Only the timestamps of the changed note are sent, the 2-nd measure is played at 1000ms and 3000ms
+    std::vector<PlaybackEventsDelta> receivedDeltas;
+    result.mainStream.onReceive(this, [&receivedDeltas](const PlaybackEventsDelta& delta) {
+        receivedDeltas.push_back(delta);
+    });
+
+    // [WHEN] The note has been moved an octave up
+    note->setPitch(note->pitch() + 12);
+
+    ScoreChangesRange range;
+    range.tickFrom = 1920;
+    range.tickTo = 3840;
+    range.staffIdxFrom = 0;
+    range.staffIdxTo = 0;
+    range.changedTypes = { ElementType::NOTE };
+
+    score->changesChannel().send(range);
+
+    ASSERT_EQ(receivedDeltas.size(), 1);
+
+    const PlaybackEventsDelta& delta = receivedDeltas.front();
+    EXPECT_TRUE(delta.removedTimestamps.empty());
+    ASSERT_EQ(delta.changedEvents.size(), 2);
+    EXPECT_TRUE(delta.changedEvents.find(1000) != delta.changedEvents.cend());
+    EXPECT_TRUE(delta.changedEvents.find(3000) != delta.changedEvents.cend());
+
+    // [THEN] Applying the delta gives the same events as the model has
+    delta.applyTo(expectedEvents);
+    EXPECT_EQ(expectedEvents, model.resolveTrackPlaybackData(part->id(), part->instrumentId().toStdString()).originEvents);
 }
 
 /**
@@ -692,3 +770,48 @@ TEST_F(Engraving_PlaybackModelTests, Playback_Setup_Data_MultiInstrument)
         }
     }
 }
+
+/**
+ * @brief PlaybackModelTests_Parallel_Rendering
+ * @details Every test score is loaded with the parts rendered on a single thread and in parallel.
+ *          The rendered events have to be exactly the same
+ */
+TEST_F(Engraving_PlaybackModelTests, Parallel_Rendering)
+{
+    // [GIVEN] All the test scores of the playback model
+    const std::vector<String> scoreNames = {
+        u"repeat_range", u"repeat_with_2_voltas", u"da_capo_al_fine", u"dal_segno_al_coda", u"dal_segno_al_fine",
+        u"da_capo_al_coda", u"pizz_to_arco", u"metronome_4_4", u"metronome_6_4_with_repeat", u"note_entry_playback_note",
+        u"note_entry_playback_chord", u"playback_setup_instruments"
+    };
+
+    EXPECT_CALL(*m_repositoryMock, defaultProfile(_)).WillRepeatedly(Return(m_defaultProfile));
+
+    for (const String& scoreName : scoreNames) {
+        Score* score = ScoreRW::readScore(PLAYBACK_MODEL_TEST_FILES_DIR + scoreName + u"/" + scoreName + u".mscx");
+        ASSERT_TRUE(score);
+
+        std::unordered_map<InstrumentTrackId, PlaybackEventsMap> sequentialEvents;
+
+        for (size_t threadCount : { 1, 0 }) {
+            // [WHEN] The playback model is loaded with the given amount of threads
+            PlaybackModel model;
+            model.setprofilesRepository(m_repositoryMock);
+            model.setMaxRenderThreadCount(threadCount);
+            model.load(score);
+
+            // [THEN] The parallel rendering produces the same events as the sequential one
+            for (const InstrumentTrackId& trackId : model.existingTrackIdSet()) {
+                const PlaybackEventsMap& events = model.resolveTrackPlaybackData(trackId).originEvents;
+
+                if (threadCount == 1) {
+                    sequentialEvents[trackId] = events;
+                } else {
+                    EXPECT_EQ(events, sequentialEvents[trackId]) << scoreName.toStdString();
+                }
+            }
+        }
+
+        delete score;
+    }
+}
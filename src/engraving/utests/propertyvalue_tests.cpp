@@ -0,0 +1,91 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "types/propertyvalue.h"
+
+using namespace mu;
+using namespace mu::engraving;
+
+class Engraving_PropertyValueTests : public ::testing::Test
+{
+};
+
+TEST_F(Engraving_PropertyValueTests, valueSemantics)
+{
+    PropertyValue undefined;
+    EXPECT_FALSE(undefined.isValid());
+    EXPECT_EQ(undefined.value<int>(), 0);
+    EXPECT_EQ(undefined, PropertyValue());
+
+    PropertyValue i(42);
+    EXPECT_EQ(i.type(), P_TYPE::INT);
+    EXPECT_EQ(i.toInt(), 42);
+    EXPECT_TRUE(i.toBool());
+
+    PropertyValue copy = i;
+    EXPECT_EQ(copy, i);
+    PropertyValue moved = std::move(copy);
+    EXPECT_EQ(moved.toInt(), 42);
+    moved = PropertyValue(7);
+    EXPECT_EQ(moved.toInt(), 7);
+    EXPECT_NE(moved, i);
+
+    // enum <-> int
+    PropertyValue dir = PropertyValue::fromValue(DirectionV::DOWN);
+    EXPECT_TRUE(dir.isEnum());
+    EXPECT_FALSE(i.isEnum());
+    EXPECT_EQ(dir.toInt(), static_cast<int>(DirectionV::DOWN));
+    EXPECT_EQ(PropertyValue(static_cast<int>(DirectionV::UP)).value<DirectionV>(), DirectionV::UP);
+    EXPECT_EQ(dir, PropertyValue(static_cast<int>(DirectionV::DOWN)));
+
+    // real <-> Spatium
+    PropertyValue sp(Spatium(1.5));
+    EXPECT_DOUBLE_EQ(sp.toReal(), 1.5);
+    EXPECT_DOUBLE_EQ(PropertyValue(2.5).value<Spatium>().val(), 2.5);
+    EXPECT_EQ(sp, PropertyValue(1.5));
+
+    // geometry, fraction, color, string
+    PropertyValue p(PointF(1.0, 2.0));
+    EXPECT_EQ(p.value<PointF>(), PointF(1.0, 2.0));
+    EXPECT_EQ(PropertyValue(Fraction(3, 4)).value<Fraction>(), Fraction(3, 4));
+    EXPECT_NE(PropertyValue(Fraction(3, 4)), PropertyValue(Fraction(6, 8)));
+    EXPECT_EQ(PropertyValue(Color(10, 20, 30)).value<Color>(), Color(10, 20, 30));
+    EXPECT_EQ(PropertyValue(Fraction(1, 4)).value<String>(), u"1/4");
+
+    PropertyValue s(String(u"text"));
+    PropertyValue s2 = s;
+    s = PropertyValue(String(u"other"));
+    EXPECT_EQ(s2.value<String>(), u"text");
+    EXPECT_EQ(s.value<String>(), u"other");
+
+    // heap fallback
+    std::vector<int> vec = { 1, 2, 3 };
+    PropertyValue v(vec);
+    PropertyValue v2 = v;
+    EXPECT_EQ(v2.value<std::vector<int> >(), vec);
+    EXPECT_EQ(v, v2);
+    v = PropertyValue(5);
+    EXPECT_EQ(v.toInt(), 5);
+    EXPECT_EQ(v2.value<std::vector<int> >(), vec);
+}
@@ -0,0 +1,115 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "libmscore/engravingitem.h"
+#include "libmscore/masterscore.h"
+#include "libmscore/measure.h"
+#include "libmscore/segment.h"
+#include "libmscore/shape.h"
+
+#include "utils/scorerw.h"
+
+using namespace mu;
+using namespace mu::engraving;
+
+static const String ALL_ELEMENTS_DATA_DIR("all_elements_data/");
+
+class Engraving_ShapeTests : public ::testing::Test
+{
+};
+
+//---------------------------------------------------------
+//   referenceMinHorizontalDistance
+//    straightforward implementation, computing padding and
+//    kerning type for every pair of rectangles
+//---------------------------------------------------------
+
+static double referenceMinHorizontalDistance(const Shape& s1, const Shape& s2, Score* score)
+{
+    double dist = -1000000.0;
+    double verticalClearance = 0.2 * score->spatium();
+    for (const ShapeElement& r2 : s2) {
+        const EngravingItem* item2 = r2.toItem;
+        for (const ShapeElement& r1 : s1) {
+            const EngravingItem* item1 = r1.toItem;
+            bool intersection = mu::engraving::intersects(r1.top(), r1.bottom(), r2.top(), r2.bottom(), verticalClearance);
+            double padding = 0;
+            KerningType kerningType = KerningType::NON_KERNING;
+            if (item1 && item2) {
+                padding = item1->computePadding(item2);
+                kerningType = item1->computeKerningType(item2);
+            }
+            if (intersection
+                || (r1.width() == 0 || r2.width() == 0)
+                || (!item1 && item2 && item2->isLyrics())
+                || kerningType == KerningType::NON_KERNING) {
+                dist = std::max(dist, r1.right() - r2.left() + padding);
+            }
+            if (kerningType == KerningType::KERNING_UNTIL_ORIGIN) {
+                dist = std::max(dist, r1.left() - r2.left());
+            }
+        }
+    }
+    return dist;
+}
+
+//---------------------------------------------------------
+//   segmentShapePairs
+//    shapes of all adjacent segments of every staff
+//---------------------------------------------------------
+
+static std::vector<std::pair<const Shape*, const Shape*> > segmentShapePairs(Score* score)
+{
+    std::vector<std::pair<const Shape*, const Shape*> > pairs;
+    for (Measure* m = score->firstMeasure(); m; m = m->nextMeasure()) {
+        for (Segment* s = m->first(); s && s->next(); s = s->next()) {
+            for (staff_idx_t staffIdx = 0; staffIdx < score->nstaves(); ++staffIdx) {
+                pairs.push_back({ &s->staffShape(staffIdx), &s->next()->staffShape(staffIdx) });
+            }
+        }
+    }
+    return pairs;
+}
+
+//---------------------------------------------------------
+//   minHorizontalDistance
+//    results must be identical to the reference implementation
+//---------------------------------------------------------
+
+TEST_F(Engraving_ShapeTests, minHorizontalDistance)
+{
+    for (const String& file : { String(u"layout_elements.mscx"), String(u"moonlight.mscx") }) {
+        MasterScore* score = ScoreRW::readScore(ALL_ELEMENTS_DATA_DIR + file);
+        EXPECT_TRUE(score);
+
+        auto pairs = segmentShapePairs(score);
+        EXPECT_FALSE(pairs.empty());
+
+        for (const auto& p : pairs) {
+            EXPECT_EQ(p.first->minHorizontalDistance(*p.second, score), referenceMinHorizontalDistance(*p.first, *p.second, score));
+        }
+
+        delete score;
+    }
+}
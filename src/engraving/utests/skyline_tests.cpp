@@ -0,0 +1,214 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "libmscore/masterscore.h"
+#include "libmscore/measure.h"
+#include "libmscore/segment.h"
+#include "libmscore/shape.h"
+#include "libmscore/skyline.h"
+
+#include "utils/scorerw.h"
+
+using namespace mu;
+using namespace mu::engraving;
+
+static const String ALL_ELEMENTS_DATA_DIR("all_elements_data/");
+
+class Engraving_SkylineTests : public ::testing::Test
+{
+};
+
+//---------------------------------------------------------
+//   staffRects
+//    rectangles of all segment shapes of a staff, in the
+//    order layout adds them to the skyline. Zero-width
+//    rectangles are left out, see zeroWidth
+//---------------------------------------------------------
+
+static std::vector<RectF> staffRects(Score* score, staff_idx_t staffIdx)
+{
+    std::vector<RectF> rects;
+    for (Measure* m = score->firstMeasure(); m; m = m->nextMeasure()) {
+        for (Segment* s = m->first(); s; s = s->next()) {
+            for (const ShapeElement& r : s->staffShape(staffIdx).translated(s->pos() + m->pos())) {
+                if (r.width() > 0) {
+                    rects.push_back(r);
+                }
+            }
+        }
+    }
+    return rects;
+}
+
+//---------------------------------------------------------
+//   referenceMinDistance
+//    brute force over all pairs of rectangles
+//---------------------------------------------------------
+
+static double referenceMinDistance(const std::vector<RectF>& above, const std::vector<RectF>& below)
+{
+    double dist = -1000000.0;
+    for (const RectF& r1 : above) {
+        for (const RectF& r2 : below) {
+            double x1 = std::max(0.0, r1.x());
+            double x2 = std::max(0.0, r2.x());
+            if (r1.width() <= 0 || r2.width() <= 0 || r1.right() <= x2 || r2.right() <= x1) {
+                continue;
+            }
+            dist = std::max(dist, r1.bottom() - r2.top());
+        }
+    }
+    return dist;
+}
+
+TEST_F(Engraving_SkylineTests, minDistance)
+{
+    MasterScore* score = ScoreRW::readScore(ALL_ELEMENTS_DATA_DIR + u"moonlight.mscx");
+    EXPECT_TRUE(score);
+    ASSERT_TRUE(score->nstaves() > 1);
+
+    std::vector<RectF> above = staffRects(score, 0);
+    std::vector<RectF> below = staffRects(score, 1);
+    // move the lower staff up so that the skylines interlock
+    for (RectF& r : below) {
+        r.translate(0.0, -score->spatium() * 4);
+    }
+
+    SkylineLine south(false);
+    SkylineLine north(true);
+    for (const RectF& r : above) {
+        south.add(r);
+    }
+    for (const RectF& r : below) {
+        north.add(r);
+    }
+
+    EXPECT_EQ(south.minDistance(north), referenceMinDistance(above, below));
+
+    // segments are contiguous and neighbouring segments differ in height
+    for (const SkylineLine* line : { &south, &north }) {
+        const SkylineSegment* prev = nullptr;
+        for (const SkylineSegment& s : *line) {
+            EXPECT_GT(s.w, 0.0);
+            if (prev) {
+                EXPECT_DOUBLE_EQ(prev->x + prev->w, s.x);
+                EXPECT_NE(prev->y, s.y);
+            }
+            prev = &s;
+        }
+    }
+
+    delete score;
+}
+
+TEST_F(Engraving_SkylineTests, minDistanceBySegment)
+{
+    //! CASE Like the layout does, the shape of each segment is compared with the skyline
+    //! of the segments before it, and then added to it, so merges and queries alternate
+
+    MasterScore* score = ScoreRW::readScore(ALL_ELEMENTS_DATA_DIR + u"moonlight.mscx");
+    EXPECT_TRUE(score);
+
+    SkylineLine south(false);
+    std::vector<RectF> added;
+    for (Measure* m = score->firstMeasure(); m; m = m->nextMeasure()) {
+        for (Segment* s = m->first(); s; s = s->next()) {
+            Shape shape = s->staffShape(0).translated(s->pos() + m->pos());
+            // move the shape up so that it interlocks with the segments before it
+            std::vector<RectF> rects;
+            SkylineLine north(true);
+            for (const ShapeElement& r : shape) {
+                if (r.width() <= 0) {
+                    continue;
+                }
+                rects.push_back(r.translated(PointF(0.0, -score->spatium() * 2)));
+                north.add(rects.back());
+            }
+
+            if (!added.empty() && !rects.empty()) {
+                EXPECT_EQ(south.minDistance(north), referenceMinDistance(added, rects));
+            }
+
+            for (const ShapeElement& r : shape) {
+                if (r.width() <= 0) {
+                    continue;
+                }
+                south.add(r);
+                added.push_back(r);
+            }
+        }
+    }
+
+    delete score;
+}
+
+TEST_F(Engraving_SkylineTests, addAfterRead)
+{
+    SkylineLine north(true);
+    north.add(0.0, 10.0, 10.0);
+    north.add(5.0, 5.0, 10.0);
+    EXPECT_EQ(north.max(), 5.0);
+
+    // adding after the line was merged keeps the previous segments
+    north.add(20.0, 2.0, 5.0);
+    north.add(12.0, 5.0, 3.0);
+
+    std::vector<std::pair<double, double> > segments;
+    for (const SkylineSegment& s : north) {
+        segments.push_back({ s.x, s.y });
+    }
+    std::vector<std::pair<double, double> > expected = { { 0.0, 10.0 }, { 5.0, 5.0 }, { 15.0, 1000000.0 }, { 20.0, 2.0 } };
+    EXPECT_EQ(segments, expected);
+    EXPECT_EQ(north.max(), 2.0);
+}
+
+TEST_F(Engraving_SkylineTests, zeroWidth)
+{
+    //! GIVEN A line with a zero-width rectangle higher than the segment it falls in, and one lower
+    SkylineLine north(true);
+    north.add(0.0, 10.0, 10.0);
+    north.add(4.0, 2.0, 0.0);
+    north.add(6.0, 12.0, 0.0);
+
+    //! CHECK Only the higher one is kept
+    EXPECT_EQ(north.max(), 2.0);
+
+    //! CHECK It collides with a segment it is strictly inside
+    SkylineLine south(false);
+    south.add(0.0, 0.0, 10.0);
+    EXPECT_EQ(south.minDistance(north), -2.0);
+
+    //! CHECK It doesn't collide with segments it only touches
+    SkylineLine split(false);
+    split.add(0.0, 0.0, 4.0);
+    split.add(4.0, 1.0, 6.0);
+    EXPECT_EQ(split.minDistance(north), -9.0);
+
+    //! DO Add after the line was merged
+    north.add(20.0, 5.0, 5.0);
+
+    //! CHECK The zero-width segment is kept
+    EXPECT_EQ(north.max(), 2.0);
+    EXPECT_EQ(south.minDistance(north), -2.0);
+}
@@ -0,0 +1,97 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "libmscore/masterscore.h"
+#include "style/style.h"
+
+#include "utils/scorerw.h"
+
+using namespace mu;
+using namespace mu::engraving;
+
+static const String ALL_ELEMENTS_DATA_DIR("all_elements_data/");
+
+class Engraving_StyleTests : public ::testing::Test
+{
+};
+
+//---------------------------------------------------------
+//   checkPrecomputedValues
+//    the typed accessors must return the same as reading
+//    the PropertyValue
+//---------------------------------------------------------
+
+static void checkPrecomputedValues(const MStyle& style)
+{
+    const double spatium = style.value(Sid::spatium).toReal();
+    for (int i = 0; i < int(Sid::STYLES); ++i) {
+        Sid sid = static_cast<Sid>(i);
+        const PropertyValue& v = style.value(sid);
+        switch (MStyle::valueType(sid)) {
+        case P_TYPE::SPATIUM:
+            EXPECT_DOUBLE_EQ(style.styleS(sid).val(), v.value<Spatium>().val()) << MStyle::valueName(sid);
+            EXPECT_DOUBLE_EQ(style.styleMM(sid).val(), v.value<Spatium>().val() * spatium) << MStyle::valueName(sid);
+            break;
+        case P_TYPE::REAL:
+            EXPECT_DOUBLE_EQ(style.styleD(sid), v.toReal()) << MStyle::valueName(sid);
+            break;
+        case P_TYPE::BOOL:
+            EXPECT_EQ(style.styleB(sid), v.toBool()) << MStyle::valueName(sid);
+            EXPECT_EQ(style.styleI(sid), v.toInt()) << MStyle::valueName(sid);
+            break;
+        case P_TYPE::INT:
+            EXPECT_EQ(style.styleI(sid), v.toInt()) << MStyle::valueName(sid);
+            break;
+        default:
+            if (v.isEnum()) {
+                EXPECT_EQ(style.styleI(sid), v.toInt()) << MStyle::valueName(sid);
+            }
+            break;
+        }
+    }
+}
+
+TEST_F(Engraving_StyleTests, precomputedValues)
+{
+    MStyle style;
+    checkPrecomputedValues(style);
+
+    MasterScore* score = ScoreRW::readScore(ALL_ELEMENTS_DATA_DIR + u"moonlight.mscx");
+    ASSERT_TRUE(score);
+    checkPrecomputedValues(score->style());
+
+    MStyle& s = score->style();
+    s.set(Sid::spatium, 2.0 * s.value(Sid::spatium).toReal());
+    s.set(Sid::staffDistance, Spatium(9.5));
+    s.set(Sid::createMultiMeasureRests, !s.styleB(Sid::createMultiMeasureRests));
+    s.set(Sid::minMMRestWidth, Spatium(3.0));
+    checkPrecomputedValues(s);
+    EXPECT_DOUBLE_EQ(s.styleS(Sid::staffDistance).val(), 9.5);
+    EXPECT_DOUBLE_EQ(s.styleMM(Sid::staffDistance).val(), 9.5 * s.value(Sid::spatium).toReal());
+
+    MStyle copy = s;
+    checkPrecomputedValues(copy);
+
+    delete score;
+}
@@ -23,8 +23,8 @@
 #ifndef MU_AUDIO_ABSTRACTEVENTSEQUENCER_H
 #define MU_AUDIO_ABSTRACTEVENTSEQUENCER_H
 
-#include <map>
-#include <set>
+#include <algorithm>
+#include <vector>
 
 #include "async/asyncable.h"
 #include "async/channel.h"
@@ -39,11 +39,125 @@ class AbstractEventSequencer : public async::Asyncable
 {
 public:
     using EventType = std::variant<Types...>;
-    using EventSequence = std::set<EventType>;
-    using EventSequenceMap = std::map<msecs_t, EventSequence>;
 
-    typedef typename EventSequenceMap::const_iterator SequenceIterator;
-    typedef typename EventSequence::const_iterator EventIterator;
+    struct TimedEvent {
+        msecs_t timestamp = 0;
+        EventType event;
+    };
+
+    //! NOTE Event to be played at the given frame of the rendered block
+    struct BlockEvent {
+        samples_t frameOffset = 0;
+        EventType event;
+    };
+
+    using EventSequence = std::vector<BlockEvent>;
+
+    //! NOTE Events sorted by timestamp, the events sharing a timestamp are stored next to each other
+    //!      and ordered the same way std::set<EventType> would order them
+    class EventTimeline
+    {
+    public:
+        void add(const msecs_t timestamp, EventType&& event)
+        {
+            m_events.push_back({ timestamp, std::move(event) });
+        }
+
+        //! NOTE Keeps the capacity, so that the next update could be built without reallocation
+        void clear()
+        {
+            m_events.clear();
+            m_maxEventsPerTimestamp = 0;
+        }
+
+        void sort()
+        {
+            std::less<EventType> eventLess;
+
+            auto less = [&eventLess](const TimedEvent& first, const TimedEvent& second) {
+                if (first.timestamp != second.timestamp) {
+                    return first.timestamp < second.timestamp;
+                }
+
+                return eventLess(first.event, second.event);
+            };
+
+            auto equal = [&eventLess](const TimedEvent& first, const TimedEvent& second) {
+                return first.timestamp == second.timestamp
+                       && !eventLess(first.event, second.event)
+                       && !eventLess(second.event, first.event);
+            };
+
+            std::sort(m_events.begin(), m_events.end(), less);
+            m_events.erase(std::unique(m_events.begin(), m_events.end(), equal), m_events.end());
+
+            m_maxEventsPerTimestamp = 0;
+
+            for (size_t idx = 0; idx < m_events.size(); idx = groupEnd(idx)) {
+                m_maxEventsPerTimestamp = std::max(m_maxEventsPerTimestamp, groupEnd(idx) - idx);
+            }
+        }
+
+        void swap(EventTimeline& other)
+        {
+            m_events.swap(other.m_events);
+            std::swap(m_maxEventsPerTimestamp, other.m_maxEventsPerTimestamp);
+        }
+
+        bool empty() const
+        {
+            return m_events.empty();
+        }
+
+        size_t size() const
+        {
+            return m_events.size();
+        }
+
+        const TimedEvent& at(const size_t idx) const
+        {
+            return m_events[idx];
+        }
+
+        size_t lowerBound(const msecs_t timestamp) const
+        {
+            auto it = std::lower_bound(m_events.cbegin(), m_events.cend(), timestamp,
+                                       [](const TimedEvent& event, const msecs_t value) {
+                return event.timestamp < value;
+            });
+
+            return std::distance(m_events.cbegin(), it);
+        }
+
+        //! NOTE Index of the first event after the group of events sharing the timestamp at idx
+        size_t groupEnd(const size_t idx) const
+        {
+            size_t end = idx + 1;
+
+            while (end < m_events.size() && m_events[end].timestamp == m_events[idx].timestamp) {
+                ++end;
+            }
+
+            return end;
+        }
+
+        size_t maxEventsPerTimestamp() const
+        {
+            return m_maxEventsPerTimestamp;
+        }
+
+    private:
+        std::vector<TimedEvent> m_events;
+        size_t m_maxEventsPerTimestamp = 0;
+    };
+
+    //! NOTE The timeline being played and the storage the next update is built in.
+    //!      Both are reused, so that steady-state updates don't allocate either
+    struct EventStream {
+        EventTimeline events;
+        EventTimeline pending;
+        size_t cursor = 0;
+    };
 
     virtual ~AbstractEventSequencer()
     {
@@ -64,15 +178,17 @@ public:
             updateOffStreamEvents(changes);
         });
 
-        m_mainStreamChanges.onReceive(this, [this](const mpe::PlaybackEventsMap& changes) {
-            updateMainStreamEvents(changes);
+        m_mainStreamChanges.onReceive(this, [this](const mpe::PlaybackEventsDelta& delta) {
+            delta.applyTo(m_originEvents);
+            updateMainStreamEvents(m_originEvents);
         });
 
         m_dynamicLevelChanges.onReceive(this, [this](const mpe::DynamicLevelMap& changes) {
             updateDynamicChanges(changes);
         });
 
-        updateMainStreamEvents(data.originEvents);
+        m_originEvents = data.originEvents;
+        updateMainStreamEvents(m_originEvents);
         updateDynamicChanges(data.dynamicLevelMap);
     }
 
@@ -90,12 +206,19 @@ public:
         return m_isActive;
     }
 
+    void setSampleRate(const sample_rate_t sampleRate)
+    {
+        m_sampleRate = sampleRate;
+        m_playbackSample = msecsToSamples(m_playbackPosition, m_sampleRate);
+    }
+
     void setPlaybackPosition(const msecs_t newPlaybackPosition)
     {
         ONLY_AUDIO_WORKER_THREAD;
 
         m_playbackPosition = newPlaybackPosition;
-        resetAllIterators();
+        m_playbackSample = msecsToSamples(m_playbackPosition, m_sampleRate);
+        resetAllCursors();
     }
 
     msecs_t playbackPosition() const
@@ -105,103 +228,161 @@ public:
         return m_playbackPosition;
     }
 
-    const EventSequence& eventsToBePlayed(const msecs_t nextMsecs)
+    //! NOTE Called for every rendered block, so it neither allocates nor frees memory:
+    //!      the events are copied into storage reserved when the timelines were updated.
+    //!      The playback position is counted in samples, each event gets the frame it starts at
+    const EventSequence& eventsToBePlayed(const samples_t samplesPerChannel)
     {
-        ONLY_AUDIO_WORKER_THREAD;
-
-        static EventSequence result;
+        ONLY_AUDIO_WORKER_OR_RENDER_THREAD;
 
-        result.clear();
+        m_result.clear();
 
         if (!m_isActive) {
-            handleOffStream(result);
-            return result;
+            handleOffStream();
+            return m_result;
         }
 
-        if (m_currentMainSequenceIt == m_mainStreamEvents.cend()) {
-            return result;
+        if (m_mainStream.cursor >= m_mainStream.events.size()) {
+            return m_result;
         }
 
-        m_playbackPosition += nextMsecs;
+        samples_t blockStart = m_playbackSample;
 
-        handleMainStream(result);
-        handleDynamicChanges(result);
+        m_playbackSample += samplesPerChannel;
+        m_playbackPosition = samplesToMsecs(m_playbackSample, m_sampleRate);
 
-        return result;
+        handleStreams(blockStart, m_playbackSample);
+
+        return m_result;
     }
 
 protected:
-    void resetAllIterators()
+    EventTimeline& beginUpdate(EventStream& stream)
     {
-        updateMainSequenceIterator();
-        updateOffSequenceIterator();
-        updateDynamicChangesIterator();
+        stream.pending.clear();
+        return stream.pending;
     }
 
-    void updateMainSequenceIterator()
+    //! NOTE Updates are delivered through the worker event loop between the rendered blocks,
+    //!      so the fully built timeline replaces the played one at once
+    void commitUpdate(EventStream& stream)
     {
-        m_currentMainSequenceIt = m_mainStreamEvents.lower_bound(m_playbackPosition);
+        stream.pending.sort();
+        stream.events.swap(stream.pending);
+        stream.cursor = firstNotPlayedEvent(stream.events);
+
+        reserveResult();
     }
 
-    void updateOffSequenceIterator()
+    void resetAllCursors()
     {
-        m_currentOffSequenceIt = m_offStreamEvents.lower_bound(m_playbackPosition);
+        m_mainStream.cursor = firstNotPlayedEvent(m_mainStream.events);
+        m_offStream.cursor = firstNotPlayedEvent(m_offStream.events);
+        m_dynamicStream.cursor = firstNotPlayedEvent(m_dynamicStream.events);
     }
 
-    void updateDynamicChangesIterator()
+    samples_t eventFrame(const TimedEvent& event) const
     {
-        m_currentDynamicsIt = m_dynamicEvents.lower_bound(m_playbackPosition);
+        return msecsToSamples(event.timestamp, m_sampleRate);
     }
 
-    void handleOffStream(EventSequence& result)
+    size_t firstNotPlayedEvent(const EventTimeline& timeline) const
     {
-        if (m_offStreamEvents.empty()) {
-            return;
-        }
+        size_t idx = timeline.lowerBound(m_playbackPosition);
 
-        if (m_currentOffSequenceIt != m_offStreamEvents.cend()) {
-            result = m_currentOffSequenceIt->second;
-            m_currentOffSequenceIt = m_offStreamEvents.erase(m_currentOffSequenceIt);
+        //! NOTE The position is rounded down to msecs, the events of that msec might be already played
+        while (idx < timeline.size() && eventFrame(timeline.at(idx)) < m_playbackSample) {
+            ++idx;
         }
+
+        return idx;
     }
 
-    void handleMainStream(EventSequence& result)
+    void reserveResult()
     {
-        if (m_currentMainSequenceIt->first <= m_playbackPosition) {
-            result.insert(m_currentMainSequenceIt->second.cbegin(),
-                          m_currentMainSequenceIt->second.cend());
+        //! NOTE Enough room for several timestamps of every stream, a block rarely spans more
+        static constexpr size_t TIMESTAMPS_PER_BLOCK = 4;
 
-            m_currentMainSequenceIt = std::next(m_currentMainSequenceIt);
-        }
+        size_t capacity = std::max(m_mainStream.events.maxEventsPerTimestamp() + m_dynamicStream.events.maxEventsPerTimestamp(),
+                                   m_offStream.events.maxEventsPerTimestamp());
+
+        m_result.reserve(capacity * TIMESTAMPS_PER_BLOCK);
     }
 
-    void handleDynamicChanges(EventSequence& result)
+    void handleOffStream()
     {
-        if (m_dynamicEvents.empty() || m_currentDynamicsIt == m_dynamicEvents.cend()) {
+        if (m_offStream.cursor >= m_offStream.events.size()) {
             return;
         }
 
-        if (m_currentDynamicsIt->first <= m_playbackPosition) {
-            result.insert(m_currentDynamicsIt->second.cbegin(),
-                          m_currentDynamicsIt->second.cend());
+        size_t end = m_offStream.events.groupEnd(m_offStream.cursor);
 
-            m_currentDynamicsIt = std::next(m_currentDynamicsIt);
+        for (size_t idx = m_offStream.cursor; idx < end; ++idx) {
+            m_result.push_back({ 0, m_offStream.events.at(idx).event });
         }
+
+        m_offStream.cursor = end;
     }
 
-    mutable msecs_t m_playbackPosition = 0;
+    //! NOTE Merges the main stream and the dynamics, so that the result is ordered by frames
+    void handleStreams(const samples_t blockStart, const samples_t blockEnd)
+    {
+        while (true) {
+            EventStream* stream = nullptr;
+
+            for (EventStream* candidate : { &m_mainStream, &m_dynamicStream }) {
+                if (candidate->cursor >= candidate->events.size()) {
+                    continue;
+                }
+
+                if (!stream || candidate->events.at(candidate->cursor).timestamp < stream->events.at(stream->cursor).timestamp) {
+                    stream = candidate;
+                }
+            }
+
+            if (!stream) {
+                return;
+            }
+
+            samples_t frame = eventFrame(stream->events.at(stream->cursor));
+
+            if (frame >= blockEnd) {
+                return;
+            }
+
+            size_t end = stream->events.groupEnd(stream->cursor);
+
+            //! NOTE The rest waits for the next block rather than reallocating the result here
+            if (m_result.size() + (end - stream->cursor) > m_result.capacity()) {
+                return;
+            }
 
-    SequenceIterator m_currentMainSequenceIt;
-    SequenceIterator m_currentOffSequenceIt;
-    SequenceIterator m_currentDynamicsIt;
+            samples_t frameOffset = frame > blockStart ? frame - blockStart : 0;
 
-    EventSequenceMap m_mainStreamEvents;
-    EventSequenceMap m_offStreamEvents;
-    EventSequenceMap m_dynamicEvents;
+            for (size_t idx = stream->cursor; idx < end; ++idx) {
+                m_result.push_back({ frameOffset, stream->events.at(idx).event });
+            }
+
+            stream->cursor = end;
+        }
+    }
+
+    msecs_t m_playbackPosition = 0;
+    samples_t m_playbackSample = 0;
+    sample_rate_t m_sampleRate = 0;
+
+    EventStream m_mainStream;
+    EventStream m_offStream;
+    EventStream m_dynamicStream;
+
+    EventSequence m_result;
 
     bool m_isActive = false;
 
-    mpe::PlaybackEventsChanges m_mainStreamChanges;
+    //! NOTE The whole main stream, kept up to date by the deltas coming from the playback model
+    mpe::PlaybackEventsMap m_originEvents;
+
+    mpe::PlaybackEventsDeltaChanges m_mainStreamChanges;
     mpe::PlaybackEventsChanges m_offStreamChanges;
     mpe::DynamicLevelChanges m_dynamicLevelChanges;
 };
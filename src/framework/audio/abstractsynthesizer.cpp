@@ -22,6 +22,8 @@
 
 #include "abstractsynthesizer.h"
 
+#include "log.h"
+
 #include "internal/audiosanitizer.h"
 
 using namespace mu;
@@ -70,15 +72,17 @@ void AbstractSynthesizer::setupEvents(const mpe::PlaybackData& playbackData)
 {
     ONLY_AUDIO_WORKER_THREAD;
 
-    loadMainStreamEvents(playbackData.originEvents);
+    m_originEvents = playbackData.originEvents;
+    loadMainStreamEvents(m_originEvents);
     m_mainStreamChanges = playbackData.mainStream;
     m_offStreamChanges = playbackData.offStream;
 
     loadDynamicLevelChanges(playbackData.dynamicLevelMap);
     m_dynamicLevelChanges = playbackData.dynamicLevelChanges;
 
-    m_mainStreamChanges.onReceive(this, [this](const PlaybackEventsMap& updatedEvents) {
-        loadMainStreamEvents(updatedEvents);
+    m_mainStreamChanges.onReceive(this, [this](const PlaybackEventsDelta& delta) {
+        delta.applyTo(m_originEvents);
+        loadMainStreamEvents(m_originEvents);
     });
 
     m_offStreamChanges.onReceive(this, [this](const PlaybackEventsMap& triggeredEvents) {
@@ -114,7 +118,7 @@ void AbstractSynthesizer::revokePlayingNotes()
 
 bool AbstractSynthesizer::isActive() const
 {
-    ONLY_AUDIO_WORKER_THREAD;
+    ONLY_AUDIO_WORKER_OR_RENDER_THREAD;
 
     return m_isActive;
 }
@@ -126,11 +130,18 @@ void AbstractSynthesizer::setIsActive(bool arg)
     m_isActive = arg;
 }
 
-audio::msecs_t AbstractSynthesizer::samplesToMsecs(const samples_t samplesPerChannel, const samples_t sampleRate) const
+void AbstractSynthesizer::forwardPlaybackPosition(const samples_t samplesPerChannel)
 {
-    ONLY_AUDIO_WORKER_THREAD;
+    ONLY_AUDIO_WORKER_OR_RENDER_THREAD;
+
+    IF_ASSERT_FAILED(m_sampleRate > 0) {
+        return;
+    }
+
+    samples_t elapsed = m_playbackPositionRemainder + samplesPerChannel * 1000;
 
-    return samplesPerChannel * 1000 / sampleRate;
+    m_playbackPosition += static_cast<msecs_t>(elapsed / m_sampleRate);
+    m_playbackPositionRemainder = elapsed % m_sampleRate;
 }
 
 msecs_t AbstractSynthesizer::actualPlaybackPositionStart() const
@@ -152,4 +163,5 @@ void AbstractSynthesizer::setPlaybackPosition(const msecs_t newPosition)
     ONLY_AUDIO_WORKER_THREAD;
 
     m_playbackPosition = newPosition;
+    m_playbackPositionRemainder = 0;
 }
@@ -158,17 +158,23 @@ protected:
     virtual void loadOffStreamEvents(const mpe::PlaybackEventsMap& updatedEvents);
     virtual void loadDynamicLevelChanges(const mpe::DynamicLevelMap& updatedDynamicLevelMap);
 
-    msecs_t samplesToMsecs(const samples_t samplesPerChannel, const samples_t sampleRate) const;
+    void forwardPlaybackPosition(const samples_t samplesPerChannel);
     msecs_t actualPlaybackPositionStart() const;
 
     msecs_t m_playbackPosition = 0;
 
+    //! NOTE Part of the rendered samples which doesn't make a whole msec yet, in 1/1000 of a sample
+    samples_t m_playbackPositionRemainder = 0;
+
     mpe::PlaybackSetupData m_setupData;
     mpe::DynamicLevelMap m_dynamicLevelMap;
+
+    //! NOTE The whole main stream, kept up to date by the deltas coming from the playback model
+    mpe::PlaybackEventsMap m_originEvents;
     EventsBuffer m_mainStreamEvents;
     EventsBuffer m_offStreamEvents;
 
-    mpe::PlaybackEventsChanges m_mainStreamChanges;
+    mpe::PlaybackEventsDeltaChanges m_mainStreamChanges;
     mpe::PlaybackEventsChanges m_offStreamChanges;
     async::Channel<mpe::DynamicLevelMap> m_dynamicLevelChanges;
 
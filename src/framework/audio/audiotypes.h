@@ -45,6 +45,19 @@ using volume_dbfs_t = float;
 using gain_t = float;
 using balance_t = float;
 
+//! NOTE The audio time is counted in samples, msecs are derived from it.
+//!      Msecs are converted to the first sample not earlier than them,
+//!      so that a round trip gives the same msecs back
+inline msecs_t samplesToMsecs(const samples_t samples, const sample_rate_t sampleRate)
+{
+    return sampleRate > 0 ? static_cast<msecs_t>(samples * 1000 / sampleRate) : 0;
+}
+
+inline samples_t msecsToSamples(const msecs_t msecs, const sample_rate_t sampleRate)
+{
+    return msecs > 0 ? (static_cast<samples_t>(msecs) * sampleRate + 999) / 1000 : 0;
+}
+
 using TrackSequenceId = int32_t;
 using TrackSequenceIdList = std::vector<TrackSequenceId>;
 
@@ -0,0 +1,162 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+#include "audio/internal/worker/samplerateconvertor.h"
+
+#include "log.h"
+
+using namespace mu;
+using namespace mu::audio;
+
+class Audio_SampleRateConvertorBenchmarks : public ::testing::Test
+{
+};
+
+//! NOTE The FIR method of the previous implementation, kept for the comparison
+static std::vector<float> legacyFirConvert(const std::vector<float>& data, unsigned int channelsCount, unsigned int sampleRateIn,
+                                           unsigned int sampleRateOut)
+{
+    const int FIR_LENGTH = 33;
+
+    auto zeroBessel = [](double x) {
+        double s = 1, y = 1;
+        int m = 1;
+
+        while (y > std::numeric_limits<float>::min()) {
+            m += 2;
+            y *= x * x / (4 * m * m);
+            s += s * y;
+        }
+
+        return s;
+    };
+
+    int max = std::max(sampleRateIn, sampleRateOut), min = std::min(sampleRateIn, sampleRateOut);
+    int maxCommonDivider = 1;
+    while (max % min != 0) {
+        maxCommonDivider = max % min;
+        max = min;
+        min = maxCommonDivider;
+    }
+    unsigned int M = sampleRateIn / maxCommonDivider;
+    unsigned int L = sampleRateOut / maxCommonDivider;
+    double fStop = std::min(sampleRateIn, sampleRateOut) / 2, fIntermediateSampleRate = sampleRateIn * M, attenuation = 96;
+    int Np = (FIR_LENGTH - 1) / 2;
+    double alpha = 0.1102 * (attenuation - 8.7);
+    double A[FIR_LENGTH];
+    std::vector<float> fir(FIR_LENGTH, 0.f);
+
+    A[0] = 2 * fStop / fIntermediateSampleRate;
+    for (int j = 1; j <= Np; j++) {
+        A[j] = std::sin(2 * j * M_PI * fStop / fIntermediateSampleRate) / j * M_PI;
+    }
+    for (int j = 0; j <= Np; j++) {
+        fir[Np + j] = A[j] * zeroBessel(alpha * std::sqrt(1 - (j * j / (Np * Np)))) / zeroBessel(alpha);
+    }
+    for (int j = 0; j < Np; j++) {
+        fir[j] = fir[FIR_LENGTH - 1 - j];
+    }
+
+    size_t resultSamples = data.size() * sampleRateOut / (channelsCount * sampleRateIn);
+    std::vector<float> out(resultSamples * channelsCount);
+
+    for (size_t sample = 0; sample < resultSamples; ++sample) {
+        for (unsigned int channel = 0; channel < channelsCount; ++channel) {
+            float y = 0.f;
+            for (int i = 0; i < FIR_LENGTH; ++i) {
+                int pos = (static_cast<int>(sample) - i) * static_cast<int>(M) / static_cast<int>(L) * channelsCount + channel;
+                if (pos >= 0 && pos < static_cast<int>(data.size())) {
+                    y += data[pos] * fir[i];
+                }
+            }
+            out[sample * channelsCount + channel] = y;
+        }
+    }
+
+    return out;
+}
+
+static std::vector<float> stereoSine(double frequency, unsigned int sampleRate, size_t frames)
+{
+    std::vector<float> data(frames * 2);
+    for (size_t i = 0; i < frames; ++i) {
+        double value = 0.5 * std::sin(2 * M_PI * frequency * i / sampleRate);
+        data[i * 2] = static_cast<float>(value);
+        data[i * 2 + 1] = static_cast<float>(-value);
+    }
+
+    return data;
+}
+
+//! THD+N of the left channel against the ideal sine, in dB, skipping the filter transients at the edges
+static double thdPlusNoise(const std::vector<float>& output, double frequency, unsigned int sampleRate)
+{
+    const size_t frames = output.size() / 2;
+    const size_t margin = sampleRate / 10;
+
+    double signal = 0.0;
+    double noise = 0.0;
+
+    for (size_t i = margin; i + margin < frames; ++i) {
+        double expected = 0.5 * std::sin(2 * M_PI * frequency * i / sampleRate);
+        double error = output[i * 2] - expected;
+
+        signal += expected * expected;
+        noise += error * error;
+    }
+
+    return 10 * std::log10(noise / signal);
+}
+
+TEST_F(Audio_SampleRateConvertorBenchmarks, Throughput)
+{
+    const double frequency = 1000.0;
+    const std::pair<unsigned int, unsigned int> ratePairs[] = {
+        { 44100, 48000 }, { 48000, 44100 }, { 48000, 96000 }, { 44100, 96000 }, { 96000, 48000 }, { 44100, 47999 }
+    };
+
+    for (const auto& rates : ratePairs) {
+        //! GIVEN Two seconds of a 1 kHz sine
+        std::vector<float> input = stereoSine(frequency, rates.first, rates.first * 2);
+        double inputSeconds = 2.0;
+
+        //! WHEN Converting it with the polyphase convertor and with the previous implementation
+        auto start = std::chrono::steady_clock::now();
+        SampleRateConvertor convertor(input, 2, rates.first, rates.second);
+        std::vector<float> output = convertor.convert();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        start = std::chrono::steady_clock::now();
+        std::vector<float> legacyOutput = legacyFirConvert(input, 2, rates.first, rates.second);
+        double legacySeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        LOGI() << rates.first << " -> " << rates.second
+               << ": THD+N " << thdPlusNoise(output, frequency, rates.second) << " dB, " << inputSeconds / seconds << "x real time"
+               << " (previous: THD+N " << thdPlusNoise(legacyOutput, frequency, rates.second) << " dB, "
+               << inputSeconds / legacySeconds << "x real time)";
+    }
+}
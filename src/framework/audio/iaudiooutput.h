@@ -27,6 +27,7 @@
 
 #include "async/promise.h"
 #include "async/channel.h"
+#include "global/progress.h"
 
 #include "audiotypes.h"
 
@@ -51,6 +52,12 @@ public:
 
     virtual async::Promise<bool> saveSoundTrack(const TrackSequenceId sequenceId, const io::path_t& destination,
                                                 const SoundTrackFormat& format) = 0;
+    //! NOTE Saves the mix into the destination and each track of the sequence into its own file next to it
+    virtual async::Promise<bool> saveSoundTrackStems(const TrackSequenceId sequenceId, const io::path_t& destination,
+                                                     const SoundTrackFormat& format) = 0;
+    virtual void abortSavingAllSoundTracks() = 0;
+
+    virtual framework::Progress saveSoundTrackProgress(const TrackSequenceId sequenceId) = 0;
 };
 
 using IAudioOutputPtr = std::shared_ptr<IAudioOutput>;
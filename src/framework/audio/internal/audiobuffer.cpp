@@ -21,6 +21,7 @@
  */
 #include "audiobuffer.h"
 
+#include <algorithm>
 #include <cstring>
 
 #include "log.h"
@@ -29,97 +30,138 @@ using namespace mu::audio;
 
 void AudioBuffer::init(const audioch_t audioChannelsCount, const samples_t samplesPerChannel)
 {
-    std::lock_guard<std::mutex> lock(m_mutex);
-
     m_samplesPerChannel = samplesPerChannel;
     m_audioChannelsCount = audioChannelsCount;
 
-    m_data.resize(m_samplesPerChannel * m_audioChannelsCount, 0.f);
+    m_data.assign(m_samplesPerChannel * m_audioChannelsCount, 0.f);
+    m_fillBuffer.assign(m_policy.fillSamples * m_audioChannelsCount, 0.f);
+
+    m_writeIndex.store(0, std::memory_order_relaxed);
+    m_readIndex.store(0, std::memory_order_relaxed);
 }
 
 void AudioBuffer::setSource(std::shared_ptr<IAudioSource> source)
 {
-    std::lock_guard<std::mutex> lock(m_mutex);
     m_source = source;
 }
 
 void AudioBuffer::forward()
 {
-    std::lock_guard<std::mutex> lock(m_mutex);
     fillup();
 }
 
 void AudioBuffer::pop(float* dest, size_t sampleCount)
 {
-    std::lock_guard<std::mutex> lock(m_mutex);
+    const size_t requested = sampleCount * m_audioChannelsCount;
+    const size_t readIndex = m_readIndex.load(std::memory_order_relaxed);
+    const size_t available = m_writeIndex.load(std::memory_order_acquire) - readIndex;
+    const size_t count = std::min(requested, available);
 
-    size_t from = m_readIndex;
-    auto memStep = sizeof(float);
-    size_t to = m_readIndex + sampleCount * m_audioChannelsCount;
-    if (to > m_data.size()) {
-        to = m_data.size();
-    }
-    auto count = to - from;
-    std::memcpy(dest, m_data.data() + from, count * memStep);
-    m_readIndex += count;
-
-    size_t left = sampleCount * m_audioChannelsCount - count;
-    if (left > 0) {
-        std::memcpy(dest + count, m_data.data(), left * memStep);
-        m_readIndex = left;
+    if (count > 0) {
+        const size_t size = m_data.size();
+        const size_t from = readIndex % size;
+        const size_t firstPart = std::min(count, size - from);
+
+        std::memcpy(dest, m_data.data() + from, firstPart * sizeof(float));
+        std::memcpy(dest + firstPart, m_data.data(), (count - firstPart) * sizeof(float));
+
+        m_readIndex.store(readIndex + count, std::memory_order_release);
     }
 
-    if (m_readIndex >= m_data.size()) {
-        m_readIndex -= m_data.size();
+    if (count < requested) {
+        std::memset(dest + count, 0, (requested - count) * sizeof(float));
+        m_underrunCount.fetch_add(1, std::memory_order_relaxed);
     }
 }
 
 void AudioBuffer::setMinSampleLag(size_t lag)
 {
-    std::lock_guard<std::mutex> lock(m_mutex);
+    FillPolicy policy = m_policy;
+    policy.minSampleLag = lag;
+    setFillPolicy(policy);
+}
 
-    IF_ASSERT_FAILED(lag < m_data.size()) {
-        lag = m_data.size();
-    }
-    m_minSampleLag = lag;
+AudioBuffer::FillPolicy AudioBuffer::fillPolicy() const
+{
+    return m_policy;
 }
 
-void AudioBuffer::fillup()
+void AudioBuffer::setFillPolicy(const FillPolicy& policy)
 {
-    if (!m_source) {
+    FillPolicy newPolicy = policy;
+
+    if (capacity() == 0) {
+        m_policy = newPolicy;
         return;
     }
 
-    while (sampleLag() < m_minSampleLag + FILL_OVER) {
-        m_source->process(m_data.data() + m_writeIndex, FILL_SAMPLES);
-        updateWriteIndex(FILL_SAMPLES);
+    IF_ASSERT_FAILED(newPolicy.fillSamples > 0 && newPolicy.fillSamples <= capacity()) {
+        newPolicy.fillSamples = std::min(FILL_SAMPLES, capacity());
+    }
+
+    IF_ASSERT_FAILED(newPolicy.minSampleLag < capacity()) {
+        newPolicy.minSampleLag = capacity();
     }
+
+    m_policy = newPolicy;
+    m_fillBuffer.assign(m_policy.fillSamples * m_audioChannelsCount, 0.f);
 }
 
-void AudioBuffer::updateWriteIndex(const unsigned int samplesPerChannel)
+uint64_t AudioBuffer::underrunCount() const
 {
-    size_t from = m_writeIndex;
+    return m_underrunCount.load(std::memory_order_relaxed);
+}
 
-    auto to = m_writeIndex + samplesPerChannel * m_audioChannelsCount;
-    if (to > m_data.size()) {
-        to = m_data.size() - 1;
+uint64_t AudioBuffer::overrunCount() const
+{
+    return m_overrunCount.load(std::memory_order_relaxed);
+}
+
+samples_t AudioBuffer::capacity() const
+{
+    return m_samplesPerChannel;
+}
+
+void AudioBuffer::fillup()
+{
+    if (!m_source || m_data.empty()) {
+        return;
     }
-    auto count = to - from;
-    m_writeIndex += count;
 
-    if (m_writeIndex >= m_data.size()) {
-        m_writeIndex -= m_data.size();
+    const size_t chunkSize = m_policy.fillSamples * m_audioChannelsCount;
+
+    while (sampleLag() < m_policy.minSampleLag + m_policy.fillOver) {
+        const size_t writeIndex = m_writeIndex.load(std::memory_order_relaxed);
+        const size_t readIndex = m_readIndex.load(std::memory_order_acquire);
+
+        if (writeIndex - readIndex + chunkSize > m_data.size()) {
+            m_overrunCount.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        const size_t from = writeIndex % m_data.size();
+        if (from + chunkSize <= m_data.size()) {
+            m_source->process(m_data.data() + from, m_policy.fillSamples);
+        } else {
+            m_source->process(m_fillBuffer.data(), m_policy.fillSamples);
+            write(writeIndex, m_fillBuffer.data(), chunkSize);
+        }
+
+        m_writeIndex.store(writeIndex + chunkSize, std::memory_order_release);
     }
 }
 
-unsigned int AudioBuffer::sampleLag() const
+void AudioBuffer::write(size_t writeIndex, const float* src, size_t count)
 {
-    size_t lag = 0;
-    if (m_readIndex <= m_writeIndex) {
-        lag = m_writeIndex - m_readIndex;
-    } else {
-        lag = m_writeIndex + m_data.size() - m_readIndex;
-    }
+    const size_t from = writeIndex % m_data.size();
+    const size_t firstPart = std::min(count, m_data.size() - from);
 
-    return static_cast<unsigned int>(lag / m_audioChannelsCount);
+    std::memcpy(m_data.data() + from, src, firstPart * sizeof(float));
+    std::memcpy(m_data.data(), src + firstPart, (count - firstPart) * sizeof(float));
+}
+
+samples_t AudioBuffer::sampleLag() const
+{
+    const size_t lag = m_writeIndex.load(std::memory_order_relaxed) - m_readIndex.load(std::memory_order_acquire);
+    return lag / m_audioChannelsCount;
 }
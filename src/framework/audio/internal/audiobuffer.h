@@ -31,6 +31,10 @@
 #include "iaudiobuffer.h"
 
 namespace mu::audio {
+//! NOTE Single producer / single consumer ring buffer.
+//! forward(), setSource() and the fill policy setters are called from the worker thread only,
+//! pop() from the driver callback only. pop() never locks or waits for the worker:
+//! if there is not enough data, it outputs silence for the missing part and counts an underrun.
 class AudioBuffer : public IAudioBuffer
 {
     static const samples_t DEFAULT_SIZE = 16384;
@@ -40,6 +44,15 @@ class AudioBuffer : public IAudioBuffer
 public:
     AudioBuffer() = default;
 
+    struct FillPolicy {
+        //! samples per channel that must always be ready for the reader
+        samples_t minSampleLag = FILL_SAMPLES;
+        //! samples per channel rendered in advance on top of the minimal lag
+        samples_t fillOver = FILL_OVER;
+        //! samples per channel requested from the source in one call
+        samples_t fillSamples = FILL_SAMPLES;
+    };
+
     void init(const audioch_t audioChannelsCount, const samples_t samplesPerChannel = DEFAULT_SIZE);
 
     void setSource(std::shared_ptr<IAudioSource> source) override;
@@ -48,21 +61,36 @@ public:
     void pop(float* dest, size_t sampleCount) override;
     void setMinSampleLag(size_t lag) override;
 
+    FillPolicy fillPolicy() const;
+    void setFillPolicy(const FillPolicy& policy);
+
+    //! number of pop() calls which got less data than requested
+    uint64_t underrunCount() const;
+    //! number of forward() calls which could not reach the fill level because the buffer was full
+    uint64_t overrunCount() const;
+
 private:
 
-    unsigned int sampleLag() const;
+    samples_t capacity() const;
+    samples_t sampleLag() const;
     void fillup();
-    void updateWriteIndex(const unsigned int samplesPerChannel);
+    void write(size_t writeIndex, const float* src, size_t count);
 
-    std::mutex m_mutex;
-    size_t m_minSampleLag = FILL_SAMPLES;
-    size_t m_writeIndex = 0;
-    size_t m_readIndex = 0;
+    FillPolicy m_policy;
     samples_t m_samplesPerChannel = 0;
     audioch_t m_audioChannelsCount = 0;
 
     std::vector<float> m_data = {};
+    std::vector<float> m_fillBuffer = {};
     std::shared_ptr<IAudioSource> m_source = nullptr;
+
+    //! NOTE Both indexes only grow and are taken modulo m_data.size(),
+    //! the write index is changed by the worker only, the read index by the driver only
+    alignas(64) std::atomic<size_t> m_writeIndex = 0;
+    alignas(64) std::atomic<size_t> m_readIndex = 0;
+
+    alignas(64) std::atomic<uint64_t> m_underrunCount = 0;
+    std::atomic<uint64_t> m_overrunCount = 0;
 };
 }
 
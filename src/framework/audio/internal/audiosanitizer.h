@@ -39,11 +39,17 @@ public:
     static void setupWorkerThread();
     static std::thread::id workerThread();
     static bool isWorkerThread();
+
+    //! NOTE Render threads execute parts of the worker code (e.g. rendering of the mixer channels)
+    //! on behalf of the worker thread while it waits for them, they are not worker threads
+    static void setupRenderThread();
+    static bool isRenderThread();
 };
 }
 
 #define ONLY_AUDIO_WORKER_THREAD assert(mu::audio::AudioSanitizer::isWorkerThread())
 #define ONLY_AUDIO_MAIN_THREAD assert(mu::audio::AudioSanitizer::isMainThread())
+#define ONLY_AUDIO_WORKER_OR_RENDER_THREAD assert((mu::audio::AudioSanitizer::isWorkerThread() || mu::audio::AudioSanitizer::isRenderThread()))
 #define ONLY_AUDIO_MAIN_OR_WORKER_THREAD assert((mu::audio::AudioSanitizer::isWorkerThread() || mu::audio::AudioSanitizer::isMainThread()))
 
 #endif // MU_AUDIO_AUDIOSANITIZER_H
@@ -43,6 +43,7 @@ protected:
 
 private:
     FlacHandler* m_flac = nullptr;
+    std::vector<int32_t> m_intBuffer;
 };
 }
 
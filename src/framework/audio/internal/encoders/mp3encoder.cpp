@@ -30,10 +30,24 @@ using namespace mu::audio::encode;
 
 struct LameHandler
 {
-    static LameHandler* instance()
+    LameHandler()
+    {
+        flags = lame_init();
+
+        lame_set_errorf(flags, [](const char* msg, va_list /*ap*/) {
+            LOGE() << msg;
+        });
+        lame_set_debugf(flags, [](const char* msg, va_list /*ap*/) {
+            LOGD() << msg;
+        });
+        lame_set_msgf(flags, [](const char* msg, va_list /*ap*/) {
+            LOGI() << msg;
+        });
+    }
+
+    ~LameHandler()
     {
-        static LameHandler handler;
-        return &handler;
+        lame_close(flags);
     }
 
     bool updateSpec(const SoundTrackFormat& format)
@@ -68,50 +82,49 @@ struct LameHandler
     lame_global_flags* flags = nullptr;
 
 private:
-    LameHandler()
-    {
-        flags = lame_init();
-
-        lame_set_errorf(flags, [](const char* msg, va_list /*ap*/) {
-            LOGE() << msg;
-        });
-        lame_set_debugf(flags, [](const char* msg, va_list /*ap*/) {
-            LOGD() << msg;
-        });
-        lame_set_msgf(flags, [](const char* msg, va_list /*ap*/) {
-            LOGI() << msg;
-        });
-    }
-
-    ~LameHandler()
-    {
-        lame_close(flags);
-    }
-
     SoundTrackFormat m_format;
 };
 
-size_t Mp3Encoder::requiredOutputBufferSize(samples_t totalSamplesNumber) const
+Mp3Encoder::Mp3Encoder()
+    : m_lame(std::make_unique<LameHandler>())
+{
+}
+
+Mp3Encoder::~Mp3Encoder() = default;
+
+size_t Mp3Encoder::requiredOutputBufferSize(samples_t samplesPerChannel) const
 {
-    //!Note See thirdparty/lame/API
+    //!Note See thirdparty/lame/API, the worst case is 1.25 * samplesPerChannel + 7200 bytes
 
-    return totalSamplesNumber;
+    return samplesPerChannel + samplesPerChannel / 4 + 7200;
 }
 
 size_t Mp3Encoder::encode(samples_t samplesPerChannel, const float* input)
 {
-    LameHandler::instance()->updateSpec(m_format);
+    m_lame->updateSpec(m_format);
+    prepareOutputBuffer(samplesPerChannel);
 
-    int encodedBytes = lame_encode_buffer_interleaved_ieee_float(LameHandler::instance()->flags, input, samplesPerChannel,
+    int encodedBytes = lame_encode_buffer_interleaved_ieee_float(m_lame->flags, input, samplesPerChannel,
                                                                  m_outputBuffer.data(),
                                                                  static_cast<int>(m_outputBuffer.size()));
 
-    return std::fwrite(m_outputBuffer.data(), sizeof(unsigned char), encodedBytes, m_fileStream);
+    //! NOTE LAME keeps some samples for the next frame, so a block may legitimately produce no bytes
+    if (encodedBytes < 0) {
+        return 0;
+    }
+
+    if (std::fwrite(m_outputBuffer.data(), sizeof(unsigned char), encodedBytes, m_fileStream) != static_cast<size_t>(encodedBytes)) {
+        return 0;
+    }
+
+    return samplesPerChannel * m_format.audioChannelsNumber;
 }
 
 size_t Mp3Encoder::flush()
 {
-    int encodedBytes = lame_encode_flush(LameHandler::instance()->flags,
+    prepareOutputBuffer(0);
+
+    int encodedBytes = lame_encode_flush(m_lame->flags,
                                          m_outputBuffer.data(),
                                          static_cast<int>(m_outputBuffer.size()));
 
@@ -25,15 +25,24 @@
 
 #include "abstractaudioencoder.h"
 
+struct LameHandler;
+
 namespace mu::audio::encode {
 class Mp3Encoder : public AbstractAudioEncoder
 {
 public:
+    Mp3Encoder();
+    ~Mp3Encoder() override;
+
     size_t encode(samples_t samplesPerChannel, const float* input) override;
     size_t flush() override;
 
 protected:
-    size_t requiredOutputBufferSize(samples_t totalSamplesNumber) const override;
+    size_t requiredOutputBufferSize(samples_t samplesPerChannel) const override;
+
+private:
+    //! NOTE Each encoder has its own LAME state, so several tracks can be encoded at the same time
+    std::unique_ptr<LameHandler> m_lame;
 };
 }
 
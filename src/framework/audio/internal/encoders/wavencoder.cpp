@@ -87,36 +87,54 @@ size_t WavEncoder::encode(samples_t samplesPerChannel, const float* input)
         return 0;
     }
 
-    WavHeader header;
-    header.chunkSize = 18; // 18 is 2 bytes more to include cbsize field / extension size
-    header.bitsPerSample = 32;
-    header.code = 3; // IEEE_FLOAT = 3, PCM = 1
-    header.audioChannelsNumber = m_format.audioChannelsNumber;
-    header.sampleRate = m_format.sampleRate;
-    header.samplesPerChannel = samplesPerChannel;
+    //! NOTE The sizes in the header are not known yet, it is written again by flush()
+    if (!m_headerWritten) {
+        writeHeader();
+        m_headerWritten = true;
+    }
 
-    header.write(m_fileStream);
+    size_t samplesNumber = samplesPerChannel * m_format.audioChannelsNumber;
+    m_fileStream.write(reinterpret_cast<const char*>(input), samplesNumber * sizeof(float));
 
-    for (samples_t sampleIdx = 0; sampleIdx < header.samplesPerChannel; ++sampleIdx) {
-        for (audioch_t audioChNum = 0; audioChNum < m_format.audioChannelsNumber; ++audioChNum) {
-            int idx = sampleIdx * m_format.audioChannelsNumber + audioChNum;
-            m_fileStream.write(reinterpret_cast<const char*>(input + idx), 4);
-        }
+    if (!m_fileStream.good()) {
+        return 0;
     }
 
-    return samplesPerChannel * m_format.audioChannelsNumber;
+    m_samplesPerChannelWritten += samplesPerChannel;
+
+    return samplesNumber;
 }
 
 size_t WavEncoder::flush()
 {
-    NOT_SUPPORTED;
+    if (!m_fileStream.is_open()) {
+        return 0;
+    }
+
+    m_fileStream.seekp(0);
+    writeHeader();
+    m_fileStream.seekp(0, std::ios_base::end);
+    m_fileStream.flush();
 
     return 0;
 }
 
-size_t WavEncoder::requiredOutputBufferSize(samples_t totalSamplesNumber) const
+void WavEncoder::writeHeader()
 {
-    return totalSamplesNumber;
+    WavHeader header;
+    header.chunkSize = 18; // 18 is 2 bytes more to include cbsize field / extension size
+    header.bitsPerSample = 32;
+    header.code = 3; // IEEE_FLOAT = 3, PCM = 1
+    header.audioChannelsNumber = m_format.audioChannelsNumber;
+    header.sampleRate = m_format.sampleRate;
+    header.samplesPerChannel = m_samplesPerChannelWritten;
+
+    header.write(m_fileStream);
+}
+
+size_t WavEncoder::requiredOutputBufferSize(samples_t) const
+{
+    return 0;
 }
 
 bool WavEncoder::openDestination(const io::path_t& path)
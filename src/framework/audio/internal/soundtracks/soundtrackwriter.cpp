@@ -22,7 +22,15 @@
 
 #include "soundtrackwriter.h"
 
+#include <algorithm>
+#include <cstring>
+#include <thread>
+
+#include "io/file.h"
+
 #include "internal/worker/audioengine.h"
+#include "internal/worker/mixer.h"
+#include "internal/worker/renderthreadpool.h"
 #include "internal/encoders/mp3encoder.h"
 #include "internal/encoders/oggencoder.h"
 #include "internal/encoders/flacencoder.h"
@@ -35,18 +43,38 @@ using namespace mu::audio::soundtrack;
 static constexpr audioch_t SUPPORTED_AUDIO_CHANNELS_COUNT = 2;
 static constexpr samples_t SAMPLES_PER_CHANNEL = 2048;
 static constexpr size_t INTERNAL_BUFFER_SIZE = SUPPORTED_AUDIO_CHANNELS_COUNT * SAMPLES_PER_CHANNEL;
+static constexpr size_t QUEUE_BLOCKS_COUNT = 8;
 
 SoundTrackWriter::SoundTrackWriter(const io::path_t& destination, const SoundTrackFormat& format, const msecs_t totalDuration,
-                                   IAudioSourcePtr source)
-    : m_source(std::move(source))
+                                   std::shared_ptr<Mixer> mixer, const StemsDestinations& stemsDestinations)
+    : m_mixer(std::move(mixer)), m_destination(destination)
 {
-    if (!m_source) {
+    if (!m_mixer) {
         return;
     }
 
-    samples_t totalSamplesNumber = (totalDuration / 1000.f) * sizeof(float) * format.sampleRate;
-    m_inputBuffer.resize(totalSamplesNumber);
-    m_intermBuffer.resize(INTERNAL_BUFFER_SIZE);
+    m_totalSamplesPerChannel = static_cast<samples_t>(totalDuration) * format.sampleRate / 1000;
+
+    for (const auto& pair : stemsDestinations) {
+        Stem stem;
+        stem.trackId = pair.first;
+        stem.destination = pair.second;
+        stem.encoder = createEncoder(format.type);
+
+        if (!stem.encoder || !stem.encoder->init(stem.destination, format, m_totalSamplesPerChannel)) {
+            LOGE() << "Failed to create the stem file: " << stem.destination;
+            m_stems.clear();
+            return;
+        }
+
+        m_stems.push_back(std::move(stem));
+    }
+
+    m_blocks.resize(QUEUE_BLOCKS_COUNT);
+    for (Block& block : m_blocks) {
+        block.samples.resize(INTERNAL_BUFFER_SIZE);
+        block.stemsSamples.resize(m_stems.size(), std::vector<float>(INTERNAL_BUFFER_SIZE));
+    }
 
     m_encoderPtr = createEncoder(format.type);
 
@@ -54,38 +82,75 @@ SoundTrackWriter::SoundTrackWriter(const io::path_t& destination, const SoundTra
         return;
     }
 
-    m_encoderPtr->init(destination, format, totalSamplesNumber);
+    if (!m_encoderPtr->init(destination, format, m_totalSamplesPerChannel)) {
+        m_encoderPtr = nullptr;
+    }
 }
 
 bool SoundTrackWriter::write()
 {
     TRACEFUNC;
 
-    if (!m_source || !m_encoderPtr) {
+    if (!m_mixer || !m_encoderPtr) {
         return false;
     }
 
     AudioEngine::instance()->setMode(AudioEngine::Mode::OfflineMode);
 
-    m_source->setSampleRate(m_encoderPtr->format().sampleRate);
-    m_source->setIsActive(true);
+    m_mixer->setSampleRate(m_encoderPtr->format().sampleRate);
+    m_mixer->setIsActive(true);
 
-    if (!prepareInputBuffer()) {
-        return false;
+    std::thread encoderThread([this]() {
+        encodeBlocks();
+    });
+
+    bool ok = renderBlocks();
+
+    finishRendering();
+    encoderThread.join();
+
+    ok = ok && !m_encodingFailed;
+
+    if (ok) {
+        m_encoderPtr->flush();
+
+        for (Stem& stem : m_stems) {
+            stem.encoder->flush();
+        }
     }
 
-    if (m_encoderPtr->encode(m_inputBuffer.size() / sizeof(float), m_inputBuffer.data()) == 0) {
-        return false;
+    m_mixer->setSampleRate(AudioEngine::instance()->sampleRate());
+    m_mixer->setIsActive(false);
+
+    AudioEngine::instance()->setMode(AudioEngine::Mode::RealTimeMode);
+
+    if (!ok) {
+        removeDestinations();
     }
 
-    m_encoderPtr->flush();
+    return ok;
+}
 
-    m_source->setSampleRate(AudioEngine::instance()->sampleRate());
-    m_source->setIsActive(false);
+void SoundTrackWriter::removeDestinations()
+{
+    //! NOTE The encoders close their files when destroyed
+    m_encoderPtr = nullptr;
+    io::File::remove(m_destination);
 
-    AudioEngine::instance()->setMode(AudioEngine::Mode::RealTimeMode);
+    for (Stem& stem : m_stems) {
+        stem.encoder = nullptr;
+        io::File::remove(stem.destination);
+    }
+}
 
-    return true;
+void SoundTrackWriter::abort()
+{
+    m_isAborted = true;
+}
+
+framework::Progress SoundTrackWriter::progress() const
+{
+    return m_progress;
 }
 
 encode::AbstractAudioEncoderPtr SoundTrackWriter::createEncoder(const SoundTrackType& type) const
@@ -99,27 +164,136 @@ encode::AbstractAudioEncoderPtr SoundTrackWriter::createEncoder(const SoundTrack
     }
 }
 
-bool SoundTrackWriter::prepareInputBuffer()
+bool SoundTrackWriter::renderBlocks()
 {
-    size_t inputBufferOffset = 0;
-    size_t inputBufferMaxOffset = m_inputBuffer.size();
+    if (m_totalSamplesPerChannel == 0) {
+        LOGI() << "No audio to export";
+        return false;
+    }
 
-    while (inputBufferOffset < inputBufferMaxOffset) {
-        m_source->process(m_intermBuffer.data(), SAMPLES_PER_CHANNEL);
+    samples_t renderedSamplesPerChannel = 0;
 
-        size_t samplesToCopy = std::min(INTERNAL_BUFFER_SIZE, inputBufferMaxOffset - inputBufferOffset);
+    while (renderedSamplesPerChannel < m_totalSamplesPerChannel) {
+        if (m_isAborted) {
+            LOGI() << "Audio export aborted";
+            return false;
+        }
 
-        std::copy(m_intermBuffer.begin(),
-                  m_intermBuffer.begin() + samplesToCopy,
-                  m_inputBuffer.begin() + inputBufferOffset);
+        Block* block = acquireFreeBlock();
+        if (!block) {
+            return false;
+        }
 
-        inputBufferOffset += samplesToCopy;
-    }
+        m_mixer->process(block->samples.data(), SAMPLES_PER_CHANNEL);
 
-    if (inputBufferOffset == 0) {
-        LOGI() << "No audio to export";
-        return false;
+        for (size_t i = 0; i < m_stems.size(); ++i) {
+            const float* channelBuffer = m_mixer->channelBuffer(m_stems[i].trackId);
+            float* stemSamples = block->stemsSamples[i].data();
+
+            if (channelBuffer) {
+                std::memcpy(stemSamples, channelBuffer, INTERNAL_BUFFER_SIZE * sizeof(float));
+            } else {
+                std::fill(stemSamples, stemSamples + INTERNAL_BUFFER_SIZE, 0.f);
+            }
+        }
+
+        block->samplesPerChannel = std::min(SAMPLES_PER_CHANNEL, m_totalSamplesPerChannel - renderedSamplesPerChannel);
+        renderedSamplesPerChannel += block->samplesPerChannel;
+
+        commitFilledBlock();
+
+        m_progress.progressChanged.send(static_cast<int64_t>(renderedSamplesPerChannel),
+                                        static_cast<int64_t>(m_totalSamplesPerChannel), "");
     }
 
     return true;
 }
+
+void SoundTrackWriter::encodeBlocks()
+{
+    //! NOTE The mix and the stems of a block are independent, so they are encoded in parallel
+    RenderThreadPool pool(std::min(m_stems.size(), RenderThreadPool::defaultThreadCount()));
+
+    Block* block = nullptr;
+
+    RenderThreadPool::Job encodeJob = [this, &block](size_t jobIdx) {
+        encode::AbstractAudioEncoder* encoder = jobIdx == 0 ? m_encoderPtr.get() : m_stems[jobIdx - 1].encoder.get();
+        const float* samples = jobIdx == 0 ? block->samples.data() : block->stemsSamples[jobIdx - 1].data();
+
+        if (encoder->encode(block->samplesPerChannel, samples) == 0) {
+            m_encodingFailed = true;
+        }
+    };
+
+    while ((block = acquireFilledBlock())) {
+        pool.run(1 + m_stems.size(), encodeJob);
+
+        if (m_encodingFailed) {
+            LOGE() << "Failed to encode audio";
+        }
+
+        releaseEncodedBlock();
+    }
+}
+
+SoundTrackWriter::Block* SoundTrackWriter::acquireFreeBlock()
+{
+    std::unique_lock<std::mutex> lock(m_blocksMutex);
+
+    m_blocksChanged.wait(lock, [this]() {
+        return m_filledBlocksCount < m_blocks.size() || m_encodingFailed;
+    });
+
+    if (m_encodingFailed) {
+        return nullptr;
+    }
+
+    return &m_blocks[m_renderBlockIdx];
+}
+
+void SoundTrackWriter::commitFilledBlock()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_blocksMutex);
+        m_renderBlockIdx = (m_renderBlockIdx + 1) % m_blocks.size();
+        ++m_filledBlocksCount;
+    }
+
+    m_blocksChanged.notify_all();
+}
+
+SoundTrackWriter::Block* SoundTrackWriter::acquireFilledBlock()
+{
+    std::unique_lock<std::mutex> lock(m_blocksMutex);
+
+    m_blocksChanged.wait(lock, [this]() {
+        return m_filledBlocksCount > 0 || m_renderingFinished;
+    });
+
+    if (m_filledBlocksCount == 0 || m_encodingFailed) {
+        return nullptr;
+    }
+
+    return &m_blocks[m_encodeBlockIdx];
+}
+
+void SoundTrackWriter::releaseEncodedBlock()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_blocksMutex);
+        m_encodeBlockIdx = (m_encodeBlockIdx + 1) % m_blocks.size();
+        --m_filledBlocksCount;
+    }
+
+    m_blocksChanged.notify_all();
+}
+
+void SoundTrackWriter::finishRendering()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_blocksMutex);
+        m_renderingFinished = true;
+    }
+
+    m_blocksChanged.notify_all();
+}
@@ -23,32 +23,89 @@
 #ifndef MU_AUDIO_SOUNDTRACKWRITER_H
 #define MU_AUDIO_SOUNDTRACKWRITER_H
 
+#include <atomic>
+#include <condition_variable>
+#include <map>
+#include <mutex>
 #include <vector>
 #include <cstdio>
 
+#include "global/progress.h"
+
 #include "audiotypes.h"
 #include "iaudiosource.h"
 #include "internal/encoders/abstractaudioencoder.h"
 
+namespace mu::audio {
+class Mixer;
+}
+
 namespace mu::audio::soundtrack {
+//! NOTE Renders the mixer block by block on the calling thread and encodes the blocks on its own thread.
+//! The blocks go through a small bounded queue, so the memory doesn't depend on the track duration.
+//! Optionally the channels of the mixer (stems) are written too, each into its own file
 class SoundTrackWriter
 {
 public:
-    SoundTrackWriter(const io::path_t& destination, const SoundTrackFormat& format, const msecs_t totalDuration, IAudioSourcePtr source);
+    using StemsDestinations = std::map<TrackId, io::path_t>;
+
+    SoundTrackWriter(const io::path_t& destination, const SoundTrackFormat& format, const msecs_t totalDuration,
+                     std::shared_ptr<Mixer> mixer, const StemsDestinations& stemsDestinations = {});
 
     bool write();
 
+    //! NOTE Can be called from any thread, the export stops after the current block
+    void abort();
+
+    framework::Progress progress() const;
+
 private:
+    struct Block {
+        std::vector<float> samples;
+        std::vector<std::vector<float> > stemsSamples;
+        samples_t samplesPerChannel = 0;
+    };
+
+    struct Stem {
+        TrackId trackId = -1;
+        io::path_t destination;
+        encode::AbstractAudioEncoderPtr encoder = nullptr;
+    };
+
     encode::AbstractAudioEncoderPtr createEncoder(const SoundTrackType& type) const;
-    bool prepareInputBuffer();
 
-    IAudioSourcePtr m_source = nullptr;
+    bool renderBlocks();
+    void encodeBlocks();
+
+    Block* acquireFreeBlock();
+    void commitFilledBlock();
+    Block* acquireFilledBlock();
+    void releaseEncodedBlock();
+    void finishRendering();
+
+    void removeDestinations();
 
-    std::vector<float> m_inputBuffer;
-    std::vector<float> m_intermBuffer;
+    std::shared_ptr<Mixer> m_mixer = nullptr;
+    io::path_t m_destination;
+    std::vector<Stem> m_stems;
+    samples_t m_totalSamplesPerChannel = 0;
+
+    std::vector<Block> m_blocks;
+    size_t m_renderBlockIdx = 0;
+    size_t m_encodeBlockIdx = 0;
+    size_t m_filledBlocksCount = 0;
+    bool m_renderingFinished = false;
+    std::mutex m_blocksMutex;
+    std::condition_variable m_blocksChanged;
+
+    std::atomic<bool> m_isAborted = false;
+    std::atomic<bool> m_encodingFailed = false;
 
     encode::AbstractAudioEncoderPtr m_encoderPtr = nullptr;
+    framework::Progress m_progress;
 };
+
+using SoundTrackWriterPtr = std::shared_ptr<SoundTrackWriter>;
 }
 
 #endif // MU_AUDIO_SOUNDTRACKWRITER_H
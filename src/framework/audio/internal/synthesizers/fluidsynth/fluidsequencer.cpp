@@ -35,34 +35,32 @@ void FluidSequencer::init(const ArticulationMapping& mapping, const std::unorder
 
 void FluidSequencer::updateOffStreamEvents(const mpe::PlaybackEventsMap& changes)
 {
-    m_offStreamEvents.clear();
-    updatePlaybackEvents(m_offStreamEvents, changes);
-    updateOffSequenceIterator();
+    updatePlaybackEvents(beginUpdate(m_offStream), changes);
+    commitUpdate(m_offStream);
 }
 
 void FluidSequencer::updateMainStreamEvents(const mpe::PlaybackEventsMap& changes)
 {
-    m_mainStreamEvents.clear();
-    updatePlaybackEvents(m_mainStreamEvents, changes);
-    updateMainSequenceIterator();
+    updatePlaybackEvents(beginUpdate(m_mainStream), changes);
+    commitUpdate(m_mainStream);
 }
 
 void FluidSequencer::updateDynamicChanges(const mpe::DynamicLevelMap& changes)
 {
-    m_dynamicEvents.clear();
+    EventTimeline& timeline = beginUpdate(m_dynamicStream);
 
     for (const auto& pair : changes) {
         midi::Event event(midi::Event::Opcode::ControlChange, Event::MessageType::ChannelVoice10);
         event.setIndex(11);
         event.setData(expressionLevel(pair.second));
 
-        m_dynamicEvents[pair.first].emplace(std::move(event));
+        timeline.add(pair.first, std::move(event));
     }
 
-    updateDynamicChangesIterator();
+    commitUpdate(m_dynamicStream);
 }
 
-void FluidSequencer::updatePlaybackEvents(EventSequenceMap& destination, const mpe::PlaybackEventsMap& changes)
+void FluidSequencer::updatePlaybackEvents(EventTimeline& destination, const mpe::PlaybackEventsMap& changes)
 {
     for (const auto& pair : changes) {
         for (const mpe::PlaybackEvent& event : pair.second) {
@@ -84,13 +82,13 @@ void FluidSequencer::updatePlaybackEvents(EventSequenceMap& destination, const m
             noteOn.setNote(noteIdx);
             noteOn.setVelocity(velocity);
 
-            destination[timestampFrom].emplace(std::move(noteOn));
+            destination.add(timestampFrom, std::move(noteOn));
 
             midi::Event noteOff(Event::Opcode::NoteOff, Event::MessageType::ChannelVoice10);
             noteOff.setChannel(channelIdx);
             noteOff.setNote(noteIdx);
 
-            destination[timestampTo].emplace(std::move(noteOff));
+            destination.add(timestampTo, std::move(noteOff));
 
             appendControlSwitch(destination, noteEvent, PEDAL_CC_SUPPORTED_TYPES, 64);
             appendPitchBend(destination, noteEvent, BEND_SUPPORTED_TYPES, channelIdx);
@@ -98,7 +96,7 @@ void FluidSequencer::updatePlaybackEvents(EventSequenceMap& destination, const m
     }
 }
 
-void FluidSequencer::appendControlSwitch(EventSequenceMap& destination, const mpe::NoteEvent& noteEvent,
+void FluidSequencer::appendControlSwitch(EventTimeline& destination, const mpe::NoteEvent& noteEvent,
                                          const mpe::ArticulationTypeSet& appliableTypes, const int midiControlIdx)
 {
     mpe::ArticulationType currentType = mpe::ArticulationType::Undefined;
@@ -118,23 +116,23 @@ void FluidSequencer::appendControlSwitch(EventSequenceMap& destination, const mp
         start.setIndex(midiControlIdx);
         start.setData(127);
 
-        destination[articulationMeta.timestamp].emplace(std::move(start));
+        destination.add(articulationMeta.timestamp, std::move(start));
 
         midi::Event end(Event::Opcode::ControlChange, Event::MessageType::ChannelVoice10);
         end.setIndex(midiControlIdx);
         end.setData(0);
 
-        destination[articulationMeta.timestamp + articulationMeta.overallDuration].emplace(std::move(end));
+        destination.add(articulationMeta.timestamp + articulationMeta.overallDuration, std::move(end));
     } else {
         midi::Event cc(Event::Opcode::ControlChange, Event::MessageType::ChannelVoice10);
         cc.setIndex(midiControlIdx);
         cc.setData(0);
 
-        destination[noteEvent.arrangementCtx().actualTimestamp].emplace(std::move(cc));
+        destination.add(noteEvent.arrangementCtx().actualTimestamp, std::move(cc));
     }
 }
 
-void FluidSequencer::appendPitchBend(EventSequenceMap& destination, const mpe::NoteEvent& noteEvent,
+void FluidSequencer::appendPitchBend(EventTimeline& destination, const mpe::NoteEvent& noteEvent,
                                      const mpe::ArticulationTypeSet& appliableTypes, const channel_t channelIdx)
 {
     mpe::ArticulationType currentType = mpe::ArticulationType::Undefined;
@@ -159,7 +157,7 @@ void FluidSequencer::appendPitchBend(EventSequenceMap& destination, const mpe::N
 
             if (pair.first == HUNDRED_PERCENT) {
                 event.setData(pitchBendValue);
-                destination[currentPoint].emplace(std::move(event));
+                destination.add(currentPoint, std::move(event));
                 return;
             }
 
@@ -170,14 +168,14 @@ void FluidSequencer::appendPitchBend(EventSequenceMap& destination, const mpe::N
             pitchBendValue = std::clamp(pitchBendValue, 0, 16383);
 
             event.setData(pitchBendValue);
-            destination[currentPoint].emplace(std::move(event));
+            destination.add(currentPoint, std::move(event));
             return;
         }
     } else {
         midi::Event event(Event::Opcode::PitchBend, Event::MessageType::ChannelVoice10);
         event.setChannel(channelIdx);
         event.setData(8192);
-        destination[timestampFrom].emplace(std::move(event));
+        destination.add(timestampFrom, std::move(event));
     }
 }
 
@@ -40,12 +40,12 @@ public:
     void updateDynamicChanges(const mpe::DynamicLevelMap& changes) override;
 
 private:
-    void updatePlaybackEvents(EventSequenceMap& destination, const mpe::PlaybackEventsMap& changes);
+    void updatePlaybackEvents(EventTimeline& destination, const mpe::PlaybackEventsMap& changes);
 
-    void appendControlSwitch(EventSequenceMap& destination, const mpe::NoteEvent& noteEvent, const mpe::ArticulationTypeSet& appliableTypes,
+    void appendControlSwitch(EventTimeline& destination, const mpe::NoteEvent& noteEvent, const mpe::ArticulationTypeSet& appliableTypes,
                              const int midiControlIdx);
 
-    void appendPitchBend(EventSequenceMap& destination, const mpe::NoteEvent& noteEvent, const mpe::ArticulationTypeSet& appliableTypes,
+    void appendPitchBend(EventTimeline& destination, const mpe::NoteEvent& noteEvent, const mpe::ArticulationTypeSet& appliableTypes,
                          const midi::channel_t channelIdx);
 
     midi::channel_t channel(const mpe::NoteEvent& noteEvent) const;
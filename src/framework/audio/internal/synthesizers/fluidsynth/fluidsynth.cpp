@@ -208,6 +208,8 @@ void FluidSynth::setSampleRate(unsigned int sampleRate)
     }
 
     m_sampleRate = sampleRate;
+    m_sequencer.setSampleRate(sampleRate);
+
     if (m_fluid->settings) {
         fluid_settings_setnum(m_fluid->settings, "synth.sample-rate", static_cast<double>(m_sampleRate));
     }
@@ -346,25 +348,46 @@ samples_t FluidSynth::process(float* buffer, samples_t samplesPerChannel)
         return 0;
     }
 
-    msecs_t nextMsecs = samplesToMsecs(samplesPerChannel, m_sampleRate);
+    const FluidSequencer::EventSequence& sequence = m_sequencer.eventsToBePlayed(samplesPerChannel);
 
-    const FluidSequencer::EventSequence& sequence = m_sequencer.eventsToBePlayed(nextMsecs);
+    //! NOTE The block is rendered in parts, so that every event starts exactly at its frame
+    samples_t renderedSamples = 0;
 
-    for (const FluidSequencer::EventType& event : sequence) {
-        handleEvent(std::get<midi::Event>(event));
-    }
+    for (const FluidSequencer::BlockEvent& blockEvent : sequence) {
+        if (blockEvent.frameOffset > renderedSamples) {
+            if (!render(buffer, renderedSamples, blockEvent.frameOffset - renderedSamples)) {
+                return 0;
+            }
+
+            renderedSamples = blockEvent.frameOffset;
+        }
 
-    int result = fluid_synth_write_float(m_fluid->synth, samplesPerChannel,
-                                         buffer, 0, audioChannelsCount(),
-                                         buffer, 1, audioChannelsCount());
+        handleEvent(std::get<midi::Event>(blockEvent.event));
+    }
 
-    if (result != FLUID_OK) {
+    if (!render(buffer, renderedSamples, samplesPerChannel - renderedSamples)) {
         return 0;
     }
 
     return samplesPerChannel;
 }
 
+bool FluidSynth::render(float* buffer, samples_t fromSample, samples_t samplesCount)
+{
+    if (samplesCount == 0) {
+        return true;
+    }
+
+    const unsigned int channelsCount = audioChannelsCount();
+    const int offset = static_cast<int>(fromSample * channelsCount);
+
+    int result = fluid_synth_write_float(m_fluid->synth, static_cast<int>(samplesCount),
+                                         buffer, offset, channelsCount,
+                                         buffer, offset + 1, channelsCount);
+
+    return result == FLUID_OK;
+}
+
 async::Channel<unsigned int> FluidSynth::audioChannelsCountChanged() const
 {
     return m_streamsCountChanged;
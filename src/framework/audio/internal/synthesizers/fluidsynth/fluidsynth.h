@@ -74,6 +74,7 @@ private:
     void createFluidInstance();
 
     bool handleEvent(const midi::Event& event);
+    bool render(float* buffer, samples_t fromSample, samples_t samplesCount);
 
     void updateCurrentExpressionLevel(const midi::Event& event);
     void toggleExpressionController();
@@ -23,27 +23,58 @@
 #ifndef MU_AUDIO_SFCACHEDLOADER_H
 #define MU_AUDIO_SFCACHEDLOADER_H
 
+#include <memory>
+
+#include "io/mappedfile.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
 #include <cstdio>
+#include <algorithm>
+#include <cstring>
 #include <vector>
 #include <map>
 #include <string>
 
+#include <fluidsynth.h>
 #include <sfloader/fluid_sfont.h>
 #include <sfloader/fluid_defsfont.h>
 
 #include "log.h"
 
 namespace mu::audio::synth {
+//! NOTE The sound-font files are mapped into memory instead of being read into it.
+//!      SF2 sample data is played right from the mapped pages, so the instances of this process share a single copy of it
+//!      and the other processes mapping the same file share it with them through the OS page cache
 struct SoundFontData
 {
     fluid_sfont_t* soundFontPtr = nullptr;
-    std::FILE* fileStream = nullptr;
+    std::unique_ptr<io::MappedFile> file;
+    bool isSampleDataMapped = false;
+};
+
+//! NOTE The position of a single Fluid reader within a mapped sound-font file
+struct SoundFontStream
+{
+    const io::MappedFile* file = nullptr;
+    long position = 0;
 };
 
+static void unmapSampleData(fluid_defsfont_t* defsFont)
+{
+    //!Note The mapped sample data doesn't belong to Fluid's sample cache, so Fluid must not try to release it
+    for (fluid_list_t* list = defsFont->sample; list; list = fluid_list_next(list)) {
+        fluid_sample_t* sample = static_cast<fluid_sample_t*>(fluid_list_get(list));
+        sample->data = nullptr;
+        sample->data24 = nullptr;
+    }
+
+    defsFont->sampledata = nullptr;
+    defsFont->sample24data = nullptr;
+}
+
 struct SoundFontCache : public std::map<std::string, SoundFontData> {
     static SoundFontCache* instance()
     {
@@ -56,62 +87,180 @@ private:
     ~SoundFontCache()
     {
         for (const auto& pair : *this) {
+            if (!pair.second.soundFontPtr) {
+                continue;
+            }
+
             fluid_defsfont_t* defsFont = static_cast<fluid_defsfont_t*>(fluid_sfont_get_data(pair.second.soundFontPtr));
 
+            if (pair.second.isSampleDataMapped) {
+                unmapSampleData(defsFont);
+            }
+
             if (delete_fluid_defsfont(defsFont) != FLUID_OK) {
                 continue;
             }
 
             delete_fluid_sfont(pair.second.soundFontPtr);
+        }
+    }
+};
 
-            if (pair.second.fileStream) {
-                std::fclose(pair.second.fileStream);
+static uint32_t readUInt32LE(const uint8_t* data)
+{
+    return static_cast<uint32_t>(data[0])
+           | (static_cast<uint32_t>(data[1]) << 8)
+           | (static_cast<uint32_t>(data[2]) << 16)
+           | (static_cast<uint32_t>(data[3]) << 24);
+}
+
+static bool isLittleEndianHost()
+{
+    const uint16_t value = 1;
+    return *reinterpret_cast<const uint8_t*>(&value) == 1;
+}
+
+//! NOTE Looks for the "ifil" chunk in the INFO list of the file, returns 0 if there is none
+static int soundFontMajorVersion(const io::MappedFile& file)
+{
+    static constexpr size_t CHUNK_HEADER_SIZE = 8;
+    static constexpr size_t INFO_LIST_OFFSET = 12;
+
+    const uint8_t* data = file.data();
+    size_t size = file.size();
+
+    if (size < INFO_LIST_OFFSET + CHUNK_HEADER_SIZE + 4
+        || std::memcmp(data, "RIFF", 4) != 0
+        || std::memcmp(data + 8, "sfbk", 4) != 0
+        || std::memcmp(data + INFO_LIST_OFFSET, "LIST", 4) != 0
+        || std::memcmp(data + INFO_LIST_OFFSET + CHUNK_HEADER_SIZE, "INFO", 4) != 0) {
+        return 0;
+    }
+
+    size_t infoEnd = std::min<size_t>(size, INFO_LIST_OFFSET + CHUNK_HEADER_SIZE + readUInt32LE(data + INFO_LIST_OFFSET + 4));
+    size_t position = INFO_LIST_OFFSET + CHUNK_HEADER_SIZE + 4;
+
+    while (position + CHUNK_HEADER_SIZE <= infoEnd) {
+        uint32_t chunkSize = readUInt32LE(data + position + 4);
+
+        if (std::memcmp(data + position, "ifil", 4) == 0) {
+            if (chunkSize < 4 || position + CHUNK_HEADER_SIZE + 2 > infoEnd) {
+                return 0;
             }
+
+            const uint8_t* version = data + position + CHUNK_HEADER_SIZE;
+            return version[0] | (version[1] << 8);
         }
+
+        position += CHUNK_HEADER_SIZE + chunkSize + (chunkSize & 1);
     }
-};
 
-void* openSoundFont(const char* filename)
+    return 0;
+}
+
+//! NOTE Points the samples of an SF2 font, loaded without its sample data, to the sample data chunks of the mapped file.
+//!      SF2 keeps its samples as raw 16 bit little endian PCM, which is the very layout Fluid plays from
+static bool mapSampleData(fluid_defsfont_t* defsFont, const io::MappedFile& file)
 {
-    auto search = SoundFontCache::instance()->find(filename);
+    if (static_cast<size_t>(defsFont->samplepos) + defsFont->samplesize > file.size()) {
+        LOGE() << "Sample data exceeds the file: " << file.filePath();
+        return false;
+    }
 
-    if (search != SoundFontCache::instance()->cend()
-        && search->second.fileStream) {
-        return search->second.fileStream;
+    defsFont->sampledata = reinterpret_cast<short*>(const_cast<uint8_t*>(file.data() + defsFont->samplepos));
+    defsFont->sample24data = nullptr;
+
+    if (defsFont->sample24pos
+        && static_cast<size_t>(defsFont->sample24pos) + defsFont->sample24size <= file.size()
+        && defsFont->sample24size >= defsFont->samplesize / sizeof(short)) {
+        defsFont->sample24data = reinterpret_cast<char*>(const_cast<uint8_t*>(file.data() + defsFont->sample24pos));
     }
 
-    std::FILE* stream = std::fopen(filename, "r");
+    for (fluid_list_t* list = defsFont->sample; list; list = fluid_list_next(list)) {
+        fluid_sample_t* sample = static_cast<fluid_sample_t*>(fluid_list_get(list));
 
-    SoundFontData sfData;
-    sfData.fileStream = stream;
+        sample->data = defsFont->sampledata;
+        sample->data24 = defsFont->sample24data;
+        sample->notify = nullptr;
 
-    SoundFontCache::instance()->emplace(filename, std::move(sfData));
+        fluid_sample_sanitize_loop(sample, defsFont->samplesize);
+        fluid_voice_optimize_sample(sample);
+    }
+
+    //!Note All the samples are available from now on, there is nothing to load when a preset gets selected
+    for (fluid_list_t* list = defsFont->preset; list; list = fluid_list_next(list)) {
+        fluid_preset_t* preset = static_cast<fluid_preset_t*>(fluid_list_get(list));
+        preset->notify = nullptr;
+    }
+
+    defsFont->dynamic_samples = false;
+
+    return true;
+}
+
+void* openSoundFont(const char* filename)
+{
+    auto search = SoundFontCache::instance()->find(filename);
+
+    if (search == SoundFontCache::instance()->cend()
+        || !search->second.file
+        || !search->second.file->isOpen()) {
+        return nullptr;
+    }
+
+    SoundFontStream* stream = new SoundFontStream();
+    stream->file = search->second.file.get();
 
     return stream;
 }
 
 int readSoundFont(void* buf, int count, void* handle)
 {
-    return static_cast<int>(std::fread(buf, count, 1, static_cast<std::FILE*>(handle)));
+    SoundFontStream* stream = static_cast<SoundFontStream*>(handle);
+
+    if (count < 0 || stream->position + count > static_cast<long>(stream->file->size())) {
+        return FLUID_FAILED;
+    }
+
+    std::memcpy(buf, stream->file->data() + stream->position, count);
+    stream->position += count;
+
+    return FLUID_OK;
 }
 
 int seekSoundFont(void* handle, long offset, int origin)
 {
-    return std::fseek(static_cast<std::FILE*>(handle), offset, origin);
+    SoundFontStream* stream = static_cast<SoundFontStream*>(handle);
+    long position = offset;
+
+    if (origin == SEEK_CUR) {
+        position += stream->position;
+    } else if (origin == SEEK_END) {
+        position += static_cast<long>(stream->file->size());
+    }
+
+    if (position < 0 || position > static_cast<long>(stream->file->size())) {
+        return FLUID_FAILED;
+    }
+
+    stream->position = position;
+
+    return FLUID_OK;
 }
 
-int closeSoundFont(void* /*handle*/)
+int closeSoundFont(void* handle)
 {
-    //!Note Prevent closing of sound-font files by Fluid instances,
-    //!     instead the actual closing of cached sound-font files will happen in SoundFontCache.
-    //!     However, we still need to provide "some" callback for Fluid's API
+    //!Note Only the reader gets closed here,
+    //!     the mapping of the sound-font file itself stays in SoundFontCache.
+
+    delete static_cast<SoundFontStream*>(handle);
 
     return FLUID_OK;
 }
 
 long tellSoundFont(void* handle)
 {
-    return std::ftell(static_cast<std::FILE*>(handle));
+    return static_cast<SoundFontStream*>(handle)->position;
 }
 
 int deleteSoundFont(fluid_sfont_t* /*sfont*/)
@@ -133,11 +282,23 @@ static fluid_file_callbacks_t FILE_CALLBACKS {
 
 fluid_sfont_t* loadSoundFont(fluid_sfloader_t* loader, const char* filename)
 {
-    auto search = SoundFontCache::instance()->find(filename);
-    if (search != SoundFontCache::instance()->cend()) {
-        return search->second.soundFontPtr;
+    SoundFontData& sfData = SoundFontCache::instance()->operator[](filename);
+    if (sfData.soundFontPtr) {
+        return sfData.soundFontPtr;
     }
 
+    if (!sfData.file) {
+        sfData.file = std::make_unique<io::MappedFile>(filename);
+    }
+
+    if (!sfData.file->open()) {
+        SoundFontCache::instance()->erase(filename);
+        return nullptr;
+    }
+
+    //!Note SF3 samples are compressed, so Fluid has to decode them into memory as usual
+    bool mapSamples = isLittleEndianHost() && soundFontMajorVersion(*sfData.file) == 2;
+
     fluid_defsfont_t* defsfont = nullptr;
     fluid_sfont_t* result = nullptr;
 
@@ -161,13 +322,20 @@ fluid_sfont_t* loadSoundFont(fluid_sfloader_t* loader, const char* filename)
     defsfont->sfont = result;
     defsfont->fcbs = &FILE_CALLBACKS;
 
-    if (fluid_defsfont_load(defsfont, &FILE_CALLBACKS, filename) == FLUID_FAILED) {
+    //!Note Makes Fluid skip reading the sample data, it will be taken from the mapped file instead
+    if (mapSamples) {
+        defsfont->dynamic_samples = true;
+    }
+
+    if (fluid_defsfont_load(defsfont, &FILE_CALLBACKS, filename) == FLUID_FAILED
+        || (mapSamples && !mapSampleData(defsfont, *sfData.file))) {
         fluid_defsfont_sfont_delete(result);
+        SoundFontCache::instance()->erase(filename);
         return nullptr;
     }
 
-    SoundFontData& sfData = SoundFontCache::instance()->operator[](filename);
     sfData.soundFontPtr = result;
+    sfData.isSampleDataMapped = mapSamples;
 
     return result;
 }
@@ -22,6 +22,8 @@
 
 #include "audiooutputhandler.h"
 
+#include <set>
+
 #include "config.h"
 
 #include "log.h"
@@ -171,7 +173,19 @@ Promise<AudioSignalChanges> AudioOutputHandler::masterSignalChanges() const
 Promise<bool> AudioOutputHandler::saveSoundTrack(const TrackSequenceId sequenceId, const io::path_t& destination,
                                                  const SoundTrackFormat& format)
 {
-    return Promise<bool>([this, sequenceId, destination, format](auto resolve, auto reject) {
+    return doSaveSoundTrack(sequenceId, destination, format, false /*withStems*/);
+}
+
+Promise<bool> AudioOutputHandler::saveSoundTrackStems(const TrackSequenceId sequenceId, const io::path_t& destination,
+                                                      const SoundTrackFormat& format)
+{
+    return doSaveSoundTrack(sequenceId, destination, format, true /*withStems*/);
+}
+
+Promise<bool> AudioOutputHandler::doSaveSoundTrack(const TrackSequenceId sequenceId, const io::path_t& destination,
+                                                   const SoundTrackFormat& format, bool withStems)
+{
+    return Promise<bool>([this, sequenceId, destination, format, withStems](auto resolve, auto reject) {
         ONLY_AUDIO_WORKER_THREAD;
 
         IF_ASSERT_FAILED(mixer()) {
@@ -186,11 +200,38 @@ Promise<bool> AudioOutputHandler::saveSoundTrack(const TrackSequenceId sequenceI
 #ifdef ENABLE_AUDIO_EXPORT
         s->player()->seek(0);
         msecs_t totalDuration = s->player()->duration();
-        SoundTrackWriter writer(destination, format, totalDuration, mixer());
 
-        bool ok = writer.write();
+        SoundTrackWriter::StemsDestinations stemsDestinations;
+        if (withStems) {
+            std::vector<std::pair<TrackId, TrackName> > tracks;
+            for (const TrackId trackId : s->trackIdList()) {
+                tracks.emplace_back(trackId, s->trackName(trackId));
+            }
+
+            stemsDestinations = AudioOutputHandler::stemsDestinations(destination, tracks);
+        }
+
+        SoundTrackWriterPtr writer = std::make_shared<SoundTrackWriter>(destination, format, totalDuration, mixer(), stemsDestinations);
+
+        framework::Progress progress = saveSoundTrackProgress(sequenceId);
+        writer->progress().progressChanged.onReceive(this, [progress](int64_t current, int64_t total, std::string title) mutable {
+            progress.progressChanged.send(current, total, title);
+        });
+
+        {
+            std::lock_guard<std::mutex> lock(m_saveSoundTracksMutex);
+            m_saveSoundTracksWritersMap[sequenceId] = writer;
+        }
+
+        bool ok = writer->write();
         s->player()->seek(0);
 
+        {
+            std::lock_guard<std::mutex> lock(m_saveSoundTracksMutex);
+            m_saveSoundTracksWritersMap.erase(sequenceId);
+            m_saveSoundTracksProgressMap.erase(sequenceId);
+        }
+
         return resolve(ok);
 #else
         return reject(static_cast<int>(Err::DisabledAudioExport), "audio export is disabled");
@@ -198,6 +239,47 @@ Promise<bool> AudioOutputHandler::saveSoundTrack(const TrackSequenceId sequenceI
     }, AudioThread::ID);
 }
 
+void AudioOutputHandler::abortSavingAllSoundTracks()
+{
+#ifdef ENABLE_AUDIO_EXPORT
+    std::lock_guard<std::mutex> lock(m_saveSoundTracksMutex);
+
+    for (auto& pair : m_saveSoundTracksWritersMap) {
+        pair.second->abort();
+    }
+#endif
+}
+
+mu::framework::Progress AudioOutputHandler::saveSoundTrackProgress(const TrackSequenceId sequenceId)
+{
+    std::lock_guard<std::mutex> lock(m_saveSoundTracksMutex);
+
+    return m_saveSoundTracksProgressMap[sequenceId];
+}
+
+std::map<TrackId, mu::io::path_t> AudioOutputHandler::stemsDestinations(const io::path_t& destination,
+                                                                         const std::vector<std::pair<TrackId, TrackName> >& tracks)
+{
+    io::path_t prefix = io::dirpath(destination) + "/" + io::completeBasename(destination) + "-";
+    io::path_t suffix = io::suffix(destination);
+
+    //! NOTE Two encoders must not write the same file, the names are compared
+    //! case-insensitively for the file systems that are so
+    std::map<TrackId, io::path_t> result;
+    std::set<String> usedNames;
+    for (const auto& [trackId, trackName] : tracks) {
+        String name = io::escapeFileName(io::path_t(trackName)).toString();
+        String uniqueName = name;
+        for (int number = 2; !usedNames.insert(uniqueName.toLower()).second; ++number) {
+            uniqueName = name + u"_" + String::number(number);
+        }
+
+        result.emplace(trackId, (prefix + uniqueName).appendingSuffix(suffix));
+    }
+
+    return result;
+}
+
 std::shared_ptr<Mixer> AudioOutputHandler::mixer() const
 {
     return AudioEngine::instance()->mixer();
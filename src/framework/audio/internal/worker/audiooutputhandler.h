@@ -23,6 +23,10 @@
 #ifndef MU_AUDIO_AUDIOIOHANDLER_H
 #define MU_AUDIO_AUDIOIOHANDLER_H
 
+#include <map>
+#include <mutex>
+#include <vector>
+
 #include "modularity/ioc.h"
 #include "async/asyncable.h"
 
@@ -32,6 +36,11 @@
 
 namespace mu::audio {
 class Mixer;
+
+namespace soundtrack {
+class SoundTrackWriter;
+}
+
 class AudioOutputHandler : public IAudioOutput, public async::Asyncable
 {
     INJECT(audio, fx::IFxResolver, fxResolver)
@@ -54,6 +63,15 @@ public:
 
     async::Promise<bool> saveSoundTrack(const TrackSequenceId sequenceId, const io::path_t& destination,
                                         const SoundTrackFormat& format) override;
+    async::Promise<bool> saveSoundTrackStems(const TrackSequenceId sequenceId, const io::path_t& destination,
+                                             const SoundTrackFormat& format) override;
+    void abortSavingAllSoundTracks() override;
+
+    framework::Progress saveSoundTrackProgress(const TrackSequenceId sequenceId) override;
+
+    //! NOTE <dir>/<name>-<track name>.<suffix> for each track, tracks with the same name get a number
+    static std::map<TrackId, io::path_t> stemsDestinations(const io::path_t& destination,
+                                                           const std::vector<std::pair<TrackId, TrackName> >& tracks);
 
 private:
     std::shared_ptr<Mixer> mixer() const;
@@ -61,10 +79,18 @@ private:
     void ensureSeqSubscriptions(const ITrackSequencePtr s) const;
     void ensureMixerSubscriptions() const;
 
+    async::Promise<bool> doSaveSoundTrack(const TrackSequenceId sequenceId, const io::path_t& destination,
+                                          const SoundTrackFormat& format, bool withStems);
+
     IGetTrackSequence* m_getSequence = nullptr;
 
     mutable async::Channel<AudioOutputParams> m_masterOutputParamsChanged;
     mutable async::Channel<TrackSequenceId, TrackId, AudioOutputParams> m_outputParamsChanged;
+
+    //! NOTE Accessed from the main thread too, the export itself blocks the worker thread
+    std::mutex m_saveSoundTracksMutex;
+    std::map<TrackSequenceId, framework::Progress> m_saveSoundTracksProgressMap;
+    std::map<TrackSequenceId, std::shared_ptr<soundtrack::SoundTrackWriter> > m_saveSoundTracksWritersMap;
 };
 }
 
@@ -21,6 +21,8 @@
  */
 #include "clock.h"
 
+#include "log.h"
+
 #include "audioerrors.h"
 
 using namespace mu;
@@ -36,29 +38,56 @@ msecs_t Clock::currentTime() const
     return m_currentTime;
 }
 
-void Clock::forward(const msecs_t nextMsecs)
+samples_t Clock::currentSample() const
+{
+    return m_currentSample;
+}
+
+void Clock::setSampleRate(const sample_rate_t sampleRate)
+{
+    if (m_sampleRate == sampleRate) {
+        return;
+    }
+
+    m_sampleRate = sampleRate;
+    m_currentSample = msecsToSamples(m_currentTime, m_sampleRate);
+}
+
+void Clock::forward(const samples_t samplesPerChannel)
 {
     if (!isRunning()) {
         return;
     }
 
-    msecs_t newTime = m_currentTime + nextMsecs;
+    IF_ASSERT_FAILED(m_sampleRate > 0) {
+        return;
+    }
+
+    //! NOTE Counted in samples, so that blocks which are not a whole number of msecs don't drift
+    samples_t newSample = m_currentSample + samplesPerChannel;
+    msecs_t newTime = samplesToMsecs(newSample, m_sampleRate);
 
     if (m_timeLoopStart < m_timeLoopEnd && newTime >= m_timeLoopEnd) {
         seek(m_timeLoopStart);
 
         //!Note No matter of the time loop boundaries, the current frame still should be handled
-        setCurrentTime(m_timeLoopStart + nextMsecs);
+        setCurrentSample(msecsToSamples(m_timeLoopStart, m_sampleRate) + samplesPerChannel);
         return;
     }
 
     if (newTime >= m_timeDuration) {
-        setCurrentTime(m_timeDuration);
+        setCurrentSample(msecsToSamples(m_timeDuration, m_sampleRate));
         pause();
         return;
     }
 
-    setCurrentTime(newTime);
+    setCurrentSample(newSample);
+}
+
+void Clock::setCurrentSample(samples_t sample)
+{
+    m_currentSample = sample;
+    setCurrentTime(samplesToMsecs(sample, m_sampleRate));
 }
 
 void Clock::setCurrentTime(msecs_t time)
@@ -105,6 +134,7 @@ void Clock::seek(const msecs_t msecs)
         return;
     }
 
+    m_currentSample = msecsToSamples(msecs, m_sampleRate);
     setCurrentTime(msecs);
     m_seekOccurred.notify();
 }
@@ -33,8 +33,10 @@ public:
     Clock();
 
     msecs_t currentTime() const override;
+    samples_t currentSample() const override;
 
-    void forward(const msecs_t nextMsecs) override;
+    void setSampleRate(const sample_rate_t sampleRate) override;
+    void forward(const samples_t samplesPerChannel) override;
 
     void start() override;
     void reset() override;
@@ -55,9 +57,12 @@ public:
     async::Channel<PlaybackStatus> statusChanged() const override;
 
 private:
+    void setCurrentSample(samples_t sample);
     void setCurrentTime(msecs_t time);
 
     ValCh<PlaybackStatus> m_status;
+    sample_rate_t m_sampleRate = 0;
+    samples_t m_currentSample = 0;
     msecs_t m_currentTime = 0;
     msecs_t m_timeDuration = 0;
     msecs_t m_timeLoopStart = 0;
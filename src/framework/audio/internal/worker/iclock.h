@@ -38,8 +38,10 @@ public:
     virtual ~IClock() = default;
 
     virtual msecs_t currentTime() const = 0;
+    virtual samples_t currentSample() const = 0;
 
-    virtual void forward(const msecs_t nextMsecs) = 0;
+    virtual void setSampleRate(const sample_rate_t sampleRate) = 0;
+    virtual void forward(const samples_t samplesPerChannel) = 0;
 
     virtual void start() = 0;
     virtual void reset() = 0;
@@ -38,6 +38,11 @@ using namespace mu::async;
 Mixer::Mixer()
 {
     ONLY_AUDIO_WORKER_THREAD;
+
+    m_renderPool = std::make_unique<RenderThreadPool>();
+    m_renderJob = [this](size_t jobIdx) {
+        renderChannel(m_renderJobs[jobIdx], m_renderSamplesPerChannel);
+    };
 }
 
 Mixer::~Mixer()
@@ -64,6 +69,7 @@ RetVal<MixerChannelPtr> Mixer::addChannel(const TrackId trackId, IAudioSourcePtr
     }
 
     m_mixerChannels.emplace(trackId, std::make_shared<MixerChannel>(trackId, std::move(source), m_sampleRate));
+    m_renderJobsChanged = true;
 
     result.val = m_mixerChannels[trackId];
     result.ret = make_ret(Ret::Code::Ok);
@@ -79,6 +85,7 @@ Ret Mixer::removeChannel(const TrackId id)
 
     if (search != m_mixerChannels.end() && search->second) {
         m_mixerChannels.erase(id);
+        m_renderJobsChanged = true;
         return make_ret(Ret::Code::Ok);
     }
 
@@ -103,6 +110,10 @@ void Mixer::setSampleRate(unsigned int sampleRate)
     for (auto& channel : m_mixerChannels) {
         channel.second->setSampleRate(sampleRate);
     }
+
+    for (IClockPtr clock : m_clocks) {
+        clock->setSampleRate(sampleRate);
+    }
 }
 
 unsigned int Mixer::audioChannelsCount() const
@@ -117,23 +128,26 @@ samples_t Mixer::process(float* outBuffer, samples_t samplesPerChannel)
     ONLY_AUDIO_WORKER_THREAD;
 
     for (IClockPtr clock : m_clocks) {
-        clock->forward((samplesPerChannel * 1000) / m_sampleRate);
+        clock->forward(samplesPerChannel);
     }
 
-    std::fill(outBuffer, outBuffer + samplesPerChannel * audioChannelsCount(), 0.f);
+    const size_t bufferSize = samplesPerChannel * audioChannelsCount();
 
-    if (m_writeCacheBuff.size() != samplesPerChannel * audioChannelsCount()) {
-        m_writeCacheBuff.resize(samplesPerChannel * audioChannelsCount(), 0.f);
-    }
+    std::fill(outBuffer, outBuffer + bufferSize, 0.f);
+
+    updateRenderJobs(bufferSize);
+
+    m_renderSamplesPerChannel = samplesPerChannel;
+    m_renderPool->run(m_renderJobs.size(), m_renderJob);
 
     samples_t masterChannelSampleCount = 0;
 
-    for (auto& channel : m_mixerChannels) {
-        samples_t processedSamplesCount = channel.second->process(m_writeCacheBuff.data(), samplesPerChannel);
-        mixOutputFromChannel(outBuffer, m_writeCacheBuff.data(), processedSamplesCount);
-        std::fill(m_writeCacheBuff.begin(), m_writeCacheBuff.end(), 0.f);
+    //! NOTE Mixed in the channels order, so the result doesn't depend on which thread finished first
+    for (ChannelRenderJob& job : m_renderJobs) {
+        job.channel->notifyAboutAudioSignalChanges();
+        mixOutputFromChannel(outBuffer, job.buffer.data(), job.processedSamplesCount);
 
-        masterChannelSampleCount = std::max(processedSamplesCount, masterChannelSampleCount);
+        masterChannelSampleCount = std::max(job.processedSamplesCount, masterChannelSampleCount);
     }
 
     if (m_masterParams.muted || masterChannelSampleCount == 0) {
@@ -154,6 +168,63 @@ samples_t Mixer::process(float* outBuffer, samples_t samplesPerChannel)
     return masterChannelSampleCount;
 }
 
+void Mixer::updateRenderJobs(const size_t bufferSize)
+{
+    if (m_renderJobsChanged) {
+        m_renderJobs.resize(m_mixerChannels.size());
+
+        size_t jobIdx = 0;
+        for (const auto& channel : m_mixerChannels) {
+            m_renderJobs[jobIdx].trackId = channel.first;
+            m_renderJobs[jobIdx].channel = channel.second.get();
+            ++jobIdx;
+        }
+
+        m_renderJobsChanged = false;
+    }
+
+    for (ChannelRenderJob& job : m_renderJobs) {
+        if (job.buffer.size() != bufferSize) {
+            job.buffer.resize(bufferSize, 0.f);
+        }
+    }
+}
+
+void Mixer::renderChannel(ChannelRenderJob& job, samples_t samplesPerChannel)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    std::fill(job.buffer.begin(), job.buffer.end(), 0.f);
+    job.processedSamplesCount = job.channel->render(job.buffer.data(), samplesPerChannel);
+
+    job.renderTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+}
+
+Mixer::ChannelRenderTimes Mixer::channelRenderTimes() const
+{
+    ONLY_AUDIO_WORKER_THREAD;
+
+    ChannelRenderTimes result;
+    for (const ChannelRenderJob& job : m_renderJobs) {
+        result.emplace(job.trackId, job.renderTime);
+    }
+
+    return result;
+}
+
+const float* Mixer::channelBuffer(const TrackId trackId) const
+{
+    ONLY_AUDIO_WORKER_THREAD;
+
+    for (const ChannelRenderJob& job : m_renderJobs) {
+        if (job.trackId == trackId) {
+            return job.buffer.data();
+        }
+    }
+
+    return nullptr;
+}
+
 void Mixer::setIsActive(bool arg)
 {
     ONLY_AUDIO_WORKER_THREAD;
@@ -169,6 +240,7 @@ void Mixer::addClock(IClockPtr clock)
 {
     ONLY_AUDIO_WORKER_THREAD;
 
+    clock->setSampleRate(m_sampleRate);
     m_clocks.insert(std::move(clock));
 }
 
@@ -220,7 +292,7 @@ async::Channel<audioch_t, AudioSignalVal> Mixer::masterAudioSignalChanges() cons
     return m_audioSignalNotifier.audioSignalChanges;
 }
 
-void Mixer::mixOutputFromChannel(float* outBuffer, float* inBuffer, unsigned int samplesCount)
+void Mixer::mixOutputFromChannel(float* outBuffer, const float* inBuffer, samples_t samplesCount)
 {
     IF_ASSERT_FAILED(outBuffer && inBuffer) {
         return;
@@ -230,12 +302,11 @@ void Mixer::mixOutputFromChannel(float* outBuffer, float* inBuffer, unsigned int
         return;
     }
 
-    for (audioch_t audioChNum = 0; audioChNum < audioChannelsCount(); ++audioChNum) {
-        for (samples_t s = 0; s < samplesCount; ++s) {
-            int idx = s * audioChannelsCount() + audioChNum;
+    //! NOTE The buffers are interleaved, so all the audio channels are summed in one contiguous loop, which the compiler vectorises
+    const samples_t totalSamplesCount = samplesCount * audioChannelsCount();
 
-            outBuffer[idx] += inBuffer[idx];
-        }
+    for (samples_t idx = 0; idx < totalSamplesCount; ++idx) {
+        outBuffer[idx] += inBuffer[idx];
     }
 }
 
@@ -22,6 +22,7 @@
 #ifndef MU_AUDIO_MIXER_H
 #define MU_AUDIO_MIXER_H
 
+#include <chrono>
 #include <memory>
 #include <map>
 
@@ -30,6 +31,7 @@
 
 #include "abstractaudiosource.h"
 #include "mixerchannel.h"
+#include "renderthreadpool.h"
 #include "internal/dsp/limiter.h"
 #include "ifxresolver.h"
 #include "iclock.h"
@@ -58,6 +60,13 @@ public:
 
     async::Channel<audioch_t, AudioSignalVal> masterAudioSignalChanges() const;
 
+    //! time each channel took to render the last block
+    using ChannelRenderTimes = std::map<TrackId, std::chrono::microseconds>;
+    ChannelRenderTimes channelRenderTimes() const;
+
+    //! output of the channel rendered by the last process() call, before the master params and fx are applied
+    const float* channelBuffer(const TrackId trackId) const;
+
     // IAudioSource
     void setSampleRate(unsigned int sampleRate) override;
     unsigned int audioChannelsCount() const override;
@@ -65,11 +74,27 @@ public:
     void setIsActive(bool arg) override;
 
 private:
-    void mixOutputFromChannel(float* outBuffer, float* inBuffer, unsigned int samplesCount);
+    struct ChannelRenderJob {
+        TrackId trackId = -1;
+        MixerChannel* channel = nullptr;
+        std::vector<float> buffer;
+        samples_t processedSamplesCount = 0;
+        std::chrono::microseconds renderTime { 0 };
+    };
+
+    void updateRenderJobs(const size_t bufferSize);
+    void renderChannel(ChannelRenderJob& job, samples_t samplesPerChannel);
+
+    void mixOutputFromChannel(float* outBuffer, const float* inBuffer, samples_t samplesCount);
     void completeOutput(float* buffer, const samples_t& samplesPerChannel);
     void notifyAboutAudioSignalChanges(const audioch_t audioChannelNumber, const float linearRms) const;
 
-    std::vector<float> m_writeCacheBuff;
+    //! NOTE Each channel renders into its own buffer, the channels are rendered in parallel by the pool
+    std::vector<ChannelRenderJob> m_renderJobs;
+    bool m_renderJobsChanged = true;
+    samples_t m_renderSamplesPerChannel = 0;
+    RenderThreadPool::Job m_renderJob;
+    std::unique_ptr<RenderThreadPool> m_renderPool;
 
     AudioOutputParams m_masterParams;
     async::Channel<AudioOutputParams> m_masterOutputParamsChanged;
@@ -141,7 +141,7 @@ void MixerChannel::setSampleRate(unsigned int sampleRate)
 
 unsigned int MixerChannel::audioChannelsCount() const
 {
-    ONLY_AUDIO_WORKER_THREAD;
+    ONLY_AUDIO_WORKER_OR_RENDER_THREAD;
 
     IF_ASSERT_FAILED(m_audioSource) {
         return 0;
@@ -165,6 +165,16 @@ samples_t MixerChannel::process(float* buffer, samples_t samplesPerChannel)
 {
     ONLY_AUDIO_WORKER_THREAD;
 
+    samples_t processedSamplesCount = render(buffer, samplesPerChannel);
+    notifyAboutAudioSignalChanges();
+
+    return processedSamplesCount;
+}
+
+samples_t MixerChannel::render(float* buffer, samples_t samplesPerChannel)
+{
+    ONLY_AUDIO_WORKER_OR_RENDER_THREAD;
+
     IF_ASSERT_FAILED(m_audioSource) {
         return 0;
     }
@@ -173,10 +183,7 @@ samples_t MixerChannel::process(float* buffer, samples_t samplesPerChannel)
 
     if (processedSamplesCount == 0 || m_params.muted) {
         std::fill(buffer, buffer + samplesPerChannel * audioChannelsCount(), 0.f);
-
-        for (audioch_t audioChNum = 0; audioChNum < audioChannelsCount(); ++audioChNum) {
-            notifyAboutAudioSignalChanges(audioChNum, 0.f);
-        }
+        m_signalRms.assign(audioChannelsCount(), 0.f);
 
         return processedSamplesCount;
     }
@@ -193,9 +200,10 @@ samples_t MixerChannel::process(float* buffer, samples_t samplesPerChannel)
     return processedSamplesCount;
 }
 
-void MixerChannel::completeOutput(float* buffer, unsigned int samplesCount) const
+void MixerChannel::completeOutput(float* buffer, unsigned int samplesCount)
 {
     float totalSquaredSum = 0.f;
+    m_signalRms.resize(audioChannelsCount());
 
     for (audioch_t audioChNum = 0; audioChNum < audioChannelsCount(); ++audioChNum) {
         float singleChannelSquaredSum = 0.f;
@@ -213,9 +221,7 @@ void MixerChannel::completeOutput(float* buffer, unsigned int samplesCount) cons
             totalSquaredSum += squaredSample;
         }
 
-        float rms = dsp::samplesRootMeanSquare(singleChannelSquaredSum, samplesCount);
-
-        notifyAboutAudioSignalChanges(audioChNum, rms);
+        m_signalRms[audioChNum] = dsp::samplesRootMeanSquare(singleChannelSquaredSum, samplesCount);
     }
 
     if (!m_compressor->isActive()) {
@@ -226,7 +232,12 @@ void MixerChannel::completeOutput(float* buffer, unsigned int samplesCount) cons
     m_compressor->process(totalRms, buffer, audioChannelsCount(), samplesCount);
 }
 
-void MixerChannel::notifyAboutAudioSignalChanges(const audioch_t audioChannelNumber, const float linearRms) const
+void MixerChannel::notifyAboutAudioSignalChanges()
 {
-    m_audioSignalNotifier.updateSignalValues(audioChannelNumber, linearRms, dsp::dbFromSample(linearRms));
+    ONLY_AUDIO_WORKER_THREAD;
+
+    for (audioch_t audioChNum = 0; audioChNum < m_signalRms.size(); ++audioChNum) {
+        float linearRms = m_signalRms[audioChNum];
+        m_audioSignalNotifier.updateSignalValues(audioChNum, linearRms, dsp::dbFromSample(linearRms));
+    }
 }
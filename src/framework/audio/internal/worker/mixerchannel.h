@@ -53,9 +53,13 @@ public:
     async::Channel<unsigned int> audioChannelsCountChanged() const override;
     samples_t process(float* buffer, samples_t samplesPerChannel) override;
 
+    //! NOTE Same as process(), but the signal values are only stored, so it can be called from a render thread.
+    //! They are sent by notifyAboutAudioSignalChanges(), which must be called from the worker thread
+    samples_t render(float* buffer, samples_t samplesPerChannel);
+    void notifyAboutAudioSignalChanges();
+
 private:
-    void completeOutput(float* buffer, unsigned int samplesCount) const;
-    void notifyAboutAudioSignalChanges(const audioch_t audioChannelNumber, const float linearRms) const;
+    void completeOutput(float* buffer, unsigned int samplesCount);
 
     TrackId m_trackId = -1;
 
@@ -68,6 +72,7 @@ private:
     dsp::CompressorPtr m_compressor = nullptr;
 
     mutable async::Channel<AudioOutputParams> m_paramsChanges;
+    std::vector<float> m_signalRms;
     mutable AudioSignalsNotifier m_audioSignalNotifier;
 };
 
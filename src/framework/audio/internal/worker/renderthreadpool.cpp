@@ -0,0 +1,159 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "renderthreadpool.h"
+
+#include <algorithm>
+#include <string>
+
+#include "runtime.h"
+#include "log.h"
+
+#include "internal/audiosanitizer.h"
+
+using namespace mu::audio;
+
+static constexpr size_t MAX_THREAD_COUNT = 8;
+
+RenderThreadPool::RenderThreadPool(size_t threadCount)
+{
+    threadCount = std::min(threadCount, MAX_THREAD_COUNT);
+    m_threads.reserve(threadCount);
+
+    for (size_t i = 0; i < threadCount; ++i) {
+        m_threads.emplace_back([this, i]() {
+            threadMain(i);
+        });
+    }
+}
+
+RenderThreadPool::~RenderThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_running = false;
+    }
+
+    m_wakeUp.notify_all();
+
+    for (std::thread& thread : m_threads) {
+        thread.join();
+    }
+}
+
+size_t RenderThreadPool::defaultThreadCount()
+{
+    //! NOTE The calling thread renders too, so one core is left for it
+    size_t cores = std::thread::hardware_concurrency();
+    return cores > 1 ? cores - 1 : 0;
+}
+
+size_t RenderThreadPool::threadCount() const
+{
+    return m_threads.size();
+}
+
+void RenderThreadPool::run(size_t jobCount, const Job& job)
+{
+    if (jobCount == 0) {
+        return;
+    }
+
+    if (m_threads.empty() || jobCount == 1) {
+        for (size_t i = 0; i < jobCount; ++i) {
+            job(i);
+        }
+        return;
+    }
+
+    IF_ASSERT_FAILED(jobCount <= MAX_JOB_COUNT) {
+        jobCount = MAX_JOB_COUNT;
+    }
+
+    m_job = &job;
+    m_finishedJobs.store(0, std::memory_order_relaxed);
+
+    m_generation = (m_generation + 1) & 0xFFFF;
+    m_state.store((m_generation << (2 * INDEX_BITS)) | (uint64_t(jobCount) << INDEX_BITS));
+
+    //! NOTE The mutex is taken so that a thread can't miss the notification between checking for work and waiting
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+    }
+    m_wakeUp.notify_all();
+
+    executeJobs();
+
+    while (m_finishedJobs.load(std::memory_order_acquire) < jobCount) {
+        std::this_thread::yield();
+    }
+}
+
+bool RenderThreadPool::hasWork() const
+{
+    uint64_t state = m_state.load(std::memory_order_acquire);
+    return (state & INDEX_MASK) < ((state >> INDEX_BITS) & INDEX_MASK);
+}
+
+void RenderThreadPool::executeJobs()
+{
+    uint64_t state = m_state.load(std::memory_order_acquire);
+
+    while (true) {
+        uint64_t jobIdx = state & INDEX_MASK;
+        uint64_t jobCount = (state >> INDEX_BITS) & INDEX_MASK;
+
+        if (jobIdx >= jobCount) {
+            return;
+        }
+
+        //! NOTE The whole state takes part in the comparison, so a job of an already finished run can't be claimed
+        if (!m_state.compare_exchange_weak(state, state + 1, std::memory_order_acq_rel, std::memory_order_acquire)) {
+            continue;
+        }
+
+        (*m_job)(jobIdx);
+
+        m_finishedJobs.fetch_add(1, std::memory_order_release);
+        state = m_state.load(std::memory_order_acquire);
+    }
+}
+
+void RenderThreadPool::threadMain(size_t threadIdx)
+{
+    mu::runtime::setThreadName("audio_render_" + std::to_string(threadIdx));
+    AudioSanitizer::setupRenderThread();
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(m_sleepMutex);
+            m_wakeUp.wait(lock, [this]() {
+                return hasWork() || !m_running;
+            });
+        }
+
+        if (!m_running) {
+            return;
+        }
+
+        executeJobs();
+    }
+}
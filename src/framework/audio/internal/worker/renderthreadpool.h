@@ -0,0 +1,77 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_AUDIO_RENDERTHREADPOOL_H
+#define MU_AUDIO_RENDERTHREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mu::audio {
+//! NOTE Fixed set of threads which help the audio worker to render independent jobs (e.g. mixer channels).
+//! Jobs are claimed with a single atomic compare-and-swap, no lock is taken while there is work.
+//! Idle threads wait on a condition variable until the next run.
+//! The pool threads are registered in AudioSanitizer as render threads,
+//! because they execute worker code on behalf of the worker thread, which waits for them.
+class RenderThreadPool
+{
+public:
+    using Job = std::function<void (size_t jobIdx)>;
+
+    explicit RenderThreadPool(size_t threadCount = defaultThreadCount());
+    ~RenderThreadPool();
+
+    static size_t defaultThreadCount();
+
+    size_t threadCount() const;
+
+    //! Calls job(0) ... job(jobCount - 1) on the pool threads and on the calling thread,
+    //! returns when all of them are finished. Must be called from one thread at a time.
+    void run(size_t jobCount, const Job& job);
+
+private:
+    void threadMain(size_t threadIdx);
+    bool hasWork() const;
+    void executeJobs();
+
+    //! NOTE generation (16 bits) | job count (24 bits) | next job index (24 bits)
+    static constexpr uint64_t INDEX_BITS = 24;
+    static constexpr uint64_t INDEX_MASK = (uint64_t(1) << INDEX_BITS) - 1;
+    static constexpr size_t MAX_JOB_COUNT = INDEX_MASK;
+
+    std::vector<std::thread> m_threads;
+    const Job* m_job = nullptr;
+
+    alignas(64) std::atomic<uint64_t> m_state = 0;
+    alignas(64) std::atomic<size_t> m_finishedJobs = 0;
+    uint64_t m_generation = 0;
+
+    std::atomic<bool> m_running = true;
+    std::mutex m_sleepMutex;
+    std::condition_variable m_wakeUp;
+};
+}
+
+#endif // MU_AUDIO_RENDERTHREADPOOL_H
@@ -20,191 +20,320 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 #include "samplerateconvertor.h"
-#include "log.h"
+
+#include <algorithm>
 #include <cmath>
+#include <map>
+#include <mutex>
+#include <numeric>
+
+#include "log.h"
 
 using namespace mu::audio;
 
+//! the passband ends slightly below the Nyquist frequency, so the transition band fits into the filter length
+static constexpr double PASSBAND_ROLLOFF = 0.9;
+//! Kaiser window parameter, about 90 dB stopband attenuation
+static constexpr double KAISER_BETA = 8.6;
+//! ratios which need more phases use MAX_PHASES_COUNT phases with linear interpolation between them
+static constexpr uint64_t MAX_PHASES_COUNT = 512;
+
+struct SampleRateConvertor::FilterTable {
+    uint64_t L = 1;
+    uint64_t M = 1;
+    uint64_t phasesCount = 1;
+    bool isExact = true;
+
+    //! phasesCount + 1 rows of TAPS_COUNT coefficients, the last row is the phase 0 shifted by one sample
+    std::vector<float> coefficients;
+
+    const float* row(uint64_t phaseIdx) const
+    {
+        return coefficients.data() + phaseIdx * TAPS_COUNT;
+    }
+};
+
+static double zeroBessel(double x)
+{
+    double sum = 1.0;
+    double term = 1.0;
+
+    for (int k = 1; term > sum * 1e-12; ++k) {
+        double factor = x / (2.0 * k);
+        term *= factor * factor;
+        sum += term;
+    }
+
+    return sum;
+}
+
+static float dotProduct(const float* a, const float* b, size_t size)
+{
+    //! NOTE Independent partial sums let the compiler vectorise the loop
+    float sums[8] = {};
+
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        for (size_t j = 0; j < 8; ++j) {
+            sums[j] += a[i + j] * b[i + j];
+        }
+    }
+
+    float result = std::accumulate(std::begin(sums), std::end(sums), 0.f);
+    for (; i < size; ++i) {
+        result += a[i] * b[i];
+    }
+
+    return result;
+}
+
+std::shared_ptr<const SampleRateConvertor::FilterTable> SampleRateConvertor::filterTable(unsigned int sampleRateIn,
+                                                                                           unsigned int sampleRateOut)
+{
+    static std::mutex s_mutex;
+    static std::map<std::pair<unsigned int, unsigned int>, std::shared_ptr<const FilterTable> > s_tables;
+
+    std::lock_guard<std::mutex> lock(s_mutex);
+
+    auto key = std::make_pair(sampleRateIn, sampleRateOut);
+    auto it = s_tables.find(key);
+    if (it != s_tables.end()) {
+        return it->second;
+    }
+
+    auto table = std::make_shared<FilterTable>();
+
+    uint64_t divider = std::gcd(sampleRateIn, sampleRateOut);
+    table->L = sampleRateOut / divider;
+    table->M = sampleRateIn / divider;
+    table->isExact = table->L <= MAX_PHASES_COUNT;
+    table->phasesCount = table->isExact ? table->L : MAX_PHASES_COUNT;
+
+    const double cutoff = std::min(1.0, static_cast<double>(sampleRateOut) / sampleRateIn) * PASSBAND_ROLLOFF;
+    const double radius = TAPS_COUNT / 2;
+    const double windowNorm = zeroBessel(KAISER_BETA);
+
+    table->coefficients.resize((table->phasesCount + 1) * TAPS_COUNT);
+
+    for (uint64_t phaseIdx = 0; phaseIdx <= table->phasesCount; ++phaseIdx) {
+        double fraction = static_cast<double>(phaseIdx) / table->phasesCount;
+        float* row = table->coefficients.data() + phaseIdx * TAPS_COUNT;
+        double sum = 0.0;
+
+        for (unsigned int tap = 0; tap < TAPS_COUNT; ++tap) {
+            //! NOTE The tap applies to the input sample at the offset (tap - TAPS_COUNT / 2 + 1) from the output position floor
+            double x = static_cast<double>(tap) - TAPS_COUNT / 2 + 1 - fraction;
+            double sincArg = M_PI * cutoff * x;
+            double sinc = x == 0 ? 1.0 : std::sin(sincArg) / sincArg;
+            double r = x / radius;
+            double window = r * r < 1.0 ? zeroBessel(KAISER_BETA * std::sqrt(1.0 - r * r)) / windowNorm : 0.0;
+
+            row[tap] = static_cast<float>(sinc * window);
+            sum += row[tap];
+        }
+
+        //! NOTE Unity gain for every phase, so constant input stays constant
+        for (unsigned int tap = 0; tap < TAPS_COUNT; ++tap) {
+            row[tap] = static_cast<float>(row[tap] / sum);
+        }
+    }
+
+    s_tables.emplace(key, table);
+
+    return table;
+}
+
 SampleRateConvertor::SampleRateConvertor(const std::vector<float>& data,
                                          unsigned int channelsCount,
                                          unsigned int sampleRateIn,
                                          unsigned int sampleRateOut)
-    : m_data(data), m_fir(), m_channelsCount(channelsCount), m_sampleRateIn(sampleRateIn), m_sampleRateOut(sampleRateOut)
+    : m_data(data), m_channelsCount(channelsCount), m_sampleRateIn(sampleRateIn), m_sampleRateOut(sampleRateOut)
 {
-    m_fir.resize(FIR_LENGTH, 0);
-    m_y.resize(FIR_LENGTH, 0);
-    initWindow();
+    updateFilterTable();
 }
 
 std::vector<float> SampleRateConvertor::convert()
 {
-    std::vector<float> out;
-    auto resultSamples = m_data.size() * m_sampleRateOut / (m_channelsCount * m_sampleRateIn);
-
-    out.resize(resultSamples * m_channelsCount);
-    for (unsigned sample = 0; sample < resultSamples; ++sample) {
-        for (unsigned int channel = 0; channel < m_channelsCount; ++channel) {
-            out[sample * m_channelsCount + channel] = y(sample, channel);
-        }
+    if (m_channelsCount == 0) {
+        return {};
     }
 
+    uint64_t inputFrames = m_data.size() / m_channelsCount;
+    uint64_t resultSamples = inputFrames * m_filter->L / m_filter->M;
+
+    std::vector<float> out(resultSamples * m_channelsCount);
+    resample(m_data.data(), inputFrames, 0, resultSamples, out.data());
+
     return out;
 }
 
 unsigned int SampleRateConvertor::convert(float* buffer, unsigned int from, unsigned int count)
 {
-    unsigned int sample = from;
-    unsigned int converted = 0;
+    if (m_channelsCount == 0) {
+        return 0;
+    }
 
-    for (converted = 0; converted < count; ++converted, ++sample) {
-        for (unsigned int channel = 0; channel < m_channelsCount; ++channel) {
-            if (!availableSamples(sample)) {
-                return converted;
-            }
-            buffer[converted * m_channelsCount + channel] = y(sample, channel);
-        }
+    uint64_t inputFrames = m_data.size() / m_channelsCount;
+
+    //! NOTE The output sample is available while its position is inside of the input
+    uint64_t availableSamples = (inputFrames * m_filter->L + m_filter->M - 1) / m_filter->M;
+    if (from >= availableSamples) {
+        return 0;
     }
+
+    unsigned int converted = static_cast<unsigned int>(std::min<uint64_t>(count, availableSamples - from));
+    resample(m_data.data(), inputFrames, static_cast<uint64_t>(from) * m_filter->M, converted, buffer);
+
     return converted;
 }
 
-float SampleRateConvertor::y(unsigned int sample, unsigned int channel) const
+void SampleRateConvertor::setupStream(size_t maxInputFrames)
 {
-    switch (m_method) {
-    case SINC:
-        return ySinc(sample, channel);
-    case FIR:
-        return yFIR(sample, channel);
-    }
-    return 0.f;
-}
+    //! NOTE At most TAPS_COUNT frames of the history are kept between the blocks,
+    //! and the window of a block reaches TAPS_COUNT / 2 + 1 frames out of it on both sides
+    m_streamMaxInputFrames = maxInputFrames;
+    m_streamInput.resize((maxInputFrames + TAPS_COUNT) * m_channelsCount);
+    m_window.reserve(maxInputFrames + 2 * TAPS_COUNT + 2);
 
-void SampleRateConvertor::setChannelCount(unsigned int count)
-{
-    m_channelsCount = count;
+    resetStream();
 }
 
-void SampleRateConvertor::setSampleRateIn(unsigned int sampleRate)
+size_t SampleRateConvertor::process(const float* input, size_t inputFrames, float* output)
 {
-    if (m_sampleRateIn != sampleRate) {
-        m_sampleRateIn = sampleRate;
-        initWindow();
+    const size_t inputSamples = inputFrames * m_channelsCount;
+    if (m_streamInputSize + inputSamples > m_streamInput.size()) {
+        //! NOTE Only if the stream wasn't set up for blocks of this size
+        m_streamInput.resize(m_streamInputSize + inputSamples);
     }
-}
 
-void SampleRateConvertor::setSampleRateOut(unsigned int sampleRate)
-{
-    if (m_sampleRateOut != sampleRate) {
-        m_sampleRateOut = sampleRate;
-        initWindow();
+    std::copy(input, input + inputSamples, m_streamInput.begin() + m_streamInputSize);
+    m_streamInputSize += inputSamples;
+    m_streamInputFrames += inputFrames;
+
+    const int64_t bufferedFrames = m_streamInputSize / m_channelsCount;
+    const uint64_t L = m_filter->L;
+
+    //! NOTE Only the output which doesn't need the future input
+    size_t count = 0;
+    while (static_cast<int64_t>((m_streamTime + count * m_filter->M) / L) + TAPS_COUNT / 2 < bufferedFrames) {
+        ++count;
+    }
+
+    resample(m_streamInput.data(), bufferedFrames, m_streamTime, count, output);
+    m_streamTime += count * m_filter->M;
+    m_streamOutputFrames += count;
+
+    //! NOTE Keep the input needed by the next output sample
+    int64_t firstNeededFrame = static_cast<int64_t>(m_streamTime / L) - TAPS_COUNT / 2 + 1;
+    if (firstNeededFrame > 0) {
+        const size_t firstNeededSample = firstNeededFrame * m_channelsCount;
+        std::copy(m_streamInput.begin() + firstNeededSample, m_streamInput.begin() + m_streamInputSize, m_streamInput.begin());
+        m_streamInputSize -= firstNeededSample;
+        m_streamTime -= firstNeededFrame * L;
     }
+
+    return count;
 }
 
-float SampleRateConvertor::ySinc(unsigned int sample, unsigned int channel) const
+size_t SampleRateConvertor::flush(float* output)
 {
-    double currentOutputSampleTime = sample / static_cast<double>(m_sampleRateOut);
-    auto zeroInputSample = std::floor(currentOutputSampleTime * m_sampleRateIn);
+    const uint64_t totalOutputFrames = m_streamInputFrames * m_filter->L / m_filter->M;
+    const int64_t bufferedFrames = m_streamInputSize / m_channelsCount;
 
-    float out = 0.f;
-    for (unsigned int i = 0; i < USE_SAMPLES; ++i) {
-        int currentSample = zeroInputSample + i - USE_SAMPLES / 2;
-        double currentInputSampleTime = currentSample / static_cast<double>(m_sampleRateIn);
+    size_t count = totalOutputFrames > m_streamOutputFrames ? totalOutputFrames - m_streamOutputFrames : 0;
+    resample(m_streamInput.data(), bufferedFrames, m_streamTime, count, output);
 
-        if (currentSample < 0 || currentSample * m_channelsCount + channel >= m_data.size()) {
-            continue;
-        }
-        out += m_data.at(currentSample * m_channelsCount + channel) * sinc(currentOutputSampleTime - currentInputSampleTime);
-    }
-    return out;
+    resetStream();
+
+    return count;
 }
 
-float SampleRateConvertor::yFIR(unsigned int sample, unsigned int channel) const
+size_t SampleRateConvertor::maxOutputFrames(size_t inputFrames) const
 {
-    auto x = [this, &channel](int m) -> float {
-        int pos = m * m_M / m_L * m_channelsCount + channel;
-        if (pos >= 0 && pos < static_cast<int>(m_data.size())) {
-            return m_data.at(pos);
-        }
-        return 0.f;
-    };
+    return (inputFrames + TAPS_COUNT) * m_filter->L / m_filter->M + 1;
+}
 
-    float y = 0.f;
-    for (unsigned int i = 0; i < FIR_LENGTH; ++i) {
-        int t = sample - static_cast<int>(i);
-        y += x(t) * m_fir[i];
-    }
-    return y;
+void SampleRateConvertor::resetStream()
+{
+    m_streamInputSize = 0;
+    m_streamTime = 0;
+    m_streamInputFrames = 0;
+    m_streamOutputFrames = 0;
 }
 
-bool SampleRateConvertor::availableSamples(unsigned int sample) const
+void SampleRateConvertor::setChannelCount(unsigned int count)
 {
-    float currentOutputSampleTime = sample / static_cast<float>(m_sampleRateOut);
-    auto firstInputSample = std::floor(currentOutputSampleTime * m_sampleRateIn) - USE_SAMPLES / 2;
+    m_channelsCount = count;
+    setupStream(m_streamMaxInputFrames);
+}
 
-    // first sample for conversion points out of the input buffer
-    if (firstInputSample * m_channelsCount >= m_data.size()) {
-        return false;
+void SampleRateConvertor::setSampleRateIn(unsigned int sampleRate)
+{
+    if (m_sampleRateIn != sampleRate) {
+        m_sampleRateIn = sampleRate;
+        updateFilterTable();
     }
-    return true;
 }
 
-inline double zeroBessel(double x)
+void SampleRateConvertor::setSampleRateOut(unsigned int sampleRate)
 {
-    //return std::cyl_bessel_i(0, x);
-
-    double s = 1, y = 1;
-    int m = 1;
+    if (m_sampleRateOut != sampleRate) {
+        m_sampleRateOut = sampleRate;
+        updateFilterTable();
+    }
+}
 
-    while (y > std::numeric_limits<float>::min()) {
-        m += 2;
-        y *= x * x / (4 * m * m);
-        s += s * y;
+void SampleRateConvertor::updateFilterTable()
+{
+    IF_ASSERT_FAILED(m_sampleRateIn > 0 && m_sampleRateOut > 0) {
+        return;
     }
 
-    return s;
+    m_filter = filterTable(m_sampleRateIn, m_sampleRateOut);
+    resetStream();
 }
 
-void SampleRateConvertor::initWindow()
+void SampleRateConvertor::resample(const float* input, int64_t inputFrames, uint64_t firstOutputTime, size_t count, float* output)
 {
-    int max = std::max(m_sampleRateIn, m_sampleRateOut), min = std::min(m_sampleRateIn, m_sampleRateOut);
-    int maxCommonDivider = 1;
-    while (max % min != 0) {
-        maxCommonDivider = max % min;
-        max = min;
-        min = maxCommonDivider;
+    if (count == 0) {
+        return;
     }
-    m_M = m_sampleRateIn / maxCommonDivider;
-    m_L = m_sampleRateOut / maxCommonDivider;
-    double fStop = std::min(m_sampleRateIn, m_sampleRateOut) / 2,
-           fIntermediateSampleRate = m_sampleRateIn * m_M,
-           attenuation = 96 /*dB*/;
-    int M = FIR_LENGTH;
-    int Np = (M - 1) / 2;
 
-    double alpha = 0.1102 * (attenuation - 8.7);
-    double A[FIR_LENGTH];
+    const uint64_t L = m_filter->L;
+    const uint64_t M = m_filter->M;
+    const uint64_t lastOutputTime = firstOutputTime + (count - 1) * M;
 
-    A[0] = 2 * fStop / fIntermediateSampleRate;
-    for (int j = 1; j <= Np; j++) {
-        A[j]  = std::sin(2 * j * M_PI * fStop / fIntermediateSampleRate) / j * M_PI;
-    }
+    //! NOTE The input of one channel is copied into a contiguous window, so the inner products run over contiguous memory
+    const int64_t windowStart = static_cast<int64_t>(firstOutputTime / L) - TAPS_COUNT / 2 + 1;
+    const int64_t windowEnd = static_cast<int64_t>(lastOutputTime / L) + TAPS_COUNT / 2 + 1;
+    m_window.resize(windowEnd - windowStart);
 
-    for (int j = 0; j <= Np; j++) {
-        m_fir[Np + j]  = A[j];
-        m_fir[Np + j] *= zeroBessel(alpha * std::sqrt(1 - (j * j / (Np * Np))));
-        m_fir[Np + j] /= zeroBessel(alpha);
-    }
+    for (unsigned int channel = 0; channel < m_channelsCount; ++channel) {
+        for (int64_t frame = windowStart; frame < windowEnd; ++frame) {
+            bool inside = frame >= 0 && frame < inputFrames;
+            m_window[frame - windowStart] = inside ? input[frame * m_channelsCount + channel] : 0.f;
+        }
 
-    for (int j = 0; j < Np; j++) {
-        m_fir[j] = m_fir[M - 1 - j];
+        uint64_t time = firstOutputTime;
+        for (size_t i = 0; i < count; ++i, time += M) {
+            const float* window = m_window.data() + (static_cast<int64_t>(time / L) - TAPS_COUNT / 2 + 1 - windowStart);
+            output[i * m_channelsCount + channel] = outputSample(window, time % L);
+        }
     }
 }
 
-double SampleRateConvertor::sinc(double value) const
+float SampleRateConvertor::outputSample(const float* window, uint64_t phase) const
 {
-    if (value == 0) {
-        return 1.f;
+    if (m_filter->isExact) {
+        return dotProduct(window, m_filter->row(phase), TAPS_COUNT);
     }
-    double sincArg = M_PI * value * m_sampleRateIn;
-    double gain = std::min(1.0, m_sampleRateOut / static_cast<double>(m_sampleRateIn));
-    return gain * std::sin(sincArg) / sincArg;
+
+    double position = static_cast<double>(phase) * m_filter->phasesCount / m_filter->L;
+    uint64_t phaseIdx = static_cast<uint64_t>(position);
+    float fraction = static_cast<float>(position - phaseIdx);
+
+    float first = dotProduct(window, m_filter->row(phaseIdx), TAPS_COUNT);
+    float second = dotProduct(window, m_filter->row(phaseIdx + 1), TAPS_COUNT);
+
+    return first + (second - first) * fraction;
 }
@@ -22,15 +22,19 @@
 #ifndef MU_AUDIO_SAMPLERATECONVERTOR_H
 #define MU_AUDIO_SAMPLERATECONVERTOR_H
 
+#include <cstdint>
+#include <memory>
 #include <vector>
-#include <deque>
+
 namespace mu::audio {
+//! NOTE Polyphase windowed-sinc resampler.
+//! The output sample n lies at the input position n * M / L, where L / M is the reduced ratio of the sample rates.
+//! The filter coefficients for each of the L positions between two input samples (phases) are computed once
+//! per pair of sample rates and shared between the convertors. Every output sample is then an inner product
+//! of TAPS_COUNT input samples with the coefficients of its phase
 class SampleRateConvertor
 {
 public:
-    enum Method {
-        SINC, FIR
-    };
     explicit SampleRateConvertor(const std::vector<float>& data, unsigned int channelsCount, unsigned int sampleRateIn,
                                  unsigned int sampleRateOut);
 
@@ -40,39 +44,50 @@ public:
     //! online convert
     unsigned int convert(float* buffer, unsigned int from, unsigned int count);
 
+    //! streaming convert: allocates the buffers for blocks of up to maxInputFrames, so that process() doesn't allocate
+    void setupStream(size_t maxInputFrames);
+    //! streaming convert: converts the next block of interleaved input, the filter history is kept between the calls.
+    //! The output must have room for maxOutputFrames(inputFrames) frames, returns the number of written frames
+    size_t process(const float* input, size_t inputFrames, float* output);
+    //! streaming convert: writes the output which is still delayed by the filter, the stream is reset then
+    size_t flush(float* output);
+    size_t maxOutputFrames(size_t inputFrames) const;
+    void resetStream();
+
     void setChannelCount(unsigned int count);
     void setSampleRateIn(unsigned int sampleRate);
     void setSampleRateOut(unsigned int sampleRate);
 
-private:
+    static const unsigned int TAPS_COUNT = 64; //!< this value defines the quality and complexity of SRC.
 
-    //! return value of sinc function (LPF) with consideration of used sampleRates
-    double sinc(double value) const;
+private:
+    struct FilterTable;
 
-    //! output sample value
-    float y(unsigned int sample, unsigned int channel) const;
-    float ySinc(unsigned int sample, unsigned int channel) const;
-    float yFIR(unsigned int sample, unsigned int channel) const;
+    static std::shared_ptr<const FilterTable> filterTable(unsigned int sampleRateIn, unsigned int sampleRateOut);
+    void updateFilterTable();
 
-    //! return true if there are samples in input buffer for conversion
-    bool availableSamples(unsigned int sample) const;
+    //! writes count output frames, the first one at the position firstOutputTime / L of the input,
+    //! input frames outside of [0, inputFrames) are taken as silence
+    void resample(const float* input, int64_t inputFrames, uint64_t firstOutputTime, size_t count, float* output);
 
-    //! calculate window function values
-    void initWindow();
+    float outputSample(const float* window, uint64_t phase) const;
 
-    const static unsigned int USE_SAMPLES = 16; //!< this value defines the quality and complexity of SRC.
     const std::vector<float>& m_data;
 
-    //! values of window function for USE_SAMPLES
-    const static unsigned int FIR_LENGTH = 33;
-    unsigned int m_M = 1, m_L = 1;
-    std::vector<float> m_fir;
-    mutable std::deque<float> m_y;
-
     unsigned int m_channelsCount;
     unsigned int m_sampleRateIn;
     unsigned int m_sampleRateOut;
-    Method m_method = FIR;
+
+    std::shared_ptr<const FilterTable> m_filter;
+    std::vector<float> m_window;
+
+    //! fixed-capacity history, only the first m_streamInputSize samples are used
+    std::vector<float> m_streamInput;
+    size_t m_streamInputSize = 0;
+    size_t m_streamMaxInputFrames = 0;
+    uint64_t m_streamTime = 0;
+    uint64_t m_streamInputFrames = 0;
+    uint64_t m_streamOutputFrames = 0;
 };
 }
 
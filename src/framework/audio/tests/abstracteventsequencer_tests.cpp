@@ -0,0 +1,261 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <utility>
+#include <vector>
+
+#include "audio/abstracteventsequencer.h"
+
+using namespace mu;
+using namespace mu::audio;
+
+namespace mu::audio {
+class TestSequencer : public AbstractEventSequencer<int>
+{
+public:
+    using TimedValues = std::vector<std::pair<msecs_t, int> >;
+
+    //! NOTE One sample per msec by default, so that the blocks are easy to follow
+    TestSequencer(const sample_rate_t sampleRate = 1000)
+    {
+        setSampleRate(sampleRate);
+    }
+
+    void updateOffStreamEvents(const mpe::PlaybackEventsMap&) override {}
+    void updateMainStreamEvents(const mpe::PlaybackEventsMap&) override {}
+    void updateDynamicChanges(const mpe::DynamicLevelMap&) override {}
+
+    void setMainStream(const TimedValues& values)
+    {
+        fill(m_mainStream, values);
+    }
+
+    void setOffStream(const TimedValues& values)
+    {
+        fill(m_offStream, values);
+    }
+
+    void setDynamics(const TimedValues& values)
+    {
+        fill(m_dynamicStream, values);
+    }
+
+    size_t resultCapacity() const
+    {
+        return m_result.capacity();
+    }
+
+private:
+    void fill(EventStream& stream, const TimedValues& values)
+    {
+        EventTimeline& timeline = beginUpdate(stream);
+
+        for (const auto& pair : values) {
+            timeline.add(pair.first, pair.second);
+        }
+
+        commitUpdate(stream);
+    }
+};
+}
+
+class Audio_AbstractEventSequencerTests : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        AudioSanitizer::setupWorkerThread();
+    }
+
+    std::vector<int> play(TestSequencer& sequencer, samples_t samplesPerChannel)
+    {
+        const TestSequencer::EventSequence& sequence = sequencer.eventsToBePlayed(samplesPerChannel);
+
+        std::vector<int> result;
+        for (const TestSequencer::BlockEvent& blockEvent : sequence) {
+            result.push_back(std::get<int>(blockEvent.event));
+        }
+
+        return result;
+    }
+
+    std::vector<samples_t> playFrames(TestSequencer& sequencer, samples_t samplesPerChannel)
+    {
+        const TestSequencer::EventSequence& sequence = sequencer.eventsToBePlayed(samplesPerChannel);
+
+        std::vector<samples_t> result;
+        for (const TestSequencer::BlockEvent& blockEvent : sequence) {
+            result.push_back(blockEvent.frameOffset);
+        }
+
+        return result;
+    }
+};
+
+TEST_F(Audio_AbstractEventSequencerTests, MainStreamIsPlayedInTimeOrder)
+{
+    //! GIVEN Unsorted events with a duplicate, as the subclasses append them
+    TestSequencer sequencer;
+    sequencer.setMainStream({ { 20, 3 }, { 0, 2 }, { 0, 1 }, { 40, 4 }, { 0, 1 } });
+    sequencer.setActive(true);
+
+    //! WHEN Playing blocks of 10ms
+    //! THEN Each timestamp is played once, in the block it belongs to, events of one timestamp are sorted
+    EXPECT_EQ(play(sequencer, 10), std::vector<int>({ 1, 2 }));
+    EXPECT_EQ(play(sequencer, 10), std::vector<int>());
+    EXPECT_EQ(play(sequencer, 10), std::vector<int>({ 3 }));
+    EXPECT_EQ(play(sequencer, 10), std::vector<int>());
+    EXPECT_EQ(play(sequencer, 10), std::vector<int>({ 4 }));
+    EXPECT_EQ(play(sequencer, 10), std::vector<int>());
+}
+
+TEST_F(Audio_AbstractEventSequencerTests, BlockSpanningSeveralTimestamps)
+{
+    //! GIVEN Events closer to each other than the block duration, plus dynamics
+    TestSequencer sequencer;
+    sequencer.setMainStream({ { 0, 1 }, { 2, 2 }, { 5, 3 }, { 30, 4 } });
+    sequencer.setDynamics({ { 3, 100 } });
+    sequencer.setActive(true);
+
+    //! WHEN Playing a block of 10ms
+    //! THEN All the events of the block are played together, the dynamics in between by time
+    EXPECT_EQ(play(sequencer, 10), std::vector<int>({ 1, 2, 100, 3 }));
+    EXPECT_EQ(play(sequencer, 10), std::vector<int>());
+}
+
+TEST_F(Audio_AbstractEventSequencerTests, PlaybackPositionMovesCursors)
+{
+    //! GIVEN Main stream events
+    TestSequencer sequencer;
+    sequencer.setMainStream({ { 0, 1 }, { 100, 2 }, { 200, 3 } });
+    sequencer.setActive(true);
+
+    //! WHEN Seeking into the middle
+    sequencer.setPlaybackPosition(150);
+
+    //! THEN Playback continues from the seeked position
+    EXPECT_EQ(play(sequencer, 10), std::vector<int>());
+    sequencer.setPlaybackPosition(195);
+    EXPECT_EQ(play(sequencer, 10), std::vector<int>({ 3 }));
+
+    //! WHEN Seeking back to the start
+    sequencer.setPlaybackPosition(0);
+
+    //! THEN The first event is played again
+    EXPECT_EQ(play(sequencer, 1), std::vector<int>({ 1 }));
+}
+
+TEST_F(Audio_AbstractEventSequencerTests, UpdateKeepsPlaybackPosition)
+{
+    //! GIVEN Sequencer that has already played some events
+    TestSequencer sequencer;
+    sequencer.setMainStream({ { 0, 1 }, { 10, 2 }, { 20, 3 } });
+    sequencer.setActive(true);
+    EXPECT_EQ(play(sequencer, 5), std::vector<int>({ 1 }));
+
+    //! WHEN The main stream is replaced
+    sequencer.setMainStream({ { 0, 10 }, { 10, 20 }, { 20, 30 } });
+
+    //! THEN Only the events after the current position are played
+    EXPECT_EQ(play(sequencer, 10), std::vector<int>({ 20 }));
+}
+
+TEST_F(Audio_AbstractEventSequencerTests, OffStreamIsPlayedOnceWhenInactive)
+{
+    //! GIVEN Inactive sequencer with off stream events
+    TestSequencer sequencer;
+    sequencer.setOffStream({ { 0, 1 }, { 0, 2 }, { 50, 3 } });
+
+    //! WHEN Requesting events
+    //! THEN One timestamp is played per block, and nothing is repeated
+    EXPECT_EQ(play(sequencer, 10), std::vector<int>({ 1, 2 }));
+    EXPECT_EQ(play(sequencer, 10), std::vector<int>({ 3 }));
+    EXPECT_EQ(play(sequencer, 10), std::vector<int>());
+}
+
+TEST_F(Audio_AbstractEventSequencerTests, PlayingDoesNotGrowResult)
+{
+    //! GIVEN Many events sharing few timestamps
+    TestSequencer sequencer;
+    TestSequencer::TimedValues values;
+    for (int i = 0; i < 1000; ++i) {
+        values.push_back({ (i % 10) * 10, i });
+    }
+
+    sequencer.setMainStream(values);
+    sequencer.setActive(true);
+
+    size_t capacity = sequencer.resultCapacity();
+    EXPECT_GE(capacity, 100);
+
+    //! WHEN Playing the whole stream in a single long block
+    size_t played = 0;
+    for (int block = 0; block < 10; ++block) {
+        played += play(sequencer, 1000).size();
+    }
+
+    //! THEN Everything is played without reallocating the result, the overflow is deferred to the next blocks
+    EXPECT_EQ(played, values.size());
+    EXPECT_EQ(sequencer.resultCapacity(), capacity);
+}
+
+TEST_F(Audio_AbstractEventSequencerTests, EventsGetFrameOffsets)
+{
+    //! GIVEN Events inside a block at 48kHz
+    TestSequencer sequencer(48000);
+    sequencer.setMainStream({ { 0, 1 }, { 1, 2 }, { 7, 3 }, { 10, 4 } });
+    sequencer.setActive(true);
+
+    //! WHEN Playing blocks of 10ms
+    //! THEN Every event starts at the frame of its timestamp within the block
+    EXPECT_EQ(playFrames(sequencer, 480), std::vector<samples_t>({ 0, 48, 336 }));
+    EXPECT_EQ(playFrames(sequencer, 480), std::vector<samples_t>({ 0 }));
+}
+
+TEST_F(Audio_AbstractEventSequencerTests, NoDriftWithFractionalBlocks)
+{
+    //! GIVEN Event at 1s, and blocks which are not a whole number of msecs at 44.1kHz
+    TestSequencer sequencer(44100);
+    sequencer.setMainStream({ { 0, 1 }, { 1000, 2 } });
+    sequencer.setActive(true);
+
+    const samples_t blockSize = 512;
+
+    //! WHEN Playing until the event is reached
+    EXPECT_EQ(play(sequencer, blockSize), std::vector<int>({ 1 }));
+
+    std::vector<samples_t> frames;
+    samples_t blockIdx = 1;
+
+    for (; blockIdx < 200; ++blockIdx) {
+        frames = playFrames(sequencer, blockSize);
+        if (!frames.empty()) {
+            break;
+        }
+    }
+
+    //! THEN The event is played at sample 44100 exactly, the position is not lagging behind
+    EXPECT_EQ(blockIdx, 44100 / blockSize);
+    EXPECT_EQ(frames, std::vector<samples_t>({ 44100 % blockSize }));
+    EXPECT_EQ(sequencer.playbackPosition(), samplesToMsecs((blockIdx + 1) * blockSize, 44100));
+}
@@ -0,0 +1,204 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <iterator>
+#include <thread>
+#include <vector>
+
+#include "audio/internal/audiobuffer.h"
+
+using namespace mu;
+using namespace mu::audio;
+
+static constexpr audioch_t CHANNELS = 2;
+
+//! NOTE Writes the consecutive numbers 1, 2, 3... into the buffer,
+//! so the reader can check that no sample was lost, repeated or reordered
+class CountingSource : public IAudioSource
+{
+public:
+    bool isActive() const override { return true; }
+    void setIsActive(bool) override {}
+    void setSampleRate(unsigned int) override {}
+    unsigned int audioChannelsCount() const override { return CHANNELS; }
+    async::Channel<unsigned int> audioChannelsCountChanged() const override { return m_channelsCountChanged; }
+
+    samples_t process(float* buffer, samples_t samplesPerChannel) override
+    {
+        for (samples_t i = 0; i < samplesPerChannel * CHANNELS; ++i) {
+            buffer[i] = static_cast<float>(++m_counter);
+        }
+        return samplesPerChannel;
+    }
+
+private:
+    uint32_t m_counter = 0;
+    async::Channel<unsigned int> m_channelsCountChanged;
+};
+
+class Audio_AudioBufferTests : public ::testing::Test
+{
+};
+
+TEST_F(Audio_AudioBufferTests, PopReturnsWrittenSamples)
+{
+    //! GIVEN Buffer filled from the counting source
+    AudioBuffer buffer;
+    buffer.init(CHANNELS, 4096);
+    buffer.setSource(std::make_shared<CountingSource>());
+    buffer.forward();
+
+    //! WHEN Reading less than the minimal lag, wrapping around the end several times
+    std::vector<float> dest(300 * CHANNELS);
+    float expected = 1.f;
+    for (int i = 0; i < 100; ++i) {
+        buffer.pop(dest.data(), 300);
+        buffer.forward();
+
+        //! THEN Samples come in order without gaps
+        for (float value : dest) {
+            ASSERT_EQ(value, expected);
+            expected += 1.f;
+        }
+    }
+
+    EXPECT_EQ(buffer.underrunCount(), 0);
+    EXPECT_EQ(buffer.overrunCount(), 0);
+}
+
+TEST_F(Audio_AudioBufferTests, UnderrunOutputsSilence)
+{
+    //! GIVEN Buffer with 2048 samples per channel ready
+    AudioBuffer buffer;
+    buffer.init(CHANNELS, 4096);
+    buffer.setSource(std::make_shared<CountingSource>());
+    buffer.forward();
+
+    std::vector<float> dest(4096 * CHANNELS, -1.f);
+
+    //! WHEN Reading more than there is without forwarding
+    buffer.pop(dest.data(), 4096);
+
+    //! THEN The available samples are returned, followed by silence
+    EXPECT_EQ(dest[2048 * CHANNELS - 1], static_cast<float>(2048 * CHANNELS));
+    EXPECT_EQ(dest[2048 * CHANNELS], 0.f);
+    EXPECT_EQ(dest.back(), 0.f);
+    EXPECT_EQ(buffer.underrunCount(), 1);
+
+    //! WHEN The worker catches up
+    buffer.forward();
+    buffer.pop(dest.data(), 1);
+
+    //! THEN Reading continues from the next sample
+    EXPECT_EQ(dest[0], static_cast<float>(2048 * CHANNELS + 1));
+    EXPECT_EQ(buffer.underrunCount(), 1);
+}
+
+TEST_F(Audio_AudioBufferTests, OverrunWhenFillLevelDoesNotFit)
+{
+    //! GIVEN Buffer which fill level is larger than its capacity
+    AudioBuffer buffer;
+    buffer.init(CHANNELS, 4096);
+
+    AudioBuffer::FillPolicy policy;
+    policy.minSampleLag = 3072;
+    policy.fillOver = 2048;
+    policy.fillSamples = 1024;
+    buffer.setFillPolicy(policy);
+    buffer.setSource(std::make_shared<CountingSource>());
+
+    //! WHEN Forwarding
+    buffer.forward();
+
+    //! THEN The buffer is full and the overrun is counted
+    EXPECT_EQ(buffer.overrunCount(), 1);
+
+    std::vector<float> dest(4096 * CHANNELS);
+    buffer.pop(dest.data(), 4096);
+    EXPECT_EQ(dest.back(), static_cast<float>(4096 * CHANNELS));
+    EXPECT_EQ(buffer.underrunCount(), 0);
+}
+
+TEST_F(Audio_AudioBufferTests, ConcurrentReadWrite)
+{
+    //! GIVEN Small buffer with a short lag, so the reader often catches up with the writer
+    AudioBuffer buffer;
+    buffer.init(CHANNELS, 1024);
+
+    AudioBuffer::FillPolicy policy;
+    policy.minSampleLag = 256;
+    policy.fillOver = 256;
+    policy.fillSamples = 96;
+    buffer.setFillPolicy(policy);
+    buffer.setSource(std::make_shared<CountingSource>());
+
+    std::atomic<bool> finished = false;
+
+    //! WHEN The worker and the driver run in their own threads
+    std::thread worker([&buffer, &finished]() {
+        while (!finished.load()) {
+            buffer.forward();
+            std::this_thread::yield();
+        }
+    });
+
+    const size_t readSizes[] = { 1, 17, 64, 128, 255, 300 };
+    std::vector<float> dest(300 * CHANNELS);
+    float expected = 1.f;
+    uint64_t silentReads = 0;
+
+    for (size_t i = 0; i < 200000; ++i) {
+        size_t size = readSizes[i % std::size(readSizes)];
+        buffer.pop(dest.data(), size);
+
+        bool silence = false;
+        for (size_t j = 0; j < size * CHANNELS; ++j) {
+            //! THEN Every sample is either the next one, or silence after the data has run out
+            if (dest[j] == 0.f) {
+                silence = true;
+                continue;
+            }
+
+            ASSERT_FALSE(silence);
+            ASSERT_EQ(dest[j], expected);
+            expected += 1.f;
+        }
+
+        if (silence) {
+            ++silentReads;
+        }
+
+        //! NOTE Keep the counter exactly representable as float
+        if (expected > 8000000.f) {
+            break;
+        }
+    }
+
+    finished = true;
+    worker.join();
+
+    //! THEN Each read which returned silence was counted as an underrun
+    EXPECT_EQ(buffer.underrunCount(), silentReads);
+    EXPECT_EQ(buffer.overrunCount(), 0);
+}
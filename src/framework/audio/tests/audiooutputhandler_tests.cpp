@@ -0,0 +1,62 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <set>
+
+#include "audio/internal/worker/audiooutputhandler.h"
+
+using namespace mu;
+using namespace mu::audio;
+
+class Audio_AudioOutputHandlerTests : public ::testing::Test
+{
+};
+
+TEST_F(Audio_AudioOutputHandlerTests, StemsDestinations_SameTrackNames)
+{
+    //! GIVEN Tracks, some of them with the same name, also in another case
+    std::vector<std::pair<TrackId, TrackName> > tracks = {
+        { 1, "Violin" },
+        { 2, "Piano" },
+        { 3, "Violin" },
+        { 4, "violin" },
+        { 5, "Violin_2" },
+    };
+
+    //! DO Make the destinations of the stems
+    std::map<TrackId, io::path_t> destinations = AudioOutputHandler::stemsDestinations("/export/score.wav", tracks);
+
+    //! CHECK Every track gets its own file next to the mix
+    ASSERT_EQ(destinations.size(), tracks.size());
+    EXPECT_EQ(destinations.at(1), io::path_t("/export/score-Violin.wav"));
+    EXPECT_EQ(destinations.at(2), io::path_t("/export/score-Piano.wav"));
+    EXPECT_EQ(destinations.at(3), io::path_t("/export/score-Violin_2.wav"));
+    EXPECT_EQ(destinations.at(4), io::path_t("/export/score-violin_3.wav"));
+    EXPECT_EQ(destinations.at(5), io::path_t("/export/score-Violin_2_2.wav"));
+
+    std::set<String> paths;
+    for (const auto& pair : destinations) {
+        paths.insert(pair.second.toString().toLower());
+    }
+    EXPECT_EQ(paths.size(), tracks.size());
+}
@@ -0,0 +1,93 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include "audio/internal/worker/clock.h"
+
+using namespace mu;
+using namespace mu::audio;
+
+class Audio_ClockTests : public ::testing::Test
+{
+};
+
+TEST_F(Audio_ClockTests, ForwardDoesNotDrift)
+{
+    //! GIVEN Running clock at 44.1kHz, so a block of 512 samples is 11.6ms
+    Clock clock;
+    clock.setSampleRate(44100);
+    clock.setTimeDuration(60000);
+    clock.start();
+
+    //! WHEN Forwarding by 10 seconds worth of blocks
+    const samples_t blockSize = 512;
+    const samples_t blocksCount = 44100 * 10 / blockSize;
+
+    for (samples_t i = 0; i < blocksCount; ++i) {
+        clock.forward(blockSize);
+    }
+
+    //! THEN The time matches the rendered samples, instead of losing the fraction of every block
+    EXPECT_EQ(clock.currentSample(), blocksCount * blockSize);
+    EXPECT_EQ(clock.currentTime(), static_cast<msecs_t>(blocksCount * blockSize * 1000 / 44100));
+}
+
+TEST_F(Audio_ClockTests, SeekIsSampleAccurate)
+{
+    //! GIVEN Clock at 44.1kHz
+    Clock clock;
+    clock.setSampleRate(44100);
+    clock.setTimeDuration(60000);
+
+    //! WHEN Seeking
+    clock.seek(1001);
+
+    //! THEN Both views point to the same moment
+    EXPECT_EQ(clock.currentTime(), 1001);
+    EXPECT_EQ(clock.currentSample(), msecsToSamples(1001, 44100));
+    EXPECT_EQ(samplesToMsecs(clock.currentSample(), 44100), 1001);
+
+    //! WHEN The sample rate changes
+    clock.setSampleRate(48000);
+
+    //! THEN The time stays the same
+    EXPECT_EQ(clock.currentTime(), 1001);
+    EXPECT_EQ(clock.currentSample(), 48048);
+}
+
+TEST_F(Audio_ClockTests, ForwardStopsAtDuration)
+{
+    //! GIVEN Running clock close to the end
+    Clock clock;
+    clock.setSampleRate(48000);
+    clock.setTimeDuration(1000);
+    clock.seek(995);
+    clock.start();
+
+    //! WHEN Forwarding past the end
+    clock.forward(480);
+
+    //! THEN The clock stops at the end
+    EXPECT_EQ(clock.currentTime(), 1000);
+    EXPECT_EQ(clock.currentSample(), 48000);
+    EXPECT_FALSE(clock.isRunning());
+}
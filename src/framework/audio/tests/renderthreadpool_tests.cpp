@@ -0,0 +1,105 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <vector>
+
+#include "audio/internal/worker/renderthreadpool.h"
+#include "audio/internal/audiosanitizer.h"
+
+using namespace mu;
+using namespace mu::audio;
+
+class Audio_RenderThreadPoolTests : public ::testing::Test
+{
+};
+
+TEST_F(Audio_RenderThreadPoolTests, EachJobRunsOnce)
+{
+    //! GIVEN Pool with several threads
+    RenderThreadPool pool(4);
+    EXPECT_EQ(pool.threadCount(), 4);
+
+    std::vector<std::atomic<int> > calls(41);
+    RenderThreadPool::Job job = [&calls](size_t jobIdx) {
+        calls[jobIdx].fetch_add(1);
+    };
+
+    //! WHEN Running many short rounds, as the mixer does for every block
+    const int rounds = 5000;
+    for (int round = 0; round < rounds; ++round) {
+        pool.run(calls.size() - round % 3, job);
+    }
+
+    //! THEN Every job of every round was executed exactly once
+    for (size_t i = 0; i < calls.size(); ++i) {
+        int expected = rounds;
+        for (int round = 0; round < rounds; ++round) {
+            if (i >= calls.size() - round % 3) {
+                --expected;
+            }
+        }
+
+        EXPECT_EQ(calls[i].load(), expected);
+    }
+}
+
+TEST_F(Audio_RenderThreadPoolTests, RunsWithoutThreads)
+{
+    //! GIVEN Pool without threads
+    RenderThreadPool pool(0);
+
+    std::vector<size_t> order;
+    RenderThreadPool::Job job = [&order](size_t jobIdx) {
+        order.push_back(jobIdx);
+    };
+
+    //! WHEN Running jobs
+    pool.run(3, job);
+
+    //! THEN They are executed in order on the calling thread
+    EXPECT_EQ(order, std::vector<size_t>({ 0, 1, 2 }));
+}
+
+TEST_F(Audio_RenderThreadPoolTests, PoolThreadsAreNotWorkerThreads)
+{
+    //! GIVEN Pool with several threads
+    RenderThreadPool pool(4);
+
+    std::atomic<int> poolThreadJobs = 0;
+    RenderThreadPool::Job job = [&](size_t) {
+        if (AudioSanitizer::isRenderThread()) {
+            poolThreadJobs.fetch_add(1);
+            EXPECT_FALSE(AudioSanitizer::isWorkerThread());
+        }
+    };
+
+    //! WHEN Running jobs until some of them are executed on the pool threads
+    for (int round = 0; round < 1000 && poolThreadJobs.load() == 0; ++round) {
+        pool.run(64, job);
+    }
+
+    //! THEN The pool threads are render threads, but not worker threads
+    EXPECT_GT(poolThreadJobs.load(), 0);
+    EXPECT_FALSE(AudioSanitizer::isRenderThread());
+}
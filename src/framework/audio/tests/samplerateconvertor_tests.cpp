@@ -0,0 +1,152 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "audio/internal/worker/samplerateconvertor.h"
+
+using namespace mu;
+using namespace mu::audio;
+
+class Audio_SampleRateConvertorTests : public ::testing::Test
+{
+};
+
+static std::vector<float> stereoSine(double frequency, unsigned int sampleRate, size_t frames)
+{
+    std::vector<float> data(frames * 2);
+    for (size_t i = 0; i < frames; ++i) {
+        double value = 0.5 * std::sin(2 * M_PI * frequency * i / sampleRate);
+        data[i * 2] = static_cast<float>(value);
+        data[i * 2 + 1] = static_cast<float>(-value);
+    }
+
+    return data;
+}
+
+//! THD+N of the left channel against the ideal sine, in dB, skipping the filter transients at the edges
+static double thdPlusNoise(const std::vector<float>& output, double frequency, unsigned int sampleRate)
+{
+    const size_t frames = output.size() / 2;
+    const size_t margin = sampleRate / 10;
+
+    double signal = 0.0;
+    double noise = 0.0;
+
+    for (size_t i = margin; i + margin < frames; ++i) {
+        double expected = 0.5 * std::sin(2 * M_PI * frequency * i / sampleRate);
+        double error = output[i * 2] - expected;
+
+        signal += expected * expected;
+        noise += error * error;
+    }
+
+    return 10 * std::log10(noise / signal);
+}
+
+TEST_F(Audio_SampleRateConvertorTests, Quality)
+{
+    const double frequency = 1000.0;
+    const std::pair<unsigned int, unsigned int> ratePairs[] = {
+        { 44100, 48000 }, { 48000, 44100 }, { 48000, 96000 }, { 44100, 96000 }, { 96000, 48000 }, { 44100, 47999 }
+    };
+
+    for (const auto& rates : ratePairs) {
+        //! GIVEN Two seconds of a 1 kHz sine
+        std::vector<float> input = stereoSine(frequency, rates.first, rates.first * 2);
+
+        //! WHEN Converting it
+        SampleRateConvertor convertor(input, 2, rates.first, rates.second);
+        std::vector<float> output = convertor.convert();
+
+        //! THEN The output has the expected length and is a clean sine
+        EXPECT_EQ(output.size(), input.size() / rates.first * rates.second);
+        EXPECT_LT(thdPlusNoise(output, frequency, rates.second), -80.0) << rates.first << " -> " << rates.second;
+    }
+}
+
+TEST_F(Audio_SampleRateConvertorTests, ConstantSignalStaysConstant)
+{
+    //! GIVEN Constant input
+    std::vector<float> input(44100 * 2, 0.25f);
+
+    //! WHEN Converting
+    SampleRateConvertor convertor(input, 2, 44100, 48000);
+    std::vector<float> output = convertor.convert();
+
+    //! THEN The output is the same constant away from the edges
+    for (size_t i = SampleRateConvertor::TAPS_COUNT * 2; i + SampleRateConvertor::TAPS_COUNT * 2 < output.size(); ++i) {
+        ASSERT_NEAR(output[i], 0.25f, 1e-5f);
+    }
+}
+
+static std::vector<float> convertByBlocks(const std::vector<float>& input, size_t maxBlockFrames, size_t setupFrames)
+{
+    std::vector<float> none;
+    SampleRateConvertor convertor(none, 2, 44100, 48000);
+    convertor.setupStream(setupFrames);
+
+    std::mt19937 random(42);
+    std::uniform_int_distribution<size_t> blockSize(1, maxBlockFrames);
+
+    std::vector<float> output;
+    std::vector<float> block;
+    size_t position = 0;
+
+    while (position < input.size() / 2) {
+        size_t frames = std::min(blockSize(random), input.size() / 2 - position);
+        block.resize(convertor.maxOutputFrames(frames) * 2);
+
+        size_t written = convertor.process(input.data() + position * 2, frames, block.data());
+        output.insert(output.end(), block.begin(), block.begin() + written * 2);
+        position += frames;
+    }
+
+    block.resize(convertor.maxOutputFrames(0) * 2);
+    size_t written = convertor.flush(block.data());
+    output.insert(output.end(), block.begin(), block.begin() + written * 2);
+
+    return output;
+}
+
+TEST_F(Audio_SampleRateConvertorTests, StreamingMatchesOffline)
+{
+    std::vector<float> input = stereoSine(440.0, 44100, 20000);
+
+    SampleRateConvertor offlineConvertor(input, 2, 44100, 48000);
+    std::vector<float> expected = offlineConvertor.convert();
+
+    //! WHEN Converting the same input in blocks of random sizes, up to the size the stream was set up for
+    std::vector<float> output = convertByBlocks(input, 700, 700);
+
+    //! THEN The result is the same as of the offline conversion
+    EXPECT_EQ(output, expected);
+
+    //! WHEN The blocks are larger than the stream was set up for
+    output = convertByBlocks(input, 700, 64);
+
+    //! THEN The history buffer grows and the result is still the same
+    EXPECT_EQ(output, expected);
+}
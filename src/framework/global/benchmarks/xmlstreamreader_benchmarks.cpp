@@ -0,0 +1,106 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "serialization/xmlstreamreader.h"
+
+#include "utils/xmltrace.h"
+
+#include "log.h"
+
+using namespace mu;
+using namespace mu::io;
+
+class Global_Ser_XmlStreamReaderBenchmarks : public ::testing::Test
+{
+public:
+};
+
+TEST_F(Global_Ser_XmlStreamReaderBenchmarks, Read_Scores_Same_As_Dom)
+{
+    //! GIVEN The scores of the visual tests and of the engraving tests
+    const std::filesystem::path root(global_benchmarks_DATA_ROOT);
+    const std::vector<std::string> corpusDirs = {
+        "vtest/scores",
+        "mtest",
+        "src/engraving/tests",
+        "src/engraving/utests"
+    };
+
+    std::vector<std::string> documents;
+    for (const std::string& dir : corpusDirs) {
+        std::filesystem::path path = root / dir;
+        if (!std::filesystem::exists(path)) {
+            continue;
+        }
+
+        for (const auto& entry : std::filesystem::recursive_directory_iterator(path)) {
+            if (entry.is_regular_file() && entry.path().extension() == ".mscx") {
+                std::ifstream stream(entry.path(), std::ios::binary);
+                documents.emplace_back(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+            }
+        }
+    }
+
+    if (documents.empty()) {
+        GTEST_SKIP() << "no scores found in " << root.string();
+    }
+
+    using clock = std::chrono::steady_clock;
+
+    //! DO Read every score with the DOM and with the reader
+    std::vector<std::string> domTraces;
+    domTraces.reserve(documents.size());
+
+    clock::time_point domStart = clock::now();
+    for (const std::string& data : documents) {
+        domTraces.push_back(readDomTrace(data));
+    }
+    clock::duration domTime = clock::now() - domStart;
+
+    std::vector<std::string> traces;
+    traces.reserve(documents.size());
+
+    clock::time_point readerStart = clock::now();
+    for (const std::string& data : documents) {
+        XmlStreamReader xml(toByteArray(data));
+        std::string trace = readTrace(xml);
+        traces.push_back(xml.isError() ? std::string() : trace);
+    }
+    clock::duration readerTime = clock::now() - readerStart;
+
+    //! CHECK The same tokens for every score
+    for (size_t i = 0; i < documents.size(); ++i) {
+        EXPECT_EQ(traces.at(i), domTraces.at(i)) << "score: " << i;
+    }
+
+    using ms = std::chrono::milliseconds;
+    LOGI() << "scores: " << documents.size()
+           << ", tinyxml2 DOM: " << std::chrono::duration_cast<ms>(domTime).count() << " ms"
+           << ", XmlStreamReader: " << std::chrono::duration_cast<ms>(readerTime).count() << " ms";
+}
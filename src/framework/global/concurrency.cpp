@@ -0,0 +1,152 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "concurrency.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+class ThreadPool
+{
+public:
+    ThreadPool(size_t threadCount)
+    {
+        m_threads.reserve(threadCount);
+        for (size_t i = 0; i < threadCount; ++i) {
+            m_threads.emplace_back([this]() { threadMain(); });
+        }
+    }
+
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopped = true;
+        }
+        m_taskAdded.notify_all();
+
+        for (std::thread& thread : m_threads) {
+            thread.join();
+        }
+    }
+
+    std::future<void> push(const mu::concurrency::Task& task)
+    {
+        std::packaged_task<void()> packagedTask(task);
+        std::future<void> future = packagedTask.get_future();
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_tasks.push_back(std::move(packagedTask));
+        }
+        m_taskAdded.notify_one();
+
+        return future;
+    }
+
+private:
+    void threadMain()
+    {
+        for (;;) {
+            std::packaged_task<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_taskAdded.wait(lock, [this]() { return m_stopped || !m_tasks.empty(); });
+
+                //! NOTE The remaining tasks are finished before the pool stops
+                if (m_tasks.empty()) {
+                    return;
+                }
+
+                task = std::move(m_tasks.front());
+                m_tasks.pop_front();
+            }
+
+            task();
+        }
+    }
+
+    std::vector<std::thread> m_threads;
+    std::deque<std::packaged_task<void()> > m_tasks;
+    std::mutex m_mutex;
+    std::condition_variable m_taskAdded;
+    bool m_stopped = false;
+};
+}
+
+size_t mu::concurrency::idealThreadCount()
+{
+    return std::max<size_t>(std::thread::hardware_concurrency(), 1);
+}
+
+void mu::concurrency::parallelFor(size_t jobCount, const Job& job, size_t maxThreadCount)
+{
+    if (jobCount == 0) {
+        return;
+    }
+
+    if (maxThreadCount == 0) {
+        maxThreadCount = idealThreadCount();
+    }
+
+    size_t threadCount = std::min(jobCount, maxThreadCount);
+
+    if (threadCount <= 1) {
+        for (size_t jobIdx = 0; jobIdx < jobCount; ++jobIdx) {
+            job(jobIdx);
+        }
+
+        return;
+    }
+
+    std::atomic<size_t> nextJobIdx = 0;
+
+    auto worker = [&nextJobIdx, jobCount, &job]() {
+        for (size_t jobIdx = nextJobIdx.fetch_add(1); jobIdx < jobCount; jobIdx = nextJobIdx.fetch_add(1)) {
+            job(jobIdx);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(threadCount - 1);
+
+    for (size_t i = 1; i < threadCount; ++i) {
+        threads.emplace_back(worker);
+    }
+
+    worker();
+
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+}
+
+std::future<void> mu::concurrency::runAsync(const Task& task)
+{
+    static ThreadPool pool(idealThreadCount());
+    return pool.push(task);
+}
@@ -0,0 +1,48 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_GLOBAL_CONCURRENCY_H
+#define MU_GLOBAL_CONCURRENCY_H
+
+#include <cstddef>
+#include <functional>
+#include <future>
+
+namespace mu::concurrency {
+//! NOTE Number of threads worth using for CPU bound work
+size_t idealThreadCount();
+
+using Job = std::function<void (size_t jobIdx)>;
+
+//! NOTE Runs job(0) ... job(jobCount - 1) on up to maxThreadCount threads (idealThreadCount() if 0)
+//!      and returns when all of them are done. The calling thread takes jobs as well.
+//!      Threads are started per call, so it is meant for coarse jobs, like a part of a score or a file
+void parallelFor(size_t jobCount, const Job& job, size_t maxThreadCount = 0);
+
+using Task = std::function<void ()>;
+
+//! NOTE Runs the task on a process-wide pool of idealThreadCount() threads, which are started on first use,
+//!      and returns a future, that is ready when the task is done. Tasks are started in the order they were added.
+//!      A task must not wait for another task of the pool
+std::future<void> runAsync(const Task& task);
+}
+
+#endif // MU_GLOBAL_CONCURRENCY_H
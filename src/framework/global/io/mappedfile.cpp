@@ -0,0 +1,157 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "mappedfile.h"
+
+#ifdef Q_OS_WIN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "log.h"
+
+using namespace mu;
+using namespace mu::io;
+
+MappedFile::MappedFile(const path_t& filePath)
+    : m_filePath(filePath)
+{
+}
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+path_t MappedFile::filePath() const
+{
+    return m_filePath;
+}
+
+bool MappedFile::open()
+{
+    if (isOpen()) {
+        return true;
+    }
+
+#ifdef Q_OS_WIN
+    HANDLE file = CreateFileW(m_filePath.toStdWString().c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        LOGE() << "failed open file: " << m_filePath;
+        return false;
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+        LOGE() << "failed get size of file: " << m_filePath;
+        CloseHandle(file);
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) {
+        LOGE() << "failed map file: " << m_filePath;
+        CloseHandle(file);
+        return false;
+    }
+
+    void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!data) {
+        LOGE() << "failed map file: " << m_filePath;
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+
+    m_fileHandle = file;
+    m_mappingHandle = mapping;
+    m_size = static_cast<size_t>(fileSize.QuadPart);
+#else
+    int file = ::open(m_filePath.c_str(), O_RDONLY);
+    if (file < 0) {
+        LOGE() << "failed open file: " << m_filePath;
+        return false;
+    }
+
+    struct stat fileStat;
+    if (fstat(file, &fileStat) != 0 || fileStat.st_size == 0) {
+        LOGE() << "failed get size of file: " << m_filePath;
+        ::close(file);
+        return false;
+    }
+
+    void* data = mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_SHARED, file, 0);
+
+    //! NOTE The mapping stays valid after the descriptor is closed
+    ::close(file);
+
+    if (data == MAP_FAILED) {
+        LOGE() << "failed map file: " << m_filePath;
+        return false;
+    }
+
+    m_size = static_cast<size_t>(fileStat.st_size);
+#endif
+
+    m_data = static_cast<const uint8_t*>(data);
+
+    return true;
+}
+
+void MappedFile::close()
+{
+    if (!isOpen()) {
+        return;
+    }
+
+#ifdef Q_OS_WIN
+    UnmapViewOfFile(m_data);
+    CloseHandle(m_mappingHandle);
+    CloseHandle(m_fileHandle);
+    m_mappingHandle = nullptr;
+    m_fileHandle = nullptr;
+#else
+    munmap(const_cast<uint8_t*>(m_data), m_size);
+#endif
+
+    m_data = nullptr;
+    m_size = 0;
+}
+
+bool MappedFile::isOpen() const
+{
+    return m_data != nullptr;
+}
+
+const uint8_t* MappedFile::data() const
+{
+    return m_data;
+}
+
+size_t MappedFile::size() const
+{
+    return m_size;
+}
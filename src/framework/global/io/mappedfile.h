@@ -0,0 +1,64 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_IO_MAPPEDFILE_H
+#define MU_IO_MAPPEDFILE_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "path.h"
+
+namespace mu::io {
+//! NOTE Read-only view of a whole file, mapped into memory.
+//!      The pages are loaded on demand and shared by every process mapping the same file
+class MappedFile
+{
+public:
+    MappedFile() = default;
+    MappedFile(const path_t& filePath);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    path_t filePath() const;
+
+    bool open();
+    void close();
+    bool isOpen() const;
+
+    const uint8_t* data() const;
+    size_t size() const;
+
+private:
+    path_t m_filePath;
+    const uint8_t* m_data = nullptr;
+    size_t m_size = 0;
+
+#ifdef Q_OS_WIN
+    void* m_fileHandle = nullptr;
+    void* m_mappingHandle = nullptr;
+#endif
+};
+}
+
+#endif // MU_IO_MAPPEDFILE_H
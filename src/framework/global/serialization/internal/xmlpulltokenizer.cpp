@@ -0,0 +1,740 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "xmlpulltokenizer.h"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace mu;
+using namespace mu::io;
+
+static constexpr size_t MAX_NODE_HEADER_LEN = 9; // <![CDATA[
+
+static inline bool isWhiteSpace(char ch)
+{
+    return ch == ' ' || ch == '\n' || ch == '\t' || ch == '\r' || ch == '\v' || ch == '\f';
+}
+
+static inline bool isNameStartChar(char ch)
+{
+    unsigned char uch = static_cast<unsigned char>(ch);
+    return uch >= 128
+           || (uch >= 'a' && uch <= 'z')
+           || (uch >= 'A' && uch <= 'Z')
+           || uch == ':' || uch == '_';
+}
+
+static inline bool isNameChar(char ch)
+{
+    return isNameStartChar(ch)
+           || (ch >= '0' && ch <= '9')
+           || ch == '.' || ch == '-';
+}
+
+static inline char* skipWhiteSpace(char* p, int64_t& line)
+{
+    while (isWhiteSpace(*p)) {
+        if (*p == '\n') {
+            ++line;
+        }
+        ++p;
+    }
+    return p;
+}
+
+static inline char* skipName(char* p)
+{
+    if (!isNameStartChar(*p)) {
+        return p;
+    }
+
+    ++p;
+    while (isNameChar(*p)) {
+        ++p;
+    }
+    return p;
+}
+
+static inline std::string toString(const AsciiStringView& str)
+{
+    return std::string(str.ascii(), str.size());
+}
+
+static size_t toUtf8(unsigned long ucs, char* out)
+{
+    if (ucs < 0x80) {
+        out[0] = static_cast<char>(ucs);
+        return 1;
+    } else if (ucs < 0x800) {
+        out[0] = static_cast<char>(0xC0 | (ucs >> 6));
+        out[1] = static_cast<char>(0x80 | (ucs & 0x3F));
+        return 2;
+    } else if (ucs < 0x10000) {
+        out[0] = static_cast<char>(0xE0 | (ucs >> 12));
+        out[1] = static_cast<char>(0x80 | ((ucs >> 6) & 0x3F));
+        out[2] = static_cast<char>(0x80 | (ucs & 0x3F));
+        return 3;
+    } else if (ucs < 0x200000) {
+        out[0] = static_cast<char>(0xF0 | (ucs >> 18));
+        out[1] = static_cast<char>(0x80 | ((ucs >> 12) & 0x3F));
+        out[2] = static_cast<char>(0x80 | ((ucs >> 6) & 0x3F));
+        out[3] = static_cast<char>(0x80 | (ucs & 0x3F));
+        return 4;
+    }
+
+    return 0;
+}
+
+//! NOTE &#123; or &#x7B;
+//! Returns the position after ';' or nullptr if it is not a valid character reference
+static const char* decodeCharacterRef(const char* p, const char* end, char* out, size_t& outLen)
+{
+    const char* semicolon = static_cast<const char*>(std::memchr(p, ';', end - p));
+    if (!semicolon) {
+        return nullptr;
+    }
+
+    bool hex = p[2] == 'x';
+    const char* digit = p + (hex ? 3 : 2);
+    if (digit == semicolon) {
+        return nullptr;
+    }
+
+    unsigned long ucs = 0;
+    for (; digit < semicolon; ++digit) {
+        unsigned long value = 0;
+        char ch = *digit;
+        if (ch >= '0' && ch <= '9') {
+            value = ch - '0';
+        } else if (hex && ch >= 'a' && ch <= 'f') {
+            value = ch - 'a' + 10;
+        } else if (hex && ch >= 'A' && ch <= 'F') {
+            value = ch - 'A' + 10;
+        } else {
+            return nullptr;
+        }
+
+        ucs = std::min(ucs * (hex ? 16 : 10) + value, 0x200000ul);
+    }
+
+    outLen = toUtf8(ucs, out);
+    return semicolon + 1;
+}
+
+struct Entity {
+    const char* pattern;
+    size_t length;
+    char value;
+};
+
+static constexpr Entity ENTITIES[] = {
+    { "quot", 4, '\"' },
+    { "amp", 3, '&' },
+    { "apos", 4, '\'' },
+    { "lt", 2, '<' },
+    { "gt", 2, '>' }
+};
+
+//! NOTE Normalizes new lines (CR LF, CR and LF CR become LF) and, if requested,
+//! replaces the predefined entities and character references. The result never
+//! grows, so it is written over the source and terminated with '\0'.
+static size_t decodeInPlace(char* begin, char* end, bool entities)
+{
+    char* p = begin;
+    while (p < end && *p != '\r' && !(entities && *p == '&')) {
+        ++p;
+    }
+
+    if (p == end) {
+        *end = 0;
+        return end - begin;
+    }
+
+    char* q = p;
+
+    //! NOTE The LF of an LF CR pair has already been copied
+    if (*p == '\r' && p > begin && p[-1] == '\n') {
+        ++p;
+    }
+
+    while (p < end) {
+        char ch = *p;
+        if (ch == '\r') {
+            p += (p + 1 < end && p[1] == '\n') ? 2 : 1;
+            *q++ = '\n';
+        } else if (ch == '\n') {
+            p += (p + 1 < end && p[1] == '\r') ? 2 : 1;
+            *q++ = '\n';
+        } else if (entities && ch == '&') {
+            bool decoded = false;
+            if (p + 1 < end && p[1] == '#') {
+                char buf[4];
+                size_t len = 0;
+                const char* next = decodeCharacterRef(p, end, buf, len);
+                if (next) {
+                    std::memcpy(q, buf, len);
+                    q += len;
+                    p = const_cast<char*>(next);
+                    decoded = true;
+                }
+            } else {
+                for (const Entity& entity : ENTITIES) {
+                    if (static_cast<size_t>(end - p) > entity.length + 1
+                        && std::strncmp(p + 1, entity.pattern, entity.length) == 0
+                        && p[entity.length + 1] == ';') {
+                        *q++ = entity.value;
+                        p += entity.length + 2;
+                        decoded = true;
+                        break;
+                    }
+                }
+            }
+
+            if (!decoded) {
+                *q++ = *p++;
+            }
+        } else {
+            *q++ = *p++;
+        }
+    }
+
+    *q = 0;
+    return q - begin;
+}
+
+XmlPullTokenizer::XmlPullTokenizer()
+{
+    reset();
+}
+
+void XmlPullTokenizer::reset()
+{
+    m_blocks.clear();
+    m_pos = allocateBlock(0);
+    m_end = m_pos;
+    *m_end = 0;
+
+    m_device = nullptr;
+    m_inputFinished = true;
+
+    m_started = false;
+    m_tagStarted = false;
+    m_onlyDeclarations = true;
+    m_closedElementPending = false;
+    m_openElements.clear();
+
+    m_line = 1;
+    m_tokenLine = 0;
+
+    m_token = NoToken;
+    m_name = AsciiStringView();
+    m_value = AsciiStringView();
+    m_attributes.clear();
+    m_tokenBlocks[0] = m_tokenBlocks[1] = 0;
+    m_error.clear();
+}
+
+char* XmlPullTokenizer::allocateBlock(size_t size)
+{
+    //! NOTE One more byte for the terminating '\0', the content is not initialized
+    m_blocks.emplace_back(new char[size + 1]);
+    return m_blocks.back().get();
+}
+
+size_t XmlPullTokenizer::lastBlock() const
+{
+    return m_blocks.size() - 1;
+}
+
+void XmlPullTokenizer::releaseBlocks()
+{
+    //! NOTE The slots of the released blocks are kept, so the block indexes stay the same
+    for (size_t i = 0; i < lastBlock(); ++i) {
+        if (!m_blocks[i] || i == m_tokenBlocks[0] || i == m_tokenBlocks[1]) {
+            continue;
+        }
+
+        bool referenced = false;
+        for (const OpenElement& e : m_openElements) {
+            if (i == e.nameBlock || i == e.textBlock) {
+                referenced = true;
+                break;
+            }
+        }
+
+        if (!referenced) {
+            m_blocks[i].reset();
+        }
+    }
+}
+
+size_t XmlPullTokenizer::blockCount() const
+{
+    return std::count_if(m_blocks.begin(), m_blocks.end(), [](const std::unique_ptr<char[]>& b) { return b != nullptr; });
+}
+
+void XmlPullTokenizer::setData(const uint8_t* data, size_t size)
+{
+    reset();
+
+    m_pos = allocateBlock(size);
+    if (size) {
+        std::memcpy(m_pos, data, size);
+    }
+    m_end = m_pos + size;
+    *m_end = 0;
+}
+
+void XmlPullTokenizer::setDevice(IODevice* device, size_t chunkSize)
+{
+    reset();
+
+    m_device = device;
+    m_chunkSize = std::max(chunkSize, MAX_NODE_HEADER_LEN);
+    m_inputFinished = !device;
+}
+
+void XmlPullTokenizer::readMore()
+{
+    if (!m_device || m_device->pos() >= m_device->size()) {
+        m_device = nullptr;
+        m_inputFinished = true;
+        return;
+    }
+
+    //! NOTE The unfinished token is moved to the new block,
+    //! the old block stays alive while the views handed out before refer to it
+    size_t tail = m_end - m_pos;
+    size_t chunk = std::max(m_chunkSize, tail);
+
+    char* block = allocateBlock(tail + chunk);
+    std::memcpy(block, m_pos, tail);
+
+    size_t read = m_device->read(reinterpret_cast<uint8_t*>(block + tail), chunk);
+    if (read == 0) {
+        m_blocks.pop_back();
+        m_device = nullptr;
+        m_inputFinished = true;
+        return;
+    }
+
+    m_pos = block;
+    m_end = block + tail + read;
+    *m_end = 0;
+
+    releaseBlocks();
+}
+
+bool XmlPullTokenizer::needMore(const char* p) const
+{
+    return p == m_end && !m_inputFinished;
+}
+
+bool XmlPullTokenizer::needMore(const char* p, size_t count) const
+{
+    return static_cast<size_t>(m_end - p) < count && !m_inputFinished;
+}
+
+XmlPullTokenizer::TokenType XmlPullTokenizer::next()
+{
+    if (m_token == EndDocument || m_token == Error) {
+        return m_token;
+    }
+
+    m_name = AsciiStringView();
+    m_value = AsciiStringView();
+    m_attributes.clear();
+
+    if (m_closedElementPending) {
+        m_closedElementPending = false;
+        closeElement();
+        return m_token;
+    }
+
+    while (parseNode() == Status::NeedMore) {
+        m_attributes.clear();
+        readMore();
+    }
+
+    if (m_token != Declaration) {
+        m_onlyDeclarations = false;
+    }
+
+    if (m_token != EndElement) {
+        m_tokenBlocks[0] = m_tokenBlocks[1] = lastBlock();
+    }
+
+    if (m_token == Text && !m_openElements.empty()) {
+        m_openElements.back().textBlock = lastBlock();
+    }
+
+    return m_token;
+}
+
+XmlPullTokenizer::Status XmlPullTokenizer::parseNode()
+{
+    char* p = m_pos;
+    int64_t line = m_line;
+
+    if (!m_started) {
+        p = skipWhiteSpace(p, line);
+        if (needMore(p, 3)) {
+            return Status::NeedMore;
+        }
+
+        if (static_cast<unsigned char>(p[0]) == 0xEF
+            && static_cast<unsigned char>(p[1]) == 0xBB
+            && static_cast<unsigned char>(p[2]) == 0xBF) {
+            p += 3;
+        }
+
+        if (*p == 0) {
+            if (needMore(p)) {
+                return Status::NeedMore;
+            }
+            return setError("XML_ERROR_EMPTY_DOCUMENT", 0);
+        }
+    }
+
+    //! NOTE Whitespace between nodes is dropped, but belongs to the text if there is any
+    char* nodeStart = p;
+    int64_t nodeLine = line;
+
+    if (!m_tagStarted) {
+        p = skipWhiteSpace(p, line);
+
+        if (*p == 0) {
+            if (needMore(p)) {
+                return Status::NeedMore;
+            }
+
+            if (!m_openElements.empty()) {
+                return setError("XML_ERROR_PARSING", line, "unexpected end of document, XMLElement name=" + toString(m_openElements.back().name));
+            }
+
+            m_started = true;
+            m_pos = p;
+            m_line = line;
+            m_tokenLine = line;
+            m_token = EndDocument;
+            return Status::Done;
+        }
+
+        if (*p != '<') {
+            m_tokenLine = line;
+            return parseText(nodeStart, nodeLine);
+        }
+    }
+
+    if (needMore(p, MAX_NODE_HEADER_LEN)) {
+        return Status::NeedMore;
+    }
+
+    m_tokenLine = line;
+
+    if (p[1] == '?') {
+        return parseSection(p + 2, line, "?>", Declaration);
+    } else if (std::strncmp(p + 1, "!--", 3) == 0) {
+        return parseSection(p + 4, line, "-->", Comment);
+    } else if (std::strncmp(p + 1, "![CDATA[", 8) == 0) {
+        return parseSection(p + 9, line, "]]>", Text);
+    } else if (p[1] == '!') {
+        return parseSection(p + 2, line, ">", Unknown);
+    }
+
+    return parseElement(p + 1, line);
+}
+
+XmlPullTokenizer::Status XmlPullTokenizer::parseText(char* p, int64_t line)
+{
+    char* start = p;
+    bool needsDecoding = false;
+
+    for (;; ++p) {
+        char ch = *p;
+        if (ch == '<') {
+            break;
+        } else if (ch == '\n') {
+            ++line;
+        } else if (ch == '&' || ch == '\r') {
+            needsDecoding = true;
+        } else if (ch == 0) {
+            if (needMore(p)) {
+                return Status::NeedMore;
+            }
+            return setError("XML_ERROR_PARSING_TEXT", m_tokenLine);
+        }
+    }
+
+    //! NOTE The '<' of the next tag is overwritten by the terminator
+    *p = 0;
+    m_tagStarted = true;
+
+    size_t size = needsDecoding ? decodeInPlace(start, p, true) : p - start;
+
+    m_started = true;
+    m_pos = p;
+    m_line = line;
+    m_token = Text;
+    m_value = AsciiStringView(start, size);
+    return Status::Done;
+}
+
+XmlPullTokenizer::Status XmlPullTokenizer::parseSection(char* p, int64_t line, const char* endTag, TokenType type)
+{
+    char* start = p;
+    size_t endTagLen = std::strlen(endTag);
+    bool hasCR = false;
+
+    for (;; ++p) {
+        char ch = *p;
+        if (ch == endTag[0] && std::strncmp(p, endTag, endTagLen) == 0) {
+            break;
+        } else if (ch == '\n') {
+            ++line;
+        } else if (ch == '\r') {
+            hasCR = true;
+        } else if (ch == 0) {
+            if (needMore(p)) {
+                return Status::NeedMore;
+            }
+
+            switch (type) {
+            case Declaration: return setError("XML_ERROR_PARSING_DECLARATION", m_tokenLine);
+            case Comment: return setError("XML_ERROR_PARSING_COMMENT", m_tokenLine);
+            case Text: return setError("XML_ERROR_PARSING_CDATA", m_tokenLine);
+            default: return setError("XML_ERROR_PARSING_UNKNOWN", m_tokenLine);
+            }
+        }
+    }
+
+    size_t size = hasCR ? decodeInPlace(start, p, false) : p - start;
+    start[size] = 0;
+
+    //! NOTE Declarations are only allowed at document level, before anything else
+    if (type == Declaration && (!m_openElements.empty() || !m_onlyDeclarations)) {
+        return setError("XML_ERROR_PARSING_DECLARATION", m_tokenLine, "XMLDeclaration value=" + std::string(start));
+    }
+
+    m_started = true;
+    m_tagStarted = false;
+    m_pos = p + endTagLen;
+    m_line = line;
+    m_token = type;
+    m_value = AsciiStringView(start, size);
+    return Status::Done;
+}
+
+XmlPullTokenizer::Status XmlPullTokenizer::parseElement(char* p, int64_t line)
+{
+    p = skipWhiteSpace(p, line);
+
+    bool closing = false;
+    if (*p == '/') {
+        closing = true;
+        ++p;
+    }
+
+    char* nameStart = p;
+    p = skipName(p);
+    if (needMore(p)) {
+        return Status::NeedMore;
+    }
+
+    char* nameEnd = p;
+    if (nameStart == nameEnd) {
+        return setError("XML_ERROR_PARSING", m_tokenLine);
+    }
+
+    AsciiStringView name(nameStart, nameEnd - nameStart);
+    bool closed = false;
+
+    //! NOTE The attributes are collected as raw views and decoded once the tag is complete
+    for (;;) {
+        p = skipWhiteSpace(p, line);
+
+        if (isNameStartChar(*p)) {
+            char* attrNameStart = p;
+            p = skipName(p);
+            char* attrNameEnd = p;
+
+            p = skipWhiteSpace(p, line);
+            if (*p != '=') {
+                if (needMore(p)) {
+                    return Status::NeedMore;
+                }
+                return setError("XML_ERROR_PARSING_ATTRIBUTE", line, "XMLElement name=" + toString(name));
+            }
+
+            p = skipWhiteSpace(p + 1, line);
+            char quote = *p;
+            if (quote != '\"' && quote != '\'') {
+                if (needMore(p)) {
+                    return Status::NeedMore;
+                }
+                return setError("XML_ERROR_PARSING_ATTRIBUTE", line, "XMLElement name=" + toString(name));
+            }
+
+            char* valueStart = ++p;
+            for (; *p != quote; ++p) {
+                if (*p == '\n') {
+                    ++line;
+                } else if (*p == 0) {
+                    if (needMore(p)) {
+                        return Status::NeedMore;
+                    }
+                    return setError("XML_ERROR_PARSING_ATTRIBUTE", line, "XMLElement name=" + toString(name));
+                }
+            }
+
+            Attribute attribute;
+            attribute.name = AsciiStringView(attrNameStart, attrNameEnd - attrNameStart);
+            attribute.value = AsciiStringView(valueStart, p - valueStart);
+            ++p;
+
+            for (const Attribute& a : m_attributes) {
+                if (a.name == attribute.name) {
+                    return setError("XML_ERROR_PARSING_ATTRIBUTE", line, "XMLElement name=" + toString(name));
+                }
+            }
+
+            m_attributes.push_back(attribute);
+        } else if (*p == '>') {
+            ++p;
+            break;
+        } else if (*p == '/' && p[1] == '>') {
+            closed = true;
+            p += 2;
+            break;
+        } else if (needMore(p, 2)) {
+            return Status::NeedMore;
+        } else {
+            return setError("XML_ERROR_PARSING_ELEMENT", m_tokenLine, "XMLElement name=" + toString(name));
+        }
+    }
+
+    m_started = true;
+    m_tagStarted = false;
+
+    if (closing) {
+        //! NOTE A closing tag at document level ends the document
+        if (m_openElements.empty()) {
+            m_attributes.clear();
+            m_pos = p;
+            m_line = line;
+            m_token = EndDocument;
+            return Status::Done;
+        }
+
+        if (closed || m_openElements.back().name != name) {
+            return setError("XML_ERROR_MISMATCHED_ELEMENT", m_tokenLine, "XMLElement name=" + toString(m_openElements.back().name));
+        }
+
+        m_attributes.clear();
+        m_pos = p;
+        m_line = line;
+        closeElement();
+        return Status::Done;
+    }
+
+    *nameEnd = 0;
+    for (Attribute& a : m_attributes) {
+        char* attrName = const_cast<char*>(a.name.ascii());
+        char* value = const_cast<char*>(a.value.ascii());
+        attrName[a.name.size()] = 0;
+        a.value = AsciiStringView(value, decodeInPlace(value, value + a.value.size(), true));
+    }
+
+    m_openElements.push_back({ name, lastBlock(), lastBlock() });
+    m_closedElementPending = closed;
+
+    m_pos = p;
+    m_line = line;
+    m_token = StartElement;
+    m_name = name;
+    return Status::Done;
+}
+
+void XmlPullTokenizer::closeElement()
+{
+    const OpenElement& e = m_openElements.back();
+    m_token = EndElement;
+    m_name = e.name;
+    m_tokenBlocks[0] = e.nameBlock;
+    m_tokenBlocks[1] = e.textBlock;
+    m_openElements.pop_back();
+}
+
+XmlPullTokenizer::Status XmlPullTokenizer::setError(const char* error, int64_t line, const std::string& details)
+{
+    m_error = std::string("Error=") + error + " Line number=" + std::to_string(line);
+    if (!details.empty()) {
+        m_error += ": " + details;
+    }
+
+    m_tokenLine = line;
+    m_token = Error;
+    m_name = AsciiStringView();
+    m_value = AsciiStringView();
+    m_attributes.clear();
+    return Status::Done;
+}
+
+XmlPullTokenizer::TokenType XmlPullTokenizer::tokenType() const
+{
+    return m_token;
+}
+
+AsciiStringView XmlPullTokenizer::name() const
+{
+    return m_name;
+}
+
+AsciiStringView XmlPullTokenizer::value() const
+{
+    return m_value;
+}
+
+const std::vector<XmlPullTokenizer::Attribute>& XmlPullTokenizer::attributes() const
+{
+    return m_attributes;
+}
+
+const XmlPullTokenizer::Attribute* XmlPullTokenizer::attribute(const char* name) const
+{
+    for (const Attribute& a : m_attributes) {
+        if (a.name == name) {
+            return &a;
+        }
+    }
+    return nullptr;
+}
+
+int64_t XmlPullTokenizer::lineNumber() const
+{
+    return m_tokenLine;
+}
+
+const std::string& XmlPullTokenizer::errorString() const
+{
+    return m_error;
+}
@@ -0,0 +1,142 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_GLOBAL_XMLPULLTOKENIZER_H
+#define MU_GLOBAL_XMLPULLTOKENIZER_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "io/iodevice.h"
+#include "types/string.h"
+
+namespace mu {
+//! NOTE Incremental in-situ XML tokenizer
+//! The input is kept in blocks owned by the tokenizer, names and values are terminated
+//! and decoded in place. When reading from a device, a token that crosses a block boundary
+//! is moved to the next block and scanned again, and the blocks no token refers to are released.
+//! The views of the current and the previous token, the names of the open elements
+//! and the last text of each open element stay valid until the element is closed.
+class XmlPullTokenizer
+{
+public:
+    enum TokenType {
+        NoToken = 0,
+        Declaration,
+        StartElement,
+        EndElement,
+        Text,
+        Comment,
+        Unknown,
+        EndDocument,
+        Error
+    };
+
+    struct Attribute
+    {
+        AsciiStringView name;
+        AsciiStringView value;
+    };
+
+    XmlPullTokenizer();
+
+    XmlPullTokenizer(const XmlPullTokenizer&) = delete;
+    XmlPullTokenizer& operator=(const XmlPullTokenizer&) = delete;
+
+    void setData(const uint8_t* data, size_t size);
+    void setDevice(io::IODevice* device, size_t chunkSize = DEFAULT_CHUNK_SIZE);
+
+    TokenType next();
+    TokenType tokenType() const;
+
+    AsciiStringView name() const;
+    AsciiStringView value() const;
+    const std::vector<Attribute>& attributes() const;
+    const Attribute* attribute(const char* name) const;
+
+    int64_t lineNumber() const;
+    const std::string& errorString() const;
+
+    //! NOTE The number of input blocks still held
+    size_t blockCount() const;
+
+    static constexpr size_t DEFAULT_CHUNK_SIZE = 64 * 1024;
+
+private:
+    enum class Status {
+        Done,
+        NeedMore
+    };
+
+    void reset();
+    char* allocateBlock(size_t size);
+    void readMore();
+
+    bool needMore(const char* p) const;
+    bool needMore(const char* p, size_t count) const;
+
+    Status parseNode();
+    Status parseText(char* p, int64_t line);
+    Status parseElement(char* p, int64_t line);
+    Status parseSection(char* p, int64_t line, const char* endTag, TokenType type);
+
+    Status setError(const char* error, int64_t line, const std::string& details = std::string());
+
+    struct OpenElement
+    {
+        AsciiStringView name;
+        size_t nameBlock = 0;
+        size_t textBlock = 0;
+    };
+
+    size_t lastBlock() const;
+    void releaseBlocks();
+    void closeElement();
+
+    std::vector<std::unique_ptr<char[]> > m_blocks;
+    char* m_pos = nullptr;
+    char* m_end = nullptr;
+
+    io::IODevice* m_device = nullptr;
+    size_t m_chunkSize = DEFAULT_CHUNK_SIZE;
+    bool m_inputFinished = true;
+
+    bool m_started = false;
+    bool m_tagStarted = false;
+    bool m_onlyDeclarations = true;
+    bool m_closedElementPending = false;
+    std::vector<OpenElement> m_openElements;
+
+    int64_t m_line = 1;
+    int64_t m_tokenLine = 0;
+
+    TokenType m_token = NoToken;
+    AsciiStringView m_name;
+    AsciiStringView m_value;
+    std::vector<Attribute> m_attributes;
+    size_t m_tokenBlocks[2] = { 0, 0 };
+
+    std::string m_error;
+};
+}
+
+#endif // MU_GLOBAL_XMLPULLTOKENIZER_H
@@ -23,6 +23,7 @@
 
 #include <ctime>
 #include <cstring>
+#include <mutex>
 #include <zlib.h>
 
 #include "io/dir.h"
@@ -148,7 +149,7 @@ static int inflate(Bytef* dest, ulong* destLen, const Bytef* source, ulong sourc
     return err;
 }
 
-static int deflate(Bytef* dest, ulong* destLen, const Bytef* source, ulong sourceLen)
+static int deflate(Bytef* dest, ulong* destLen, const Bytef* source, ulong sourceLen, int level)
 {
     z_stream stream;
     int err;
@@ -165,7 +166,7 @@ static int deflate(Bytef* dest, ulong* destLen, const Bytef* source, ulong sourc
     stream.zfree = (free_func)0;
     stream.opaque = (voidpf)0;
 
-    err = deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY);
+    err = deflateInit2(&stream, level, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY);
     if (err != Z_OK) {
         return err;
     }
@@ -377,13 +378,18 @@ struct ZipContainer::Impl {
     uint start_of_directory = 0;
     ZipContainer::Status status = ZipContainer::NoError;
 
-    ZipContainer::CompressionPolicy compressionPolicy;
+    ZipContainer::CompressionPolicy compressionPolicy = ZipContainer::AlwaysCompress;
+    int compressionLevel = Z_DEFAULT_COMPRESSION;
+
+    std::mutex deviceMutex;
 
     enum EntryType {
         Directory, File, Symlink
     };
 
     void addEntry(EntryType type, const std::string& fileName, const ByteArray& contents);
+    void writeEntry(EntryType type, const std::string& fileName, const ByteArray& data, ushort compressionMethod, uint crc_32,
+                    size_t uncompressedSize);
 
     Impl(IODevice* d)
         : device(d) {}
@@ -546,12 +552,6 @@ ZipContainer::FileInfo ZipContainer::Impl::fillFileInfo(int index) const
 
 void ZipContainer::Impl::addEntry(EntryType type, const std::string& fileName, const ByteArray& contents)
 {
-    if (!(device->isOpen() || device->open(IODevice::WriteOnly))) {
-        status = ZipContainer::FileOpenError;
-        return;
-    }
-    device->seek(start_of_directory);
-
     // don't compress small files
     ZipContainer::CompressionPolicy compression = compressionPolicy;
     if (compressionPolicy == ZipContainer::AutoCompress) {
@@ -562,19 +562,10 @@ void ZipContainer::Impl::addEntry(EntryType type, const std::string& fileName, c
         }
     }
 
-    FileHeader header;
-    std::memset(&header.h, 0, sizeof(CentralFileHeader));
-    writeUInt(header.h.signature, 0x02014b50);
-
-    writeUShort(header.h.version_needed, ZIP_VERSION);
-    writeUInt(header.h.uncompressed_size, (uint)contents.size());
-
-    std::time_t t = std::time(0);   // get time now
-    std::tm* now = std::localtime(&t);
-    writeMSDosDate(header.h.last_mod_file, *now);
+    ushort compressionMethod = CompressionMethodStored;
     ByteArray data = contents;
     if (compression == ZipContainer::AlwaysCompress) {
-        writeUShort(header.h.compression_method, CompressionMethodDeflated);
+        compressionMethod = CompressionMethodDeflated;
 
         ulong len = (ulong)contents.size();
         // shamelessly copied form zlib
@@ -582,7 +573,7 @@ void ZipContainer::Impl::addEntry(EntryType type, const std::string& fileName, c
         int res;
         do {
             data.resize(len);
-            res = deflate((uint8_t*)data.data(), &len, (const uint8_t*)contents.constData(), (ulong)contents.size());
+            res = deflate((uint8_t*)data.data(), &len, (const uint8_t*)contents.constData(), (ulong)contents.size(), compressionLevel);
 
             switch (res) {
             case Z_OK:
@@ -599,9 +590,34 @@ void ZipContainer::Impl::addEntry(EntryType type, const std::string& fileName, c
         } while (res == Z_BUF_ERROR);
     }
 // TODO add a check if data.size() > contents.size().  Then try to store the original and revert the compression method to be uncompressed
-    writeUInt(header.h.compressed_size, (uint)data.size());
     uint crc_32 = ::crc32(0, 0, 0);
     crc_32 = ::crc32(crc_32, (const uint8_t*)contents.constData(), (uint)contents.size());
+
+    writeEntry(type, fileName, data, compressionMethod, crc_32, contents.size());
+}
+
+void ZipContainer::Impl::writeEntry(EntryType type, const std::string& fileName, const ByteArray& data, ushort compressionMethod,
+                                    uint crc_32, size_t uncompressedSize)
+{
+    if (!(device->isOpen() || device->open(IODevice::WriteOnly))) {
+        status = ZipContainer::FileOpenError;
+        return;
+    }
+    device->seek(start_of_directory);
+
+    FileHeader header;
+    std::memset(&header.h, 0, sizeof(CentralFileHeader));
+    writeUInt(header.h.signature, 0x02014b50);
+
+    writeUShort(header.h.version_needed, ZIP_VERSION);
+    writeUInt(header.h.uncompressed_size, (uint)uncompressedSize);
+
+    std::time_t t = std::time(0);   // get time now
+    std::tm* now = std::localtime(&t);
+    writeMSDosDate(header.h.last_mod_file, *now);
+    writeUShort(header.h.compression_method, compressionMethod);
+
+    writeUInt(header.h.compressed_size, (uint)data.size());
     writeUInt(header.h.crc_32, crc_32);
 
     // if bit 11 is set, the filename and comment fields must be encoded using UTF-8
@@ -666,6 +682,7 @@ ZipContainer::~ZipContainer()
 
 std::vector<ZipContainer::FileInfo> ZipContainer::fileInfoList() const
 {
+    std::lock_guard<std::mutex> lock(p->deviceMutex);
     p->scanFiles();
     std::vector<FileInfo> files;
     const int numFileHeaders = (int)p->fileHeaders.size();
@@ -678,52 +695,65 @@ std::vector<ZipContainer::FileInfo> ZipContainer::fileInfoList() const
 
 int ZipContainer::count() const
 {
+    std::lock_guard<std::mutex> lock(p->deviceMutex);
     p->scanFiles();
     return (int)p->fileHeaders.size();
 }
 
 ByteArray ZipContainer::fileData(const std::string& fileName) const
 {
-    p->scanFiles();
+    int compressed_size = 0;
+    int uncompressed_size = 0;
+    int compression_method = 0;
+    ByteArray compressed;
 
-    size_t i;
-    for (i = 0; i < p->fileHeaders.size(); ++i) {
-        if (p->fileHeaders.at(i).file_name == ByteArray::fromRawData(fileName.c_str(), fileName.size())) {
-            break;
+    //! NOTE Only the access to the device is serialized. The compressed bytes are copied out and
+    //! inflated with a z_stream local to this call, so several files can be inflated concurrently
+    {
+        std::lock_guard<std::mutex> lock(p->deviceMutex);
+
+        p->scanFiles();
+
+        size_t i;
+        for (i = 0; i < p->fileHeaders.size(); ++i) {
+            if (p->fileHeaders.at(i).file_name == ByteArray::fromRawData(fileName.c_str(), fileName.size())) {
+                break;
+            }
         }
-    }
 
-    if (i == p->fileHeaders.size()) {
-        return ByteArray();
-    }
+        if (i == p->fileHeaders.size()) {
+            return ByteArray();
+        }
 
-    FileHeader header = p->fileHeaders.at(i);
+        const FileHeader& header = p->fileHeaders.at(i);
 
-    ushort version_needed = readUShort(header.h.version_needed);
-    if (version_needed > ZIP_VERSION) {
-        LOGW("Zip: .ZIP specification version %d implementationis needed to extract the data.", version_needed);
-        return ByteArray();
-    }
+        ushort version_needed = readUShort(header.h.version_needed);
+        if (version_needed > ZIP_VERSION) {
+            LOGW("Zip: .ZIP specification version %d implementationis needed to extract the data.", version_needed);
+            return ByteArray();
+        }
 
-    ushort general_purpose_bits = readUShort(header.h.general_purpose_bits);
-    int compressed_size = readUInt(header.h.compressed_size);
-    int uncompressed_size = readUInt(header.h.uncompressed_size);
-    int start = readUInt(header.h.offset_local_header);
+        ushort general_purpose_bits = readUShort(header.h.general_purpose_bits);
+        compressed_size = readUInt(header.h.compressed_size);
+        uncompressed_size = readUInt(header.h.uncompressed_size);
+        int start = readUInt(header.h.offset_local_header);
 
-    p->device->seek(start);
-    LocalFileHeader lh;
-    p->device->read((uint8_t*)&lh, sizeof(LocalFileHeader));
-    uint skip = readUShort(lh.file_name_length) + readUShort(lh.extra_field_length);
-    p->device->seek(p->device->pos() + skip);
+        p->device->seek(start);
+        LocalFileHeader lh;
+        p->device->read((uint8_t*)&lh, sizeof(LocalFileHeader));
+        uint skip = readUShort(lh.file_name_length) + readUShort(lh.extra_field_length);
+        p->device->seek(p->device->pos() + skip);
 
-    int compression_method = readUShort(lh.compression_method);
+        compression_method = readUShort(lh.compression_method);
 
-    if ((general_purpose_bits & Encrypted) != 0) {
-        LOGW("Zip: Unsupported encryption method is needed to extract the data.");
-        return ByteArray();
+        if ((general_purpose_bits & Encrypted) != 0) {
+            LOGW("Zip: Unsupported encryption method is needed to extract the data.");
+            return ByteArray();
+        }
+
+        compressed = p->device->read(compressed_size);
     }
 
-    ByteArray compressed = p->device->read(compressed_size);
     if (compression_method == CompressionMethodStored) {
         // no compression
         compressed.truncate(uncompressed_size);
@@ -779,11 +809,26 @@ ZipContainer::CompressionPolicy ZipContainer::compressionPolicy() const
     return p->compressionPolicy;
 }
 
+void ZipContainer::setCompressionLevel(int level)
+{
+    p->compressionLevel = level;
+}
+
+int ZipContainer::compressionLevel() const
+{
+    return p->compressionLevel;
+}
+
 void ZipContainer::addFile(const std::string& fileName, const ByteArray& data)
 {
     p->addEntry(Impl::File, Dir::fromNativeSeparators(fileName).toStdString(), data);
 }
 
+void ZipContainer::addDeflatedFile(const std::string& fileName, const ByteArray& deflatedData, uint crc, size_t size)
+{
+    p->writeEntry(Impl::File, Dir::fromNativeSeparators(fileName).toStdString(), deflatedData, CompressionMethodDeflated, crc, size);
+}
+
 void ZipContainer::addDirectory(const std::string& dirName)
 {
     std::string name(Dir::fromNativeSeparators(dirName).toStdString());
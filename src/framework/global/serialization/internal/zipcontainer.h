@@ -74,7 +74,13 @@ public:
     void setCompressionPolicy(CompressionPolicy policy);
     CompressionPolicy compressionPolicy() const;
 
+    //! NOTE zlib levels: 0 (no compression) to 9 (smallest), -1 is the default
+    void setCompressionLevel(int level);
+    int compressionLevel() const;
+
     void addFile(const std::string& fileName, const ByteArray& data);
+    //! NOTE Adds a file, which is already compressed by raw deflate
+    void addDeflatedFile(const std::string& fileName, const ByteArray& deflatedData, uint crc, size_t size);
     void addDirectory(const std::string& dirName);
 
 private:
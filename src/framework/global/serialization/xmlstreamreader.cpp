@@ -23,18 +23,15 @@
 
 #include <cstring>
 
-#include "thirdparty/tinyxml/tinyxml2.h"
+#include "internal/xmlpulltokenizer.h"
 
 #include "log.h"
 
 using namespace mu;
 using namespace mu::io;
-using namespace tinyxml2;
 
 struct XmlStreamReader::Xml {
-    XMLDocument doc;
-    XMLNode* node = nullptr;
-    XMLError err;
+    XmlPullTokenizer tokenizer;
     String customErr;
 };
 
@@ -46,8 +43,7 @@ XmlStreamReader::XmlStreamReader()
 XmlStreamReader::XmlStreamReader(IODevice* device)
 {
     m_xml = new Xml();
-    ByteArray data = device->readAll();
-    setData(data);
+    m_xml->tokenizer.setDevice(device);
 }
 
 XmlStreamReader::XmlStreamReader(const ByteArray& data)
@@ -73,14 +69,9 @@ XmlStreamReader::~XmlStreamReader()
 
 void XmlStreamReader::setData(const ByteArray& data)
 {
-    m_xml->doc.Clear();
-    m_xml->err = m_xml->doc.Parse(reinterpret_cast<const char*>(data.constData()), data.size());
-    m_token = m_xml->err == XML_SUCCESS ? TokenType::NoToken : TokenType::Invalid;
+    m_xml->tokenizer.setData(data.constData(), data.size());
+    m_token = TokenType::NoToken;
     m_xml->customErr.clear();
-
-    if (m_xml->err != XML_SUCCESS) {
-        LOGE() << errorString();
-    }
 }
 
 bool XmlStreamReader::readNextStartElement()
@@ -100,76 +91,47 @@ bool XmlStreamReader::atEnd() const
     return m_token == TokenType::EndDocument || m_token == TokenType::Invalid;
 }
 
-static XmlStreamReader::TokenType resolveToken(XMLNode* n, bool isStartElement)
-{
-    if (n->ToElement()) {
-        return isStartElement ? XmlStreamReader::TokenType::StartElement : XmlStreamReader::TokenType::EndElement;
-    } else if (n->ToText()) {
-        return XmlStreamReader::TokenType::Characters;
-    } else if (n->ToComment()) {
-        return XmlStreamReader::TokenType::Comment;
-    } else if (n->ToDeclaration()) {
-        return XmlStreamReader::TokenType::StartDocument;
-    } else if (n->ToDocument()) {
-        return XmlStreamReader::TokenType::EndDocument;
-    } else if (n->ToUnknown()) {
-        return XmlStreamReader::TokenType::DTD;
-    }
-    return XmlStreamReader::TokenType::Unknown;
-}
-
-static std::pair<XMLNode*, XmlStreamReader::TokenType> resolveNode(XMLNode* currentNode, XmlStreamReader::TokenType currentToken)
-{
-    if (currentToken == XmlStreamReader::TokenType::StartElement) {
-        XMLNode* child = currentNode->FirstChild();
-        if (child) {
-            return { child, resolveToken(child, true) };
-        }
-
-        XMLNode* sibling = currentNode->NextSibling();
-        if (!sibling || sibling->ToElement() || sibling->ToText()) {
-            return { currentNode, XmlStreamReader::TokenType::EndElement };
-        }
-    }
-
-    XMLNode* sibling = currentNode->NextSibling();
-    if (sibling) {
-        return { sibling, resolveToken(sibling, true) };
-    }
-
-    XMLNode* parent = currentNode->Parent();
-    if (parent) {
-        return { parent, resolveToken(parent, false) };
-    }
-
-    return { nullptr, XmlStreamReader::TokenType::EndDocument };
-}
-
 XmlStreamReader::TokenType XmlStreamReader::readNext()
 {
     if (m_token == TokenType::Invalid) {
         return m_token;
     }
 
-    if (m_xml->err != XML_SUCCESS || m_token == EndDocument) {
-        m_xml->node = nullptr;
+    if (m_token == TokenType::EndDocument) {
         m_token = TokenType::Invalid;
         return m_token;
     }
 
-    if (!m_xml->node) {
-        m_xml->node = m_xml->doc.FirstChild();
-        m_token = m_xml->node->ToDeclaration() ? TokenType::StartDocument : resolveToken(m_xml->node, true);
-        return m_token;
-    }
-
-    std::pair<XMLNode*, XmlStreamReader::TokenType> p = resolveNode(m_xml->node, m_token);
-
-    m_xml->node = p.first;
-    m_token = p.second;
-
-    if (m_token == XmlStreamReader::TokenType::DTD) {
+    switch (m_xml->tokenizer.next()) {
+    case XmlPullTokenizer::Declaration:
+        m_token = TokenType::StartDocument;
+        break;
+    case XmlPullTokenizer::StartElement:
+        m_token = TokenType::StartElement;
+        break;
+    case XmlPullTokenizer::EndElement:
+        m_token = TokenType::EndElement;
+        break;
+    case XmlPullTokenizer::Text:
+        m_token = TokenType::Characters;
+        break;
+    case XmlPullTokenizer::Comment:
+        m_token = TokenType::Comment;
+        break;
+    case XmlPullTokenizer::Unknown:
+        m_token = TokenType::DTD;
         tryParseEntity(m_xml);
+        break;
+    case XmlPullTokenizer::EndDocument:
+        m_token = TokenType::EndDocument;
+        break;
+    case XmlPullTokenizer::Error:
+        LOGE() << errorString();
+        m_token = TokenType::Invalid;
+        break;
+    case XmlPullTokenizer::NoToken:
+        m_token = TokenType::Invalid;
+        break;
     }
 
     return m_token;
@@ -179,7 +141,7 @@ void XmlStreamReader::tryParseEntity(Xml* xml)
 {
     static const char* ENTITY = { "ENTITY" };
 
-    const char* str = xml->node->Value();
+    const char* str = xml->tokenizer.value().ascii();
     if (std::strncmp(str, ENTITY, 6) == 0) {
         String val = String::fromUtf8(str);
         StringList list = val.split(' ');
@@ -195,7 +157,7 @@ void XmlStreamReader::tryParseEntity(Xml* xml)
 
 String XmlStreamReader::nodeValue(Xml* xml) const
 {
-    String str = String::fromUtf8(xml->node->Value());
+    String str = String::fromUtf8(xml->tokenizer.value().ascii());
     if (!m_entities.empty()) {
         for (const auto& p : m_entities) {
             str.replace(p.first, p.second);
@@ -245,7 +207,10 @@ void XmlStreamReader::skipCurrentElement()
 
 AsciiStringView XmlStreamReader::name() const
 {
-    return (m_xml->node && m_xml->node->ToElement()) ? m_xml->node->Value() : AsciiStringView();
+    if (m_token == TokenType::StartElement || m_token == TokenType::EndElement) {
+        return m_xml->tokenizer.name();
+    }
+    return AsciiStringView();
 }
 
 bool XmlStreamReader::hasAttribute(const char* name) const
@@ -254,11 +219,7 @@ bool XmlStreamReader::hasAttribute(const char* name) const
         return false;
     }
 
-    XMLElement* e = m_xml->node->ToElement();
-    if (!e) {
-        return false;
-    }
-    return e->FindAttribute(name) != nullptr;
+    return m_xml->tokenizer.attribute(name) != nullptr;
 }
 
 String XmlStreamReader::attribute(const char* name) const
@@ -267,11 +228,11 @@ String XmlStreamReader::attribute(const char* name) const
         return String();
     }
 
-    XMLElement* e = m_xml->node->ToElement();
-    if (!e) {
+    const XmlPullTokenizer::Attribute* a = m_xml->tokenizer.attribute(name);
+    if (!a) {
         return String();
     }
-    return String::fromUtf8(e->Attribute(name));
+    return String::fromUtf8(a->value.ascii());
 }
 
 String XmlStreamReader::attribute(const char* name, const String& def) const
@@ -285,11 +246,11 @@ AsciiStringView XmlStreamReader::asciiAttribute(const char* name) const
         return AsciiStringView();
     }
 
-    XMLElement* e = m_xml->node->ToElement();
-    if (!e) {
+    const XmlPullTokenizer::Attribute* a = m_xml->tokenizer.attribute(name);
+    if (!a) {
         return AsciiStringView();
     }
-    return e->Attribute(name);
+    return a->value;
 }
 
 AsciiStringView XmlStreamReader::asciiAttribute(const char* name, const AsciiStringView& def) const
@@ -324,15 +285,12 @@ std::vector<XmlStreamReader::Attribute> XmlStreamReader::attributes() const
         return attrs;
     }
 
-    XMLElement* e = m_xml->node->ToElement();
-    if (!e) {
-        return attrs;
-    }
-
-    for (const XMLAttribute* xa = e->FirstAttribute(); xa; xa = xa->Next()) {
+    const std::vector<XmlPullTokenizer::Attribute>& tokenAttrs = m_xml->tokenizer.attributes();
+    attrs.reserve(tokenAttrs.size());
+    for (const XmlPullTokenizer::Attribute& ta : tokenAttrs) {
         Attribute a;
-        a.name = xa->Name();
-        a.value = String::fromUtf8(xa->Value());
+        a.name = ta.name;
+        a.value = String::fromUtf8(ta.value.ascii());
         attrs.push_back(std::move(a));
     }
     return attrs;
@@ -340,7 +298,7 @@ std::vector<XmlStreamReader::Attribute> XmlStreamReader::attributes() const
 
 String XmlStreamReader::text() const
 {
-    if (m_xml->node && (m_xml->node->ToText() || m_xml->node->ToComment())) {
+    if (m_token == TokenType::Characters || m_token == TokenType::Comment) {
         return nodeValue(m_xml);
     }
     return String();
@@ -348,8 +306,8 @@ String XmlStreamReader::text() const
 
 AsciiStringView XmlStreamReader::asciiText() const
 {
-    if (m_xml->node && (m_xml->node->ToText() || m_xml->node->ToComment())) {
-        return m_xml->node->Value();
+    if (m_token == TokenType::Characters || m_token == TokenType::Comment) {
+        return m_xml->tokenizer.value();
     }
     return AsciiStringView();
 }
@@ -384,7 +342,7 @@ AsciiStringView XmlStreamReader::readAsciiText()
         while (1) {
             switch (readNext()) {
             case Characters:
-                result = AsciiStringView(m_xml->node->Value());
+                result = m_xml->tokenizer.value();
                 break;
             case EndElement:
                 return result;
@@ -414,7 +372,7 @@ double XmlStreamReader::readDouble(bool* ok)
 
 int64_t XmlStreamReader::lineNumber() const
 {
-    return m_xml->doc.ErrorLineNum();
+    return m_xml->tokenizer.lineNumber();
 }
 
 int64_t XmlStreamReader::columnNumber() const
@@ -428,12 +386,11 @@ XmlStreamReader::Error XmlStreamReader::error() const
         return CustomError;
     }
 
-    XMLError err = m_xml->doc.ErrorID();
-    if (err == XML_SUCCESS) {
-        return NoError;
+    if (m_xml->tokenizer.tokenType() == XmlPullTokenizer::Error) {
+        return NotWellFormedError;
     }
 
-    return NotWellFormedError;
+    return NoError;
 }
 
 bool XmlStreamReader::isError() const
@@ -446,7 +403,7 @@ String XmlStreamReader::errorString() const
     if (!m_xml->customErr.empty()) {
         return m_xml->customErr;
     }
-    return String::fromUtf8(m_xml->doc.ErrorStr());
+    return String::fromUtf8(m_xml->tokenizer.errorString().c_str());
 }
 
 void XmlStreamReader::raiseError(const String& message)
@@ -52,6 +52,8 @@ public:
     bool hasError() const;
 
     std::vector<FileInfo> fileInfoList() const;
+
+    //! NOTE Can be called from several threads at once
     ByteArray fileData(const std::string& fileName) const;
 
 private:
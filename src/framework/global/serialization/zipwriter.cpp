@@ -21,17 +21,260 @@
  */
 #include "zipwriter.h"
 
+#include <chrono>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <zlib.h>
+
 #include "internal/zipcontainer.h"
 #include "io/file.h"
+#include "concurrency.h"
 
 #include "log.h"
 
 using namespace mu;
 
+//! NOTE Amount of data compressed by one job
+static constexpr size_t CHUNK_SIZE = 256 * 1024;
+
+namespace {
+//! NOTE A file being compressed. It is compressed by a chain of jobs, one chunk per job,
+//! so only one job at a time works on the same file
+struct Entry
+{
+    std::string fileName;
+    int compressionLevel = Z_DEFAULT_COMPRESSION;
+
+    ByteArray deflatedData;
+    size_t deflatedSize = 0;
+    uint crc = 0;
+    size_t size = 0;
+    bool ok = true;
+
+    bool isEnded = false;
+    std::future<void> job;
+
+    Entry(const std::string& fileName, int compressionLevel)
+        : fileName(fileName), compressionLevel(compressionLevel) {}
+
+    ~Entry()
+    {
+        waitJob();
+        if (m_isStreamInited) {
+            deflateEnd(&m_stream);
+        }
+    }
+
+    bool isJobRunning() const
+    {
+        return job.valid() && job.wait_for(std::chrono::seconds(0)) != std::future_status::ready;
+    }
+
+    void waitJob()
+    {
+        if (job.valid()) {
+            job.wait();
+        }
+    }
+
+    void deflate(const ByteArray& chunk, bool finish)
+    {
+        if (!ok) {
+            return;
+        }
+
+        if (!m_isStreamInited) {
+            std::memset(&m_stream, 0, sizeof(z_stream));
+            if (deflateInit2(&m_stream, compressionLevel, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+                ok = false;
+                return;
+            }
+            m_isStreamInited = true;
+            crc = ::crc32(0, 0, 0);
+        }
+
+        crc = ::crc32(crc, chunk.constData(), (uInt)chunk.size());
+        size += chunk.size();
+
+        m_stream.next_in = const_cast<Bytef*>(chunk.constData());
+        m_stream.avail_in = (uInt)chunk.size();
+
+        for (;;) {
+            if (deflatedSize == deflatedData.size()) {
+                deflatedData.resize(std::max(deflatedData.size() * 2, chunk.size() / 2 + 64));
+            }
+
+            m_stream.next_out = deflatedData.data() + deflatedSize;
+            m_stream.avail_out = (uInt)(deflatedData.size() - deflatedSize);
+
+            int err = ::deflate(&m_stream, finish ? Z_FINISH : Z_NO_FLUSH);
+            deflatedSize = deflatedData.size() - m_stream.avail_out;
+
+            if (err == Z_STREAM_ERROR) {
+                ok = false;
+                return;
+            }
+
+            bool done = finish ? err == Z_STREAM_END : (m_stream.avail_in == 0 && m_stream.avail_out != 0);
+            if (done) {
+                break;
+            }
+        }
+
+        if (finish) {
+            deflatedData.resize(deflatedSize);
+            deflateEnd(&m_stream);
+            m_isStreamInited = false;
+        }
+    }
+
+private:
+    z_stream m_stream;
+    bool m_isStreamInited = false;
+};
+
+//! NOTE Collects the written data into chunks and passes them on
+class FileStream : public io::IODevice
+{
+public:
+    using OnChunk = std::function<void (const ByteArray& chunk)>;
+
+    FileStream(const OnChunk& onChunk)
+        : m_onChunk(onChunk)
+    {
+        m_chunk.reserve(CHUNK_SIZE);
+    }
+
+    ByteArray takeChunk()
+    {
+        ByteArray chunk = m_chunk;
+        m_chunk = ByteArray();
+        return chunk;
+    }
+
+protected:
+    bool doOpen(OpenMode m) override
+    {
+        return m == OpenMode::WriteOnly;
+    }
+
+    size_t dataSize() const override
+    {
+        return m_size;
+    }
+
+    const uint8_t* rawData() const override
+    {
+        return nullptr;
+    }
+
+    bool resizeData(size_t size) override
+    {
+        m_size = size;
+        return true;
+    }
+
+    size_t writeData(const uint8_t* data, size_t len) override
+    {
+        size_t left = len;
+        while (left > 0) {
+            size_t count = std::min(left, CHUNK_SIZE - m_chunk.size());
+            m_chunk.push_back(data, count);
+            data += count;
+            left -= count;
+
+            if (m_chunk.size() == CHUNK_SIZE) {
+                m_onChunk(takeChunk());
+                m_chunk.reserve(CHUNK_SIZE);
+            }
+        }
+        return len;
+    }
+
+private:
+    OnChunk m_onChunk;
+    ByteArray m_chunk;
+    size_t m_size = 0;
+};
+}
+
 struct ZipWriter::Impl
 {
     ZipContainer* zip = nullptr;
+
+    int compressionLevel = Z_DEFAULT_COMPRESSION;
+    size_t maxJobCount = concurrency::idealThreadCount();
+
+    std::deque<std::shared_ptr<Entry> > entries;
+    std::shared_ptr<Entry> streamEntry;
+    std::unique_ptr<FileStream> stream;
+
+    bool hasError = false;
     bool isClosed = false;
+
+    void startJob(const std::shared_ptr<Entry>& entry, const ByteArray& chunk, bool finish)
+    {
+        entry->waitJob();
+
+        while (runningJobCount() >= maxJobCount) {
+            for (const std::shared_ptr<Entry>& e : entries) {
+                if (e->isJobRunning()) {
+                    e->waitJob();
+                    break;
+                }
+            }
+        }
+
+        //! NOTE The entry waits for its job before it's deleted
+        Entry* e = entry.get();
+        entry->job = concurrency::runAsync([e, chunk, finish]() {
+            e->deflate(chunk, finish);
+        });
+        entry->isEnded = finish;
+
+        writeCompressedEntries(false);
+    }
+
+    size_t runningJobCount() const
+    {
+        size_t count = 0;
+        for (const std::shared_ptr<Entry>& e : entries) {
+            if (e->isJobRunning()) {
+                ++count;
+            }
+        }
+        return count;
+    }
+
+    //! NOTE Compressed entries are written to the device as soon as they and all entries before them are done,
+    //! so only the entries being compressed are kept in memory
+    void writeCompressedEntries(bool wait)
+    {
+        while (!entries.empty()) {
+            const std::shared_ptr<Entry>& entry = entries.front();
+            if (!entry->isEnded) {
+                break;
+            }
+
+            if (wait) {
+                entry->waitJob();
+            } else if (entry->isJobRunning()) {
+                break;
+            }
+
+            if (entry->ok) {
+                zip->addDeflatedFile(entry->fileName, entry->deflatedData, entry->crc, entry->size);
+            } else {
+                LOGE() << "failed compress file: " << entry->fileName;
+                hasError = true;
+            }
+
+            entries.pop_front();
+        }
+    }
 };
 
 ZipWriter::ZipWriter(const io::path_t& filePath)
@@ -75,6 +318,11 @@ void ZipWriter::close()
         return;
     }
 
+    if (m_impl->stream) {
+        endFile();
+    }
+    m_impl->writeCompressedEntries(true);
+
     m_impl->zip->close();
     if (m_device) {
         flush();
@@ -86,11 +334,53 @@ void ZipWriter::close()
 
 bool ZipWriter::hasError() const
 {
-    return m_impl->zip->status() != ZipContainer::NoError;
+    return m_impl->hasError || m_impl->zip->status() != ZipContainer::NoError;
+}
+
+void ZipWriter::setCompressionLevel(int level)
+{
+    m_impl->compressionLevel = level;
+}
+
+int ZipWriter::compressionLevel() const
+{
+    return m_impl->compressionLevel;
 }
 
 void ZipWriter::addFile(const std::string& fileName, const ByteArray& data)
 {
-    m_impl->zip->addFile(fileName, data);
-    flush();
+    io::IODevice* device = beginFile(fileName);
+    device->write(data);
+    endFile();
+}
+
+io::IODevice* ZipWriter::beginFile(const std::string& fileName)
+{
+    IF_ASSERT_FAILED(!m_impl->stream) {
+        endFile();
+    }
+
+    std::shared_ptr<Entry> entry = std::make_shared<Entry>(fileName, m_impl->compressionLevel);
+    m_impl->entries.push_back(entry);
+    m_impl->streamEntry = entry;
+
+    Impl* impl = m_impl;
+    m_impl->stream = std::make_unique<FileStream>([impl, entry](const ByteArray& chunk) {
+        impl->startJob(entry, chunk, false);
+    });
+    m_impl->stream->open(io::IODevice::WriteOnly);
+
+    return m_impl->stream.get();
+}
+
+void ZipWriter::endFile()
+{
+    IF_ASSERT_FAILED(m_impl->stream) {
+        return;
+    }
+
+    m_impl->startJob(m_impl->streamEntry, m_impl->stream->takeChunk(), true);
+
+    m_impl->stream.reset();
+    m_impl->streamEntry.reset();
 }
@@ -22,6 +22,8 @@
 #ifndef MU_GLOBAL_ZIPWRITER_H
 #define MU_GLOBAL_ZIPWRITER_H
 
+#include <string>
+
 #include "io/path.h"
 #include "io/iodevice.h"
 
@@ -37,8 +39,20 @@ public:
     void close();
     bool hasError() const;
 
+    //! NOTE zlib levels: 1 is the fastest, 9 the smallest, -1 is the default (6)
+    void setCompressionLevel(int level);
+    int compressionLevel() const;
+
+    //! NOTE Files are compressed on the threads of concurrency::runAsync, in parallel with each other
+    //! and with the caller, and are written to the device by the caller in the order they were added
     void addFile(const std::string& fileName, const ByteArray& data);
 
+    //! NOTE Returns a device, that compresses the data as it is written to it,
+    //! so the whole uncompressed file is not kept in memory.
+    //! The device is valid until endFile(), one file can be written at a time
+    io::IODevice* beginFile(const std::string& fileName);
+    void endFile();
+
 private:
 
     void flush();
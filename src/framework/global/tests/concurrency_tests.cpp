@@ -0,0 +1,138 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "concurrency.h"
+
+using namespace mu;
+
+class Global_ConcurrencyTests : public ::testing::Test
+{
+};
+
+TEST_F(Global_ConcurrencyTests, ParallelFor_EachJobRunsOnce)
+{
+    //! GIVEN More jobs than threads
+    std::vector<std::atomic<int> > calls(100);
+
+    //! WHEN Running them in parallel
+    concurrency::parallelFor(calls.size(), [&calls](size_t jobIdx) {
+        calls[jobIdx].fetch_add(1);
+    }, 4);
+
+    //! THEN Every job was executed exactly once
+    for (const std::atomic<int>& count : calls) {
+        EXPECT_EQ(count.load(), 1);
+    }
+}
+
+TEST_F(Global_ConcurrencyTests, ParallelFor_UsesThreads)
+{
+    //! GIVEN Jobs which wait for each other, so they can't run one after another
+    std::mutex mutex;
+    std::set<std::thread::id> threads;
+    std::atomic<int> started = 0;
+
+    //! WHEN Running them on the same amount of threads
+    concurrency::parallelFor(3, [&](size_t) {
+        {
+            std::lock_guard lock(mutex);
+            threads.insert(std::this_thread::get_id());
+        }
+
+        started.fetch_add(1);
+        while (started.load() < 3) {
+            std::this_thread::yield();
+        }
+    }, 3);
+
+    //! THEN Each job was run by its own thread, including the calling one
+    EXPECT_EQ(threads.size(), 3);
+    EXPECT_TRUE(threads.find(std::this_thread::get_id()) != threads.end());
+}
+
+TEST_F(Global_ConcurrencyTests, ParallelFor_SingleThread)
+{
+    //! GIVEN Jobs limited to one thread
+    std::vector<size_t> order;
+
+    //! WHEN Running them
+    concurrency::parallelFor(5, [&order](size_t jobIdx) {
+        order.push_back(jobIdx);
+    }, 1);
+
+    //! THEN They are run in order on the calling thread
+    EXPECT_EQ(order, std::vector<size_t>({ 0, 1, 2, 3, 4 }));
+}
+
+TEST_F(Global_ConcurrencyTests, RunAsync_RunsEachTask)
+{
+    //! GIVEN More tasks than threads
+    std::vector<std::atomic<int> > calls(100);
+    std::vector<std::future<void> > futures;
+
+    //! WHEN Running them on the pool
+    for (std::atomic<int>& count : calls) {
+        futures.push_back(concurrency::runAsync([&count]() {
+            count.fetch_add(1);
+        }));
+    }
+
+    for (std::future<void>& future : futures) {
+        future.wait();
+    }
+
+    //! THEN Every task was executed exactly once
+    for (const std::atomic<int>& count : calls) {
+        EXPECT_EQ(count.load(), 1);
+    }
+}
+
+TEST_F(Global_ConcurrencyTests, RunAsync_ReusesThreads)
+{
+    //! GIVEN Many tasks, which remember their thread
+    std::mutex mutex;
+    std::set<std::thread::id> threads;
+    std::vector<std::future<void> > futures;
+
+    //! WHEN Running them on the pool
+    for (size_t i = 0; i < 100; ++i) {
+        futures.push_back(concurrency::runAsync([&]() {
+            std::lock_guard lock(mutex);
+            threads.insert(std::this_thread::get_id());
+        }));
+    }
+
+    for (std::future<void>& future : futures) {
+        future.wait();
+    }
+
+    //! THEN No more threads were used than the pool has, and not the calling one
+    EXPECT_LE(threads.size(), concurrency::idealThreadCount());
+    EXPECT_TRUE(threads.find(std::this_thread::get_id()) == threads.end());
+}
@@ -0,0 +1,77 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <fstream>
+
+#include "io/mappedfile.h"
+
+using namespace mu;
+using namespace mu::io;
+
+class Global_IO_MappedFileTests : public ::testing::Test
+{
+public:
+};
+
+TEST_F(Global_IO_MappedFileTests, Map_Existing_File)
+{
+    //! GIVEN Some file
+    path_t filePath("MappedFileTests_Map_Existing_File.bin");
+    std::string ref = "Hello World!";
+    {
+        std::ofstream stream(filePath.toStdString(), std::ios::binary);
+        stream << ref;
+    }
+
+    MappedFile file(filePath);
+
+    //! DO Map the file
+    EXPECT_TRUE(file.open());
+
+    //! CHECK The whole content is available
+    EXPECT_TRUE(file.isOpen());
+    ASSERT_EQ(file.size(), ref.size());
+    EXPECT_EQ(std::memcmp(file.data(), ref.c_str(), ref.size()), 0);
+
+    //! DO Unmap the file
+    file.close();
+
+    //! CHECK
+    EXPECT_FALSE(file.isOpen());
+    EXPECT_EQ(file.data(), nullptr);
+    EXPECT_EQ(file.size(), 0);
+}
+
+TEST_F(Global_IO_MappedFileTests, Map_Missing_File)
+{
+    //! GIVEN Some file which doesn't exist
+    MappedFile file(path_t("MappedFileTests_Map_Missing_File.bin"));
+
+    //! DO Map the file
+    EXPECT_FALSE(file.open());
+
+    //! CHECK
+    EXPECT_FALSE(file.isOpen());
+    EXPECT_EQ(file.data(), nullptr);
+}
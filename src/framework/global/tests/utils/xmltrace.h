@@ -0,0 +1,117 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_GLOBAL_XMLTRACE_H
+#define MU_GLOBAL_XMLTRACE_H
+
+#include <string>
+
+#include "serialization/xmlstreamreader.h"
+#include "types/bytearray.h"
+
+#include "thirdparty/tinyxml/tinyxml2.h"
+
+namespace mu::io {
+inline ByteArray toByteArray(const std::string& str)
+{
+    return ByteArray(reinterpret_cast<const uint8_t*>(str.c_str()), str.size());
+}
+
+inline std::string toStdString(const AsciiStringView& str)
+{
+    return std::string(str.ascii(), str.size());
+}
+
+//! NOTE Writes every token in a compact form, so the whole document can be compared at once
+inline std::string readTrace(XmlStreamReader& xml)
+{
+    std::string trace;
+    while (xml.readNext() != XmlStreamReader::Invalid) {
+        switch (xml.tokenType()) {
+        case XmlStreamReader::StartDocument:
+            trace += "<?>";
+            break;
+        case XmlStreamReader::StartElement:
+            trace += "<" + toStdString(xml.name());
+            for (const XmlStreamReader::Attribute& a : xml.attributes()) {
+                trace += " " + toStdString(a.name) + "=" + a.value.toStdString();
+            }
+            trace += ">";
+            break;
+        case XmlStreamReader::EndElement:
+            trace += "</" + toStdString(xml.name()) + ">";
+            break;
+        case XmlStreamReader::Characters:
+            trace += "[" + toStdString(xml.asciiText()) + "]";
+            break;
+        case XmlStreamReader::Comment:
+            trace += "{" + toStdString(xml.asciiText()) + "}";
+            break;
+        case XmlStreamReader::DTD:
+            trace += "<!>";
+            break;
+        case XmlStreamReader::EndDocument:
+            trace += "$";
+            break;
+        default:
+            break;
+        }
+    }
+    return trace;
+}
+
+inline void walkDom(const tinyxml2::XMLNode* node, std::string& trace)
+{
+    for (const tinyxml2::XMLNode* n = node->FirstChild(); n; n = n->NextSibling()) {
+        if (const tinyxml2::XMLElement* e = n->ToElement()) {
+            trace += std::string("<") + e->Name();
+            for (const tinyxml2::XMLAttribute* a = e->FirstAttribute(); a; a = a->Next()) {
+                trace += std::string(" ") + a->Name() + "=" + a->Value();
+            }
+            trace += ">";
+            walkDom(n, trace);
+            trace += std::string("</") + e->Name() + ">";
+        } else if (n->ToText()) {
+            trace += std::string("[") + n->Value() + "]";
+        } else if (n->ToComment()) {
+            trace += std::string("{") + n->Value() + "}";
+        } else if (n->ToDeclaration()) {
+            trace += "<?>";
+        } else if (n->ToUnknown()) {
+            trace += "<!>";
+        }
+    }
+}
+
+inline std::string readDomTrace(const std::string& data)
+{
+    tinyxml2::XMLDocument doc;
+    if (doc.Parse(data.c_str(), data.size()) != tinyxml2::XML_SUCCESS) {
+        return std::string();
+    }
+
+    std::string trace;
+    walkDom(&doc, trace);
+    return trace + "$";
+}
+}
+
+#endif // MU_GLOBAL_XMLTRACE_H
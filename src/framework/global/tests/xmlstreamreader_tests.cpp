@@ -0,0 +1,397 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include "serialization/xmlstreamreader.h"
+#include "serialization/internal/xmlpulltokenizer.h"
+#include "io/buffer.h"
+
+#include "utils/xmltrace.h"
+
+using namespace mu;
+using namespace mu::io;
+
+class Global_Ser_XmlStreamReaderTests : public ::testing::Test
+{
+public:
+};
+
+TEST_F(Global_Ser_XmlStreamReaderTests, Read_Elements)
+{
+    //! GIVEN Some document
+    std::string data
+        = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+          "<museScore version=\"4.00\">\n"
+          "  <Score>\n"
+          "    <Division>480</Division>\n"
+          "    <metaTag name=\"title\"/>\n"
+          "    <!-- comment -->\n"
+          "    <Part id='1' name=\"Flute\"></Part>\n"
+          "  </Score>\n"
+          "</museScore>\n";
+
+    XmlStreamReader xml(toByteArray(data));
+
+    //! DO Read all tokens
+    std::string trace = readTrace(xml);
+
+    //! CHECK Whitespace between the nodes is dropped, an empty element has its end
+    EXPECT_EQ(trace, "<?><museScore version=4.00><Score><Division>[480]</Division><metaTag name=title></metaTag>"
+                     "{ comment }<Part id=1 name=Flute></Part></Score></museScore>$");
+    EXPECT_FALSE(xml.isError());
+    EXPECT_EQ(xml.tokenType(), XmlStreamReader::Invalid);
+}
+
+TEST_F(Global_Ser_XmlStreamReaderTests, Read_Attributes_And_Text)
+{
+    //! GIVEN Some element with attributes and text
+    std::string data = "<Note pitch=\"60\" tpc=\"14\" tuning=\"-12.5\" name=\"a &amp; b\">  x &lt; y&#x20AC;&#8364;&unknown;\r\nz </Note>";
+
+    XmlStreamReader xml(toByteArray(data));
+
+    //! DO Read the element
+    ASSERT_TRUE(xml.readNextStartElement());
+
+    //! CHECK The attributes
+    EXPECT_EQ(xml.name(), "Note");
+    EXPECT_TRUE(xml.hasAttribute("pitch"));
+    EXPECT_FALSE(xml.hasAttribute("velocity"));
+    EXPECT_EQ(xml.intAttribute("pitch"), 60);
+    EXPECT_EQ(xml.intAttribute("velocity", 80), 80);
+    EXPECT_DOUBLE_EQ(xml.doubleAttribute("tuning"), -12.5);
+    EXPECT_EQ(xml.asciiAttribute("tpc"), "14");
+    EXPECT_EQ(xml.attribute("name"), u"a & b");
+    EXPECT_EQ(xml.attributes().size(), 4);
+
+    //! CHECK The text keeps the surrounding whitespace, entities and new lines are decoded
+    EXPECT_EQ(xml.readText(), String::fromUtf8("  x < y€€&unknown;\nz "));
+    EXPECT_EQ(xml.name(), "Note");
+    EXPECT_TRUE(xml.isEndElement());
+}
+
+TEST_F(Global_Ser_XmlStreamReaderTests, Read_Numbers)
+{
+    //! GIVEN Some elements with numbers
+    std::string data = "<a><b>42</b><c>0.25</c><d>x</d></a>";
+
+    XmlStreamReader xml(toByteArray(data));
+    ASSERT_TRUE(xml.readNextStartElement());
+
+    //! DO Read the numbers
+    bool ok = false;
+    ASSERT_TRUE(xml.readNextStartElement());
+    EXPECT_EQ(xml.readInt(&ok), 42);
+    EXPECT_TRUE(ok);
+
+    ASSERT_TRUE(xml.readNextStartElement());
+    EXPECT_DOUBLE_EQ(xml.readDouble(&ok), 0.25);
+    EXPECT_TRUE(ok);
+
+    ASSERT_TRUE(xml.readNextStartElement());
+    xml.readInt(&ok);
+    EXPECT_FALSE(ok);
+
+    //! CHECK The end of the parent
+    EXPECT_FALSE(xml.readNextStartElement());
+    EXPECT_EQ(xml.name(), "a");
+}
+
+TEST_F(Global_Ser_XmlStreamReaderTests, Read_CData_Comments_And_Entities)
+{
+    //! GIVEN Some document with a CDATA section, a comment and an own entity
+    std::string data
+        = "<!DOCTYPE museScore>\n"
+          "<!ENTITY ms \"MuseScore\">\n"
+          "<a><![CDATA[<b>&amp;</b>]]><!-- <c/> --><d>&ms; 4</d></a>";
+
+    XmlStreamReader xml(toByteArray(data));
+
+    //! DO Read all tokens
+    std::string trace = readTrace(xml);
+
+    //! CHECK CDATA is not decoded
+    EXPECT_EQ(trace, "<!><!><a>[<b>&amp;</b>]{ <c/> }<d>[&ms; 4]</d></a>$");
+    EXPECT_FALSE(xml.isError());
+
+    //! CHECK The own entities are replaced in the text
+    XmlStreamReader xml2(toByteArray(data));
+    while (xml2.readNextStartElement()) {
+        if (xml2.name() == "d") {
+            EXPECT_EQ(xml2.readText(), u"MuseScore 4");
+        }
+    }
+}
+
+TEST_F(Global_Ser_XmlStreamReaderTests, Read_Skip_Element)
+{
+    //! GIVEN Some document with nested elements
+    std::string data = "<a><b><c><d/></c>text</b><e/></a>";
+
+    XmlStreamReader xml(toByteArray(data));
+    ASSERT_TRUE(xml.readNextStartElement());
+    ASSERT_TRUE(xml.readNextStartElement());
+    EXPECT_EQ(xml.name(), "b");
+
+    //! DO Skip the element
+    xml.skipCurrentElement();
+
+    //! CHECK The next element is the sibling
+    EXPECT_EQ(xml.name(), "b");
+    ASSERT_TRUE(xml.readNextStartElement());
+    EXPECT_EQ(xml.name(), "e");
+}
+
+TEST_F(Global_Ser_XmlStreamReaderTests, Read_Not_Well_Formed)
+{
+    std::vector<std::string> documents = {
+        "",
+        "   ",
+        "<a><b></a>",
+        "<a>",
+        "<a b=\"1\" b=\"2\"/>",
+        "<a b=1/>",
+        "<a><?xml version=\"1.0\"?></a>",
+        "<a><!-- comment </a>",
+        "<a>text"
+    };
+
+    for (const std::string& data : documents) {
+        //! GIVEN Some broken document
+        XmlStreamReader xml(toByteArray(data));
+
+        //! DO Read all tokens
+        readTrace(xml);
+
+        //! CHECK The error is reported
+        EXPECT_TRUE(xml.isError()) << data;
+        EXPECT_EQ(xml.error(), XmlStreamReader::NotWellFormedError) << data;
+        EXPECT_FALSE(xml.errorString().empty()) << data;
+        EXPECT_TRUE(xml.atEnd()) << data;
+    }
+}
+
+TEST_F(Global_Ser_XmlStreamReaderTests, Read_Error_Line_Number)
+{
+    //! GIVEN Some document with a mismatched element on the third line
+    std::string data = "<a>\n<b>\n</c>\n</a>";
+
+    XmlStreamReader xml(toByteArray(data));
+
+    //! DO Read all tokens
+    readTrace(xml);
+
+    //! CHECK
+    EXPECT_TRUE(xml.isError());
+    EXPECT_EQ(xml.lineNumber(), 3);
+}
+
+TEST_F(Global_Ser_XmlStreamReaderTests, Read_From_Device_In_Chunks)
+{
+    //! GIVEN Some document, long enough to cross many chunk boundaries
+    std::string data = "<?xml version=\"1.0\"?>\n<museScore>\n";
+    for (int i = 0; i < 2000; ++i) {
+        std::string n = std::to_string(i);
+        data += "  <Chord id=\"" + n + "\" text='&quot;" + n + "&quot;'>\r\n"
+                "    <!-- note " + n + " --><Note><pitch>" + n + "</pitch><![CDATA[" + n + "]]></Note><Rest/>\n"
+                "  </Chord>\n";
+    }
+    data += "</museScore>\n";
+
+    ByteArray ba = toByteArray(data);
+    Buffer buf(&ba);
+    buf.open(IODevice::ReadOnly);
+
+    //! DO Read the document from the device
+    XmlStreamReader xml(&buf);
+
+    std::vector<std::string> names;
+    std::vector<AsciiStringView> openNames;
+    while (xml.readNext() != XmlStreamReader::Invalid) {
+        if (xml.isStartElement()) {
+            names.push_back(toStdString(xml.name()));
+            openNames.push_back(xml.name());
+        } else if (xml.isEndElement()) {
+            //! CHECK The names of the open elements stay valid
+            ASSERT_FALSE(openNames.empty());
+            EXPECT_EQ(openNames.back(), xml.name());
+            openNames.pop_back();
+        }
+    }
+
+    //! CHECK All the elements are read
+    EXPECT_FALSE(xml.isError());
+    ASSERT_EQ(names.size(), 2000 * 4 + 1);
+    EXPECT_EQ(names.at(0), "museScore");
+    for (size_t i = 1; i < names.size(); i += 4) {
+        EXPECT_EQ(names.at(i), "Chord");
+        EXPECT_EQ(names.at(i + 1), "Note");
+        EXPECT_EQ(names.at(i + 2), "pitch");
+        EXPECT_EQ(names.at(i + 3), "Rest");
+    }
+
+    //! CHECK The same tokens as from the whole data
+    buf.seek(0);
+    XmlStreamReader xml2(&buf);
+    EXPECT_EQ(readTrace(xml2), readDomTrace(data));
+}
+
+TEST_F(Global_Ser_XmlStreamReaderTests, Tokenize_Small_Chunks)
+{
+    //! GIVEN Some document with every kind of node
+    std::string data
+        = "\xEF\xBB\xBF<?xml version=\"1.0\"?>\r\n<!DOCTYPE museScore>\n"
+          "<museScore version=\"4.00\">\n"
+          "  <metaTag name=\"composer\">J. &amp; S.\r\nBach</metaTag>\n"
+          "  <!-- comment --><Text><![CDATA[<i>]]>&#x263A;</Text>\n"
+          "  <Staff id = '1' type=\"stdNormal\"  /><Empty></Empty>\n"
+          "</museScore>\n";
+
+    XmlStreamReader ref(toByteArray(data));
+    std::string refTrace = readTrace(ref);
+    ASSERT_FALSE(ref.isError());
+    ASSERT_EQ(refTrace, readDomTrace(data));
+
+    for (size_t chunkSize = 1; chunkSize < 32; ++chunkSize) {
+        ByteArray ba = toByteArray(data);
+        Buffer buf(&ba);
+        buf.open(IODevice::ReadOnly);
+
+        //! DO Tokenize the document in small chunks
+        XmlPullTokenizer tokenizer;
+        tokenizer.setDevice(&buf, chunkSize);
+
+        std::string trace;
+        XmlPullTokenizer::TokenType type = XmlPullTokenizer::NoToken;
+        while ((type = tokenizer.next()) != XmlPullTokenizer::EndDocument && type != XmlPullTokenizer::Error) {
+            switch (type) {
+            case XmlPullTokenizer::Declaration: trace += "<?>";
+                break;
+            case XmlPullTokenizer::Unknown: trace += "<!>";
+                break;
+            case XmlPullTokenizer::StartElement:
+                trace += "<" + toStdString(tokenizer.name());
+                for (const XmlPullTokenizer::Attribute& a : tokenizer.attributes()) {
+                    trace += " " + toStdString(a.name) + "=" + toStdString(a.value);
+                }
+                trace += ">";
+                break;
+            case XmlPullTokenizer::EndElement: trace += "</" + toStdString(tokenizer.name()) + ">";
+                break;
+            case XmlPullTokenizer::Text: trace += "[" + toStdString(tokenizer.value()) + "]";
+                break;
+            case XmlPullTokenizer::Comment: trace += "{" + toStdString(tokenizer.value()) + "}";
+                break;
+            default:
+                break;
+            }
+        }
+
+        //! CHECK The same tokens as from the whole data
+        EXPECT_EQ(type, XmlPullTokenizer::EndDocument) << tokenizer.errorString();
+        EXPECT_EQ(trace + "$", refTrace) << "chunk size: " << chunkSize;
+    }
+}
+
+TEST_F(Global_Ser_XmlStreamReaderTests, Tokenize_Releases_Blocks)
+{
+    //! GIVEN Some long document, with a text followed by many comments
+    std::string data = "<museScore><Score><Staff>\n";
+    for (int i = 0; i < 1000; ++i) {
+        data += "  <Chord><pitch>" + std::to_string(i) + "</pitch></Chord>\n";
+    }
+    data += "  <text>last text<!-- " + std::string(1000, 'c') + " --><!-- comment --></text>\n";
+    data += "</Staff></Score></museScore>\n";
+
+    ByteArray ba = toByteArray(data);
+    Buffer buf(&ba);
+    buf.open(IODevice::ReadOnly);
+
+    //! DO Tokenize the document in small chunks
+    XmlPullTokenizer tokenizer;
+    tokenizer.setDevice(&buf, 64);
+
+    size_t maxBlockCount = 0;
+    int pitch = 0;
+    AsciiStringView text;
+    std::vector<std::string> endNames;
+    XmlPullTokenizer::TokenType type = XmlPullTokenizer::NoToken;
+    while ((type = tokenizer.next()) != XmlPullTokenizer::EndDocument && type != XmlPullTokenizer::Error) {
+        maxBlockCount = std::max(maxBlockCount, tokenizer.blockCount());
+
+        if (type == XmlPullTokenizer::Text) {
+            text = tokenizer.value();
+        } else if (type == XmlPullTokenizer::EndElement) {
+            std::string name = toStdString(tokenizer.name());
+            if (name == "pitch") {
+                //! CHECK The text of the element is valid on its end
+                EXPECT_EQ(toStdString(text), std::to_string(pitch++));
+            } else if (name == "text") {
+                EXPECT_EQ(toStdString(text), "last text");
+            } else if (name != "Chord") {
+                endNames.push_back(name);
+            }
+        }
+    }
+
+    //! CHECK The names of the elements open from the first block are valid on their end
+    EXPECT_EQ(type, XmlPullTokenizer::EndDocument) << tokenizer.errorString();
+    EXPECT_EQ(pitch, 1000);
+    EXPECT_EQ(endNames, std::vector<std::string>({ "Staff", "Score", "museScore" }));
+
+    //! CHECK Only a few blocks are held at once
+    EXPECT_LE(maxBlockCount, 8);
+}
+
+TEST_F(Global_Ser_XmlStreamReaderTests, Read_Scores_Same_As_Dom)
+{
+    //! GIVEN A few small scores
+    const std::filesystem::path root = std::filesystem::path(global_tests_DATA_ROOT) / "xmlstreamreader_data";
+
+    std::vector<std::filesystem::path> files;
+    for (const auto& entry : std::filesystem::directory_iterator(root)) {
+        if (entry.is_regular_file() && entry.path().extension() == ".mscx") {
+            files.push_back(entry.path());
+        }
+    }
+    ASSERT_FALSE(files.empty());
+
+    for (const std::filesystem::path& file : files) {
+        std::ifstream stream(file, std::ios::binary);
+        std::string data((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+
+        //! DO Read the score with the DOM and with the reader
+        std::string domTrace = readDomTrace(data);
+
+        XmlStreamReader xml(toByteArray(data));
+        std::string trace = readTrace(xml);
+
+        //! CHECK The same tokens
+        EXPECT_FALSE(domTrace.empty()) << file.string();
+        EXPECT_FALSE(xml.isError()) << file.string();
+        EXPECT_EQ(trace, domTrace) << file.string();
+    }
+}
@@ -0,0 +1,149 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "io/buffer.h"
+#include "serialization/zipreader.h"
+#include "serialization/zipwriter.h"
+
+using namespace mu;
+using namespace mu::io;
+
+class Global_Ser_ZipWriterTests : public ::testing::Test
+{
+public:
+};
+
+static ByteArray makeData(size_t size, uint32_t seed)
+{
+    //! NOTE Some text, that is neither too random nor too repetitive to compress
+    static const char* words[] = { "<Chord>", "<durationType>quarter</durationType>", "<Note>", "<pitch>", "</Note>", "</Chord>" };
+
+    std::string text;
+    uint32_t state = seed;
+    while (text.size() < size) {
+        state = state * 1664525 + 1013904223;
+        text += words[(state >> 16) % 6];
+        text += std::to_string((state >> 8) % 128);
+        text += '\n';
+    }
+    text.resize(size);
+
+    return ByteArray(text.c_str(), text.size());
+}
+
+TEST_F(Global_Ser_ZipWriterTests, ZipWriter_AddFiles)
+{
+    //! GIVEN Files of different sizes, from empty to several compression chunks
+    std::vector<std::pair<std::string, ByteArray> > files = {
+        { "empty.txt", ByteArray() },
+        { "small.txt", makeData(10, 1) },
+        { "medium.xml", makeData(100000, 2) },
+        { "Excerpts/large.xml", makeData(3000000, 3) },
+        { "Excerpts/large2.xml", makeData(1000000, 4) },
+    };
+
+    //! DO Add them to an archive
+    ByteArray zipData;
+    {
+        Buffer buf(&zipData);
+        ZipWriter writer(&buf);
+        for (const auto& file : files) {
+            writer.addFile(file.first, file.second);
+        }
+        writer.close();
+        EXPECT_FALSE(writer.hasError());
+    }
+
+    //! CHECK The archive contains the same files, in the same order
+    Buffer buf(&zipData);
+    ZipReader reader(&buf);
+    std::vector<ZipReader::FileInfo> infos = reader.fileInfoList();
+    ASSERT_EQ(infos.size(), files.size());
+    for (size_t i = 0; i < files.size(); ++i) {
+        EXPECT_EQ(infos.at(i).filePath, files.at(i).first);
+        EXPECT_EQ(reader.fileData(files.at(i).first), files.at(i).second);
+    }
+}
+
+TEST_F(Global_Ser_ZipWriterTests, ZipWriter_WriteFile_ByStream)
+{
+    //! GIVEN A file, written in small pieces, like XmlWriter does
+    ByteArray origin = makeData(2000000, 5);
+
+    ByteArray zipData;
+    {
+        Buffer buf(&zipData);
+        ZipWriter writer(&buf);
+        writer.addFile("style.mss", makeData(1000, 6));
+
+        //! DO Write it by stream, in between of other files
+        IODevice* device = writer.beginFile("score.mscx");
+        ASSERT_TRUE(device);
+        for (size_t pos = 0; pos < origin.size(); pos += 100) {
+            device->write(origin.constData() + pos, std::min<size_t>(100, origin.size() - pos));
+        }
+        writer.endFile();
+
+        writer.addFile("thumbnail.png", makeData(1000, 7));
+        writer.close();
+        EXPECT_FALSE(writer.hasError());
+    }
+
+    //! CHECK The file is read back as it was written
+    Buffer buf(&zipData);
+    ZipReader reader(&buf);
+    std::vector<ZipReader::FileInfo> infos = reader.fileInfoList();
+    ASSERT_EQ(infos.size(), 3);
+    EXPECT_EQ(infos.at(1).filePath, "score.mscx");
+    EXPECT_EQ(reader.fileData("score.mscx"), origin);
+}
+
+TEST_F(Global_Ser_ZipWriterTests, ZipWriter_CompressionLevel)
+{
+    ByteArray origin = makeData(1000000, 8);
+
+    auto zip = [&origin](int level) {
+        ByteArray zipData;
+        Buffer buf(&zipData);
+        ZipWriter writer(&buf);
+        writer.setCompressionLevel(level);
+        writer.addFile("score.mscx", origin);
+        writer.close();
+        return zipData;
+    };
+
+    //! DO Compress with the fastest and the smallest level
+    ByteArray fastest = zip(1);
+    ByteArray smallest = zip(9);
+
+    //! CHECK Both can be read, the smallest level gives a smaller archive
+    EXPECT_LT(smallest.size(), fastest.size());
+
+    for (const ByteArray& zipData : { fastest, smallest }) {
+        Buffer buf(zipData.constData(), zipData.size());
+        ZipReader reader(&buf);
+        EXPECT_EQ(reader.fileData("score.mscx"), origin);
+    }
+}
@@ -40,6 +40,8 @@ using PlaybackEvent = std::variant<NoteEvent, RestEvent>;
 using PlaybackEventList = std::vector<PlaybackEvent>;
 using PlaybackEventsMap = std::map<msecs_t, PlaybackEventList>;
 using PlaybackEventsChanges = async::Channel<PlaybackEventsMap>;
+struct PlaybackEventsDelta;
+using PlaybackEventsDeltaChanges = async::Channel<PlaybackEventsDelta>;
 using DynamicLevelChanges = async::Channel<DynamicLevelMap>;
 
 struct ArrangementContext
@@ -298,10 +300,39 @@ struct PlaybackSetupData
     }
 };
 
+//! NOTE A compact update of the main stream, which carries only the timestamps whose events have actually changed.
+//!      The lists of changedEvents replace the lists at the same timestamps, removedTimestamps don't have any events anymore
+struct PlaybackEventsDelta {
+    PlaybackEventsMap changedEvents;
+    std::vector<timestamp_t> removedTimestamps;
+
+    bool empty() const
+    {
+        return changedEvents.empty() && removedTimestamps.empty();
+    }
+
+    void applyTo(PlaybackEventsMap& events) const
+    {
+        for (const timestamp_t timestamp : removedTimestamps) {
+            events.erase(timestamp);
+        }
+
+        for (const auto& pair : changedEvents) {
+            events.insert_or_assign(pair.first, pair.second);
+        }
+    }
+
+    bool operator==(const PlaybackEventsDelta& other) const
+    {
+        return changedEvents == other.changedEvents
+               && removedTimestamps == other.removedTimestamps;
+    }
+};
+
 struct PlaybackData {
     PlaybackEventsMap originEvents;
     PlaybackSetupData setupData;
-    PlaybackEventsChanges mainStream;
+    PlaybackEventsDeltaChanges mainStream;
     PlaybackEventsChanges offStream;
     DynamicLevelMap dynamicLevelMap;
     DynamicLevelChanges dynamicLevelChanges;
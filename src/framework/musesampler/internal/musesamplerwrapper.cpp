@@ -141,8 +141,7 @@ samples_t MuseSamplerWrapper::process(float* buffer, audio::samples_t samplesPer
 
     extractOutputSamples(samplesPerChannel, buffer);
 
-    audio::msecs_t newPlaybackPosition = m_playbackPosition + samplesToMsecs(samplesPerChannel, m_sampleRate);
-    setPlaybackPosition(newPlaybackPosition);
+    forwardPlaybackPosition(samplesPerChannel);
 
     return samplesPerChannel;
 }
@@ -34,31 +34,29 @@ void VstSequencer::init(ParamsMapping&& mapping)
 
 void VstSequencer::updateOffStreamEvents(const mpe::PlaybackEventsMap& changes)
 {
-    m_offStreamEvents.clear();
-    updatePlaybackEvents(m_offStreamEvents, changes);
-    updateOffSequenceIterator();
+    updatePlaybackEvents(beginUpdate(m_offStream), changes);
+    commitUpdate(m_offStream);
 }
 
 void VstSequencer::updateMainStreamEvents(const mpe::PlaybackEventsMap& changes)
 {
-    m_mainStreamEvents.clear();
-    updatePlaybackEvents(m_mainStreamEvents, changes);
-    updateMainSequenceIterator();
+    updatePlaybackEvents(beginUpdate(m_mainStream), changes);
+    commitUpdate(m_mainStream);
 }
 
 void VstSequencer::updateDynamicChanges(const mpe::DynamicLevelMap& changes)
 {
-    m_dynamicEvents.clear();
+    EventTimeline& timeline = beginUpdate(m_dynamicStream);
     m_dynamicLevels = changes;
 
     for (const auto& pair : changes) {
-        m_dynamicEvents[pair.first].emplace(expressionLevel(pair.second));
+        timeline.add(pair.first, expressionLevel(pair.second));
     }
 
-    updateDynamicChangesIterator();
+    commitUpdate(m_dynamicStream);
 }
 
-void VstSequencer::updatePlaybackEvents(EventSequenceMap& destination, const mpe::PlaybackEventsMap& changes)
+void VstSequencer::updatePlaybackEvents(EventTimeline& destination, const mpe::PlaybackEventsMap& changes)
 {
     for (const auto& pair : changes) {
         for (const mpe::PlaybackEvent& event : pair.second) {
@@ -74,8 +72,8 @@ void VstSequencer::updatePlaybackEvents(EventSequenceMap& destination, const mpe
             int32_t noteId = noteIndex(noteEvent.pitchCtx().nominalPitchLevel);
             float velocityFraction = noteVelocityFraction(noteEvent);
 
-            destination[timestampFrom].emplace(buildEvent(VstEvent::kNoteOnEvent, noteId, velocityFraction));
-            destination[timestampTo].emplace(buildEvent(VstEvent::kNoteOffEvent, noteId, velocityFraction));
+            destination.add(timestampFrom, buildEvent(VstEvent::kNoteOnEvent, noteId, velocityFraction));
+            destination.add(timestampTo, buildEvent(VstEvent::kNoteOffEvent, noteId, velocityFraction));
         }
     }
 }
@@ -64,7 +64,7 @@ public:
     void updateDynamicChanges(const mpe::DynamicLevelMap& changes) override;
 
 private:
-    void updatePlaybackEvents(EventSequenceMap& destination, const mpe::PlaybackEventsMap& changes);
+    void updatePlaybackEvents(EventTimeline& destination, const mpe::PlaybackEventsMap& changes);
 
     VstEvent buildEvent(const Steinberg::Vst::Event::EventTypes type, const int32_t noteIdx, const float velocityFraction);
 
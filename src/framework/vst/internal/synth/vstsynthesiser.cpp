@@ -152,6 +152,7 @@ void VstSynthesiser::setPlaybackPosition(const audio::msecs_t newPosition)
 void VstSynthesiser::setSampleRate(unsigned int sampleRate)
 {
     m_sampleRate = sampleRate;
+    m_sequencer.setSampleRate(sampleRate);
     m_vstAudioClient->setSampleRate(sampleRate);
 }
 
@@ -171,13 +172,16 @@ audio::samples_t VstSynthesiser::process(float* buffer, audio::samples_t samples
         return 0;
     }
 
-    audio::msecs_t nextMsecs = samplesToMsecs(samplesPerChannel, m_sampleRate);
+    const VstSequencer::EventSequence& sequence = m_sequencer.eventsToBePlayed(samplesPerChannel);
 
-    const VstSequencer::EventSequence& sequence = m_sequencer.eventsToBePlayed(nextMsecs);
+    for (const VstSequencer::BlockEvent& blockEvent : sequence) {
+        const VstSequencer::EventType& event = blockEvent.event;
 
-    for (const VstSequencer::EventType& event : sequence) {
         if (std::holds_alternative<VstEvent>(event)) {
-            m_vstAudioClient->handleEvent(std::get<VstEvent>(event));
+            //! NOTE The plugin places the event at the exact frame of the block itself
+            VstEvent vstEvent = std::get<VstEvent>(event);
+            vstEvent.sampleOffset = static_cast<int32_t>(blockEvent.frameOffset);
+            m_vstAudioClient->handleEvent(vstEvent);
         } else if (std::holds_alternative<PluginParamInfo>(event)) {
             m_vstAudioClient->handleParamChange(std::get<PluginParamInfo>(event));
         } else {
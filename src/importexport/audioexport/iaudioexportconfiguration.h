@@ -41,6 +41,10 @@ public:
     virtual int exportSampleRate() const = 0;
     virtual void setExportSampleRate(int rate) = 0;
     virtual const std::vector<int>& availableSampleRates() const = 0;
+
+    //! NOTE Also write each track of the score into its own file next to the mix
+    virtual bool exportStems() const = 0;
+    virtual void setExportStems(bool exportStems) = 0;
 };
 }
 
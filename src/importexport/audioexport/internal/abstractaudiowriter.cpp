@@ -73,7 +73,7 @@ mu::Ret AbstractAudioWriter::writeList(const INotationPtrList&, QIODevice&, cons
 
 void AbstractAudioWriter::abort()
 {
-    NOT_IMPLEMENTED;
+    playback()->audioOutput()->abortSavingAllSoundTracks();
 }
 
 bool AbstractAudioWriter::supportsProgressNotifications() const
@@ -98,13 +98,27 @@ void AbstractAudioWriter::doWriteAndWait(QIODevice& destinationDevice, const aud
 
     m_isCompleted = false;
 
+    bool withStems = configuration()->exportStems();
+
+    std::vector<framework::Progress> soundTracksProgress;
+
     playback()->sequenceIdList()
-    .onResolve(this, [this, path, &format](const audio::TrackSequenceIdList& sequenceIdList) {
+    .onResolve(this, [this, path, withStems, &format, &soundTracksProgress](const audio::TrackSequenceIdList& sequenceIdList) {
         m_progress.started.notify();
 
         for (const audio::TrackSequenceId sequenceId : sequenceIdList) {
-            playback()->audioOutput()->saveSoundTrack(sequenceId, io::path_t(path), std::move(format))
-            .onResolve(this, [this, path](const bool /*result*/) {
+            framework::Progress soundTrackProgress = playback()->audioOutput()->saveSoundTrackProgress(sequenceId);
+            soundTrackProgress.progressChanged.onReceive(this, [this](int64_t current, int64_t total, std::string title) {
+                m_progress.progressChanged.send(current, total, title);
+            });
+            soundTracksProgress.push_back(soundTrackProgress);
+
+            audio::IAudioOutputPtr output = playback()->audioOutput();
+            async::Promise<bool> saved = withStems
+                                         ? output->saveSoundTrackStems(sequenceId, io::path_t(path), format)
+                                         : output->saveSoundTrack(sequenceId, io::path_t(path), format);
+
+            saved.onResolve(this, [this, path](const bool /*result*/) {
                 LOGD() << "Successfully saved sound track by path: " << path;
                 m_isCompleted = true;
                 m_progress.finished.send(make_ok());
@@ -123,6 +137,11 @@ void AbstractAudioWriter::doWriteAndWait(QIODevice& destinationDevice, const aud
         QApplication::instance()->processEvents();
         QThread::yieldCurrentThread();
     }
+
+    //! NOTE Every export gets a new progress of the sound track, the subscriptions to this one are no longer needed
+    for (framework::Progress& soundTrackProgress : soundTracksProgress) {
+        soundTrackProgress.progressChanged.resetOnReceive(this);
+    }
 }
 
 INotationWriter::UnitType AbstractAudioWriter::unitTypeFromOptions(const Options& options) const
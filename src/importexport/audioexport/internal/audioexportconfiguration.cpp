@@ -28,12 +28,14 @@ using namespace mu::iex::audioexport;
 using namespace mu::framework;
 
 static const Settings::Key EXPORT_SAMPLE_RATE_KEY("iex_audioexport", "export/audio/sampleRate");
+static const Settings::Key EXPORT_STEMS_KEY("iex_audioexport", "export/audio/stems");
 
 static constexpr int DEFAULT_BITRATE = 128;
 
 void AudioExportConfiguration::init()
 {
     settings()->setDefaultValue(EXPORT_SAMPLE_RATE_KEY, Val(44100));
+    settings()->setDefaultValue(EXPORT_STEMS_KEY, Val(false));
 }
 
 int AudioExportConfiguration::exportMp3Bitrate() const
@@ -67,3 +69,13 @@ const std::vector<int>& AudioExportConfiguration::availableSampleRates() const
     static const std::vector<int> rates { 32000, 44100, 48000 };
     return rates;
 }
+
+bool AudioExportConfiguration::exportStems() const
+{
+    return settings()->value(EXPORT_STEMS_KEY).toBool();
+}
+
+void AudioExportConfiguration::setExportStems(bool exportStems)
+{
+    settings()->setSharedValue(EXPORT_STEMS_KEY, Val(exportStems));
+}
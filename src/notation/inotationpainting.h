@@ -39,6 +39,7 @@ public:
         bool isPrinting = false;
         bool isMultiPage = false;
         bool printPageBackground = true;
+        bool isPaintInteraction = true; // selection, drag, edit overlays, only when not printing
         RectF frameRect;
         int fromPage = -1; // 0 is first
         int toPage = -1;
@@ -56,6 +57,8 @@ public:
     virtual SizeF pageSizeInch() const = 0;
 
     virtual void paintView(draw::Painter* painter, const RectF& frameRect, bool isPrinting) = 0;
+    virtual void paintViewContent(draw::Painter* painter, const RectF& frameRect, bool isPrinting) = 0; // without interaction overlays
+    virtual void paintViewInteraction(draw::Painter* painter) = 0;
     virtual void paintPdf(draw::Painter* painter, const Options& opt) = 0;
     virtual void paintPrint(draw::Painter* painter, const Options& opt) = 0;
     virtual void paintPng(draw::Painter* painter, const Options& opt) = 0;
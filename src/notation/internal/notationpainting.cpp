@@ -225,8 +225,8 @@ void NotationPainting::doPaint(draw::Painter* painter, const Options& opt)
             }
         }
 
-        if (!opt.isPrinting) {
-            static_cast<NotationInteraction*>(m_notation->interaction().get())->paint(painter);
+        if (!opt.isPrinting && opt.isPaintInteraction) {
+            paintViewInteraction(painter);
         }
     }
 }
@@ -289,6 +289,27 @@ void NotationPainting::paintView(Painter* painter, const RectF& frameRect, bool
     doPaint(painter, opt);
 }
 
+void NotationPainting::paintViewContent(Painter* painter, const RectF& frameRect, bool isPrinting)
+{
+    Options opt;
+    opt.isSetViewport = false;
+    opt.isMultiPage = true;
+    opt.isPaintInteraction = false;
+    opt.frameRect = frameRect;
+    opt.deviceDpi = uiConfiguration()->logicalDpi();
+    opt.isPrinting = isPrinting;
+    doPaint(painter, opt);
+}
+
+void NotationPainting::paintViewInteraction(Painter* painter)
+{
+    if (!score()) {
+        return;
+    }
+
+    static_cast<NotationInteraction*>(m_notation->interaction().get())->paint(painter);
+}
+
 void NotationPainting::paintPdf(draw::Painter* painter, const Options& opt)
 {
     Q_ASSERT(opt.deviceDpi > 0);
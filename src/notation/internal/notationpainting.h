@@ -53,6 +53,8 @@ public:
     SizeF pageSizeInch() const override;
 
     void paintView(draw::Painter* painter, const RectF& frameRect, bool isPrinting) override;
+    void paintViewContent(draw::Painter* painter, const RectF& frameRect, bool isPrinting) override;
+    void paintViewInteraction(draw::Painter* painter) override;
     void paintPdf(draw::Painter* painter, const Options& opt) override;
     void paintPrint(draw::Painter* painter, const Options& opt) override;
     void paintPng(draw::Painter* painter, const Options& opt) override;
@@ -0,0 +1,164 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <QImage>
+#include <QPainter>
+
+#include "notation/view/notationtilecache.h"
+
+using namespace mu;
+using namespace mu::draw;
+using namespace mu::notation;
+
+class Notation_NotationTileCacheTests : public ::testing::Test
+{
+public:
+    void SetUp() override
+    {
+        m_target = QImage(VIEW_WIDTH, VIEW_HEIGHT, QImage::Format_ARGB32_Premultiplied);
+        m_paintContent = [this](Painter*, const RectF&) {
+            ++m_renderedTiles;
+        };
+    }
+
+    //! Paints the view scrolled by dx, dy and returns the count of rendered tiles
+    int paint(qreal dx = 0.0, qreal dy = 0.0, qreal scale = 1.0, qreal devicePixelRatio = 1.0)
+    {
+        Transform transform;
+        transform.translate(dx, dy);
+        transform.scale(scale, scale);
+
+        m_renderedTiles = 0;
+
+        QPainter painter(&m_target);
+        m_cache.paint(&painter, RectF(0.0, 0.0, VIEW_WIDTH, VIEW_HEIGHT), transform, devicePixelRatio, m_paintContent);
+
+        return m_renderedTiles;
+    }
+
+    //! NOTE 4 x 3 tiles
+    static constexpr int VIEW_WIDTH = 4 * NotationTileCache::TILE_SIZE;
+    static constexpr int VIEW_HEIGHT = 3 * NotationTileCache::TILE_SIZE;
+    static constexpr size_t TILE_BYTES = NotationTileCache::TILE_SIZE * NotationTileCache::TILE_SIZE * 4;
+
+    NotationTileCache m_cache;
+    QImage m_target;
+    NotationTileCache::PaintFunc m_paintContent;
+    int m_renderedTiles = 0;
+};
+
+TEST_F(Notation_NotationTileCacheTests, Paint_ReusesTiles)
+{
+    //! DO Paint the view
+    EXPECT_EQ(paint(), 12);
+
+    //! CHECK Painting again renders nothing
+    EXPECT_EQ(paint(), 0);
+    EXPECT_EQ(m_cache.tileCount(), 12);
+    EXPECT_EQ(m_cache.cacheSize(), 12 * TILE_BYTES);
+
+    //! CHECK Scrolling by one column renders only the new column
+    EXPECT_EQ(paint(-NotationTileCache::TILE_SIZE), 3);
+    EXPECT_EQ(m_cache.tileCount(), 15);
+}
+
+TEST_F(Notation_NotationTileCacheTests, Invalidate_DropsAllTiles)
+{
+    //! GIVEN Painted view
+    paint();
+
+    //! DO Invalidate
+    m_cache.invalidate();
+
+    //! CHECK All tiles are rendered again
+    EXPECT_EQ(m_cache.tileCount(), 0);
+    EXPECT_EQ(m_cache.cacheSize(), 0);
+    EXPECT_EQ(paint(), 12);
+}
+
+TEST_F(Notation_NotationTileCacheTests, InvalidateRect_DropsOnlyTouchedTiles)
+{
+    //! GIVEN View painted at zoom 2
+    paint(0.0, 0.0, 2.0);
+
+    //! DO Invalidate a logical rect, which is in the second column of the first row at this zoom
+    m_cache.invalidate(RectF(140.0, 10.0, 10.0, 10.0));
+
+    //! CHECK Only that tile is rendered again
+    EXPECT_EQ(m_cache.tileCount(), 11);
+    EXPECT_EQ(m_cache.cacheSize(), 11 * TILE_BYTES);
+    EXPECT_EQ(paint(0.0, 0.0, 2.0), 1);
+
+    //! DO Invalidate a logical rect crossing the tile borders
+    m_cache.invalidate(RectF(120.0, 120.0, 20.0, 20.0));
+
+    //! CHECK The four tiles around the crossing are rendered again
+    EXPECT_EQ(paint(0.0, 0.0, 2.0), 4);
+}
+
+TEST_F(Notation_NotationTileCacheTests, ZoomOrDevicePixelRatioChange_DropsAllTiles)
+{
+    //! GIVEN Painted view
+    paint();
+
+    //! CHECK All tiles are rendered again when the zoom changes
+    EXPECT_EQ(paint(0.0, 0.0, 1.5), 12);
+    EXPECT_EQ(m_cache.tileCount(), 12);
+
+    //! CHECK And when the device pixel ratio changes
+    EXPECT_EQ(paint(0.0, 0.0, 1.5, 2.0), 12);
+    EXPECT_EQ(m_cache.tileCount(), 12);
+    EXPECT_EQ(m_cache.cacheSize(), 12 * 4 * TILE_BYTES);
+}
+
+TEST_F(Notation_NotationTileCacheTests, MaxCacheSize_DropsLeastRecentlyUsedTiles)
+{
+    //! GIVEN Cache for 4 rows of tiles
+    m_cache.setMaxCacheSize(16 * TILE_BYTES);
+
+    //! DO Paint the rows 0-2, then scroll down to the rows 1-3 and 2-4
+    const qreal row = -NotationTileCache::TILE_SIZE;
+    EXPECT_EQ(paint(), 12);
+    EXPECT_EQ(paint(0.0, row), 4);
+    EXPECT_EQ(paint(0.0, 2 * row), 4);
+
+    //! CHECK Only the row 0, which was painted least recently, was dropped
+    EXPECT_EQ(m_cache.tileCount(), 16);
+    EXPECT_EQ(m_cache.cacheSize(), 16 * TILE_BYTES);
+    EXPECT_EQ(paint(0.0, row), 0);
+    EXPECT_EQ(paint(), 4);
+}
+
+TEST_F(Notation_NotationTileCacheTests, MaxCacheSize_KeepsVisibleTiles)
+{
+    //! GIVEN Cache smaller than one tile
+    m_cache.setMaxCacheSize(TILE_BYTES / 2);
+
+    //! DO Paint the view
+    paint();
+
+    //! CHECK The visible tiles are kept
+    EXPECT_EQ(m_cache.tileCount(), 12);
+    EXPECT_EQ(paint(), 0);
+}
@@ -22,6 +22,7 @@
 #include "abstractnotationpaintview.h"
 
 #include <QPainter>
+#include <QQuickWindow>
 
 #include "actions/actiontypes.h"
 #include "stringutils.h"
@@ -67,6 +68,7 @@ AbstractNotationPaintView::AbstractNotationPaintView(QQuickItem* parent)
 
     //! NOTE For diagnostic tools
     dispatcher()->reg(this, "diagnostic-notationview-redraw", [this]() {
+        m_tileCache.invalidate();
         update();
     });
 
@@ -230,6 +232,7 @@ void AbstractNotationPaintView::onLoadNotation(INotationPtr)
 
     m_notation->notationChanged().onNotify(this, [this, interaction]() {
         interaction->hideShadowNote();
+        m_tileCache.invalidate();
         update();
     });
 
@@ -239,6 +242,7 @@ void AbstractNotationPaintView::onLoadNotation(INotationPtr)
     });
 
     interaction->selectionChanged().onNotify(this, [this]() {
+        m_tileCache.invalidate();
         update();
     });
 
@@ -253,6 +257,10 @@ void AbstractNotationPaintView::onLoadNotation(INotationPtr)
     });
 
     interaction->dropChanged().onNotify(this, [this]() {
+        //! NOTE The drop target is highlighted
+        m_tileCache.invalidate();
+        update();
+
         if (!hasActiveFocus()) {
             forceFocusIn(); // grab keyboard focus after element added from palette
         }
@@ -296,6 +304,9 @@ void AbstractNotationPaintView::onUnloadNotation(INotationPtr)
     INotationInteractionPtr interaction = m_notation->interaction();
     interaction->noteInput()->stateChanged().resetOnNotify(this);
     interaction->selectionChanged().resetOnNotify(this);
+    interaction->dropChanged().resetOnNotify(this);
+
+    m_tileCache.invalidate();
 
     if (accessibilityEnabled()) {
         m_notation->accessibility()->setMapToScreenFunc(nullptr);
@@ -488,10 +499,25 @@ void AbstractNotationPaintView::paint(QPainter* qp)
     Transform guiScalingCompensation;
     guiScalingCompensation.scale(guiScaling, guiScaling);
 
-    painter->setWorldTransform(m_matrix * guiScalingCompensation);
+    Transform viewTransform = m_matrix * guiScalingCompensation;
 
     bool isPrinting = publishMode() || m_inputController->readonly();
-    notation()->painting()->paintView(painter, toLogical(rect), isPrinting);
+    if (isTileCacheUsable(isPrinting)) {
+        //! NOTE The tiles are drawn in view coordinates, the cursors and overlays on top of them
+        m_tileCache.paint(qp, rect, viewTransform, window() ? window()->effectiveDevicePixelRatio() : 1.0,
+                          [this, isPrinting](Painter* tilePainter, const RectF& logicalRect) {
+            notation()->painting()->paintViewContent(tilePainter, logicalRect, isPrinting);
+        });
+
+        painter->setWorldTransform(viewTransform);
+        if (!isPrinting) {
+            notation()->painting()->paintViewInteraction(painter);
+        }
+    } else {
+        m_tileCache.invalidate();
+        painter->setWorldTransform(viewTransform);
+        notation()->painting()->paintView(painter, toLogical(rect), isPrinting);
+    }
 
     m_playbackCursor->paint(painter);
     m_noteInputCursor->paint(painter);
@@ -508,6 +534,25 @@ void AbstractNotationPaintView::paint(QPainter* qp)
     }
 }
 
+bool AbstractNotationPaintView::isTileCacheUsable(bool isPrinting)
+{
+    if (isPrinting != m_tileCacheIsPrinting) {
+        m_tileCache.invalidate();
+        m_tileCacheIsPrinting = isPrinting;
+    }
+
+    //! NOTE While editing, items can change without notifying about it, so paint them directly
+    INotationInteractionPtr interaction = notationInteraction();
+    if (!interaction) {
+        return false;
+    }
+
+    return !interaction->isDragStarted()
+           && !interaction->isTextEditingStarted()
+           && !interaction->isElementEditStarted()
+           && !interaction->isGripEditStarted();
+}
+
 void AbstractNotationPaintView::onNotationSetup()
 {
     TRACEFUNC;
@@ -527,14 +572,17 @@ void AbstractNotationPaintView::onNotationSetup()
     });
 
     configuration()->foregroundChanged().onNotify(this, [this]() {
+        m_tileCache.invalidate();
         update();
     });
 
     uiConfiguration()->currentThemeChanged().onNotify(this, [this]() {
+        m_tileCache.invalidate();
         update();
     });
 
     engravingConfiguration()->debuggingOptionsChanged().onNotify(this, [this]() {
+        m_tileCache.invalidate();
         update();
     });
 }
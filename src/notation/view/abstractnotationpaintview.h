@@ -45,6 +45,7 @@
 #include "playbackcursor.h"
 #include "loopmarker.h"
 #include "continuouspanel.h"
+#include "notationtilecache.h"
 
 namespace mu::notation {
 class AbstractNotationPaintView : public QQuickPaintedItem, public IControlledView, public async::Asyncable, public actions::Actionable
@@ -227,6 +228,7 @@ private:
     PointF alignToCurrentPageBorder(const RectF& showRect, const PointF& pos) const;
 
     void paintBackground(const RectF& rect, draw::Painter* painter);
+    bool isTileCacheUsable(bool isPrinting);
 
     PointF canvasCenter() const;
     std::pair<qreal, qreal> constraintCanvas(qreal dx, qreal dy) const;
@@ -241,6 +243,9 @@ private:
     std::unique_ptr<LoopMarker> m_loopOutMarker;
     std::unique_ptr<ContinuousPanel> m_continuousPanel;
 
+    NotationTileCache m_tileCache;
+    bool m_tileCacheIsPrinting = false;
+
     qreal m_previousVerticalScrollPosition = 0;
     qreal m_previousHorizontalScrollPosition = 0;
 
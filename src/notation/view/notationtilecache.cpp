@@ -0,0 +1,204 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "notationtilecache.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <QPainter>
+
+#include "log.h"
+
+using namespace mu;
+using namespace mu::draw;
+using namespace mu::notation;
+
+//! NOTE 64 tiles at the device pixel ratio 2, 256 tiles at 1
+static constexpr size_t DEFAULT_MAX_CACHE_SIZE = 64 * 1024 * 1024;
+
+NotationTileCache::NotationTileCache()
+    : m_maxCacheSize(DEFAULT_MAX_CACHE_SIZE)
+{
+}
+
+void NotationTileCache::paint(QPainter* painter, const RectF& viewRect, const Transform& transform, qreal devicePixelRatio,
+                              const PaintFunc& paintContent)
+{
+    TRACEFUNC;
+
+    IF_ASSERT_FAILED(painter && paintContent) {
+        return;
+    }
+
+    qreal scale = transform.m11();
+    if (scale <= 0.0 || devicePixelRatio <= 0.0) {
+        return;
+    }
+
+    if (scale != m_scale || devicePixelRatio != m_devicePixelRatio) {
+        invalidate();
+        m_scale = scale;
+        m_devicePixelRatio = devicePixelRatio;
+    }
+
+    //! NOTE The tiles are aligned to the logical origin, so they stay valid when scrolling
+    PointF offset(transform.dx(), transform.dy());
+    RectF canvasRect = viewRect.translated(-offset);
+
+    int firstCol = static_cast<int>(std::floor(canvasRect.left() / TILE_SIZE));
+    int lastCol = static_cast<int>(std::ceil(canvasRect.right() / TILE_SIZE)) - 1;
+    int firstRow = static_cast<int>(std::floor(canvasRect.top() / TILE_SIZE));
+    int lastRow = static_cast<int>(std::ceil(canvasRect.bottom() / TILE_SIZE)) - 1;
+
+    //! NOTE The tiles are drawn at whole device pixels, otherwise they are resampled and look blurry
+    auto snapToDevicePixel = [devicePixelRatio](qreal value) {
+        return std::round(value * devicePixelRatio) / devicePixelRatio;
+    };
+
+    ++m_paintCount;
+
+    for (int row = firstRow; row <= lastRow; ++row) {
+        for (int col = firstCol; col <= lastCol; ++col) {
+            TileIndex index { col, row };
+            auto it = m_tiles.find(index);
+            if (it == m_tiles.end()) {
+                Tile tile;
+                tile.image = renderTile(index, paintContent);
+                tile.size = static_cast<size_t>(tile.image.sizeInBytes());
+                m_cacheSize += tile.size;
+
+                it = m_tiles.emplace(index, std::move(tile)).first;
+            }
+
+            it->second.lastPaint = m_paintCount;
+
+            QPointF pos(snapToDevicePixel(col * TILE_SIZE + offset.x()), snapToDevicePixel(row * TILE_SIZE + offset.y()));
+            painter->drawImage(pos, it->second.image);
+        }
+    }
+
+    if (m_cacheSize > m_maxCacheSize) {
+        dropLeastRecentlyUsedTiles();
+    }
+}
+
+QImage NotationTileCache::renderTile(const TileIndex& index, const PaintFunc& paintContent) const
+{
+    TRACEFUNC;
+
+    int pixelSize = static_cast<int>(std::ceil(TILE_SIZE * m_devicePixelRatio));
+    QImage image(pixelSize, pixelSize, QImage::Format_ARGB32_Premultiplied);
+    image.setDevicePixelRatio(m_devicePixelRatio);
+    image.fill(Qt::transparent);
+
+    QPainter qp(&image);
+    Painter painter(&qp, "notationtile");
+
+    Transform transform;
+    transform.translate(-index.col * TILE_SIZE, -index.row * TILE_SIZE);
+    transform.scale(m_scale, m_scale);
+    painter.setWorldTransform(transform);
+
+    RectF logicalRect(index.col * TILE_SIZE / m_scale, index.row * TILE_SIZE / m_scale, TILE_SIZE / m_scale, TILE_SIZE / m_scale);
+    paintContent(&painter, logicalRect);
+
+    return image;
+}
+
+NotationTileCache::Tiles::iterator NotationTileCache::eraseTile(Tiles::iterator it)
+{
+    m_cacheSize -= it->second.size;
+    return m_tiles.erase(it);
+}
+
+void NotationTileCache::dropLeastRecentlyUsedTiles()
+{
+    //! NOTE The tiles of the last paint are visible, they are kept even above the maximum size
+    std::vector<Tiles::iterator> hiddenTiles;
+    for (auto it = m_tiles.begin(); it != m_tiles.end(); ++it) {
+        if (it->second.lastPaint != m_paintCount) {
+            hiddenTiles.push_back(it);
+        }
+    }
+
+    std::sort(hiddenTiles.begin(), hiddenTiles.end(), [](const Tiles::iterator& t1, const Tiles::iterator& t2) {
+        return t1->second.lastPaint < t2->second.lastPaint;
+    });
+
+    for (Tiles::iterator it : hiddenTiles) {
+        if (m_cacheSize <= m_maxCacheSize) {
+            break;
+        }
+
+        eraseTile(it);
+    }
+}
+
+void NotationTileCache::invalidate()
+{
+    m_tiles.clear();
+    m_cacheSize = 0;
+}
+
+void NotationTileCache::invalidate(const RectF& logicalRect)
+{
+    if (m_tiles.empty() || m_scale <= 0.0) {
+        return;
+    }
+
+    RectF canvasRect(logicalRect.left() * m_scale, logicalRect.top() * m_scale,
+                     logicalRect.width() * m_scale, logicalRect.height() * m_scale);
+
+    int firstCol = static_cast<int>(std::floor(canvasRect.left() / TILE_SIZE));
+    int lastCol = static_cast<int>(std::floor(canvasRect.right() / TILE_SIZE));
+    int firstRow = static_cast<int>(std::floor(canvasRect.top() / TILE_SIZE));
+    int lastRow = static_cast<int>(std::floor(canvasRect.bottom() / TILE_SIZE));
+
+    for (auto it = m_tiles.begin(); it != m_tiles.end();) {
+        const TileIndex& index = it->first;
+        if (index.col >= firstCol && index.col <= lastCol && index.row >= firstRow && index.row <= lastRow) {
+            it = eraseTile(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void NotationTileCache::setMaxCacheSize(size_t bytes)
+{
+    m_maxCacheSize = bytes;
+
+    if (m_cacheSize > m_maxCacheSize) {
+        dropLeastRecentlyUsedTiles();
+    }
+}
+
+size_t NotationTileCache::tileCount() const
+{
+    return m_tiles.size();
+}
+
+size_t NotationTileCache::cacheSize() const
+{
+    return m_cacheSize;
+}
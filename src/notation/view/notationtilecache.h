@@ -0,0 +1,98 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_NOTATION_NOTATIONTILECACHE_H
+#define MU_NOTATION_NOTATIONTILECACHE_H
+
+#include <cstdint>
+#include <functional>
+#include <map>
+
+#include <QImage>
+
+#include "draw/painter.h"
+#include "draw/types/geometry.h"
+#include "draw/types/transform.h"
+
+class QPainter;
+
+namespace mu::notation {
+//! NOTE Keeps the rendered notation in fixed size tiles, aligned to the canvas at the current zoom,
+//! so that scrolling and redraws caused only by cursors and overlays don't repaint the score.
+//! All tiles are dropped when the zoom or the device pixel ratio changes; the owner invalidates
+//! them when the layout, the selection or the appearance changes.
+//! Above the maximum cache size the least recently painted tiles are dropped, the visible ones are kept.
+class NotationTileCache
+{
+public:
+    using PaintFunc = std::function<void (draw::Painter* painter, const RectF& logicalRect)>;
+
+    //! NOTE Tile size in view units, the image itself is scaled by the device pixel ratio
+    static constexpr int TILE_SIZE = 256;
+
+    NotationTileCache();
+
+    //! viewRect - the area to paint in view coordinates
+    //! transform - maps logical coordinates to view coordinates, only scale and translation are supported
+    void paint(QPainter* painter, const RectF& viewRect, const draw::Transform& transform, qreal devicePixelRatio,
+               const PaintFunc& paintContent);
+
+    void invalidate();
+    void invalidate(const RectF& logicalRect);
+
+    void setMaxCacheSize(size_t bytes);
+
+    size_t tileCount() const;
+    size_t cacheSize() const;
+
+private:
+    struct TileIndex {
+        int col = 0;
+        int row = 0;
+
+        bool operator <(const TileIndex& other) const
+        {
+            return row < other.row || (row == other.row && col < other.col);
+        }
+    };
+
+    struct Tile {
+        QImage image;
+        size_t size = 0;
+        uint64_t lastPaint = 0;
+    };
+
+    using Tiles = std::map<TileIndex, Tile>;
+
+    QImage renderTile(const TileIndex& index, const PaintFunc& paintContent) const;
+    Tiles::iterator eraseTile(Tiles::iterator it);
+    void dropLeastRecentlyUsedTiles();
+
+    Tiles m_tiles;
+    size_t m_cacheSize = 0;
+    size_t m_maxCacheSize = 0;
+    uint64_t m_paintCount = 0;
+    qreal m_scale = 0.0;
+    qreal m_devicePixelRatio = 0.0;
+};
+}
+
+#endif // MU_NOTATION_NOTATIONTILECACHE_H
@@ -64,6 +64,9 @@ static const QString PLATFORM_TAG("platform");
 static const QString MOVEMENT_TITLE_TAG("movementTitle");
 static const QString MOVEMENT_NUMBER_TAG("movementNumber");
 
+//! NOTE Autosave runs often and its file is temporary, so it trades size for speed
+static constexpr int AUTOSAVE_COMPRESSION_LEVEL = 1;
+
 static bool isStandardTag(const QString& tag)
 {
     static const QSet<QString> standardTags {
@@ -411,7 +414,7 @@ mu::Ret NotationProject::save(const io::path_t& path, SaveMode saveMode)
 
         std::string suffix = io::suffix(savePath);
 
-        Ret ret = saveScore(savePath, suffix);
+        Ret ret = saveScore(savePath, suffix, saveMode);
         if (ret) {
             if (saveMode != SaveMode::SaveCopy) {
                 //! NOTE: order is important
@@ -435,7 +438,7 @@ mu::Ret NotationProject::save(const io::path_t& path, SaveMode saveMode)
             suffix = engraving::MSCX;
         }
 
-        return saveScore(path, suffix);
+        return saveScore(path, suffix, saveMode);
     }
 
     return make_ret(notation::Err::UnknownError);
@@ -466,7 +469,7 @@ mu::Ret NotationProject::writeToDevice(QIODevice* device)
     return ret;
 }
 
-mu::Ret NotationProject::saveScore(const io::path_t& path, const std::string& fileSuffix)
+mu::Ret NotationProject::saveScore(const io::path_t& path, const std::string& fileSuffix, SaveMode saveMode)
 {
     if (!isMuseScoreFile(fileSuffix) && !fileSuffix.empty()) {
         return exportProject(path, fileSuffix);
@@ -474,10 +477,10 @@ mu::Ret NotationProject::saveScore(const io::path_t& path, const std::string& fi
 
     MscIoMode ioMode = mscIoModeBySuffix(fileSuffix);
 
-    return doSave(path, true, ioMode);
+    return doSave(path, true, ioMode, saveMode);
 }
 
-mu::Ret NotationProject::doSave(const io::path_t& path, bool generateBackup, engraving::MscIoMode ioMode)
+mu::Ret NotationProject::doSave(const io::path_t& path, bool generateBackup, engraving::MscIoMode ioMode, SaveMode saveMode)
 {
     QString targetContainerPath = engraving::containerPath(path).toQString();
     io::path_t targetMainFilePath = engraving::mainFilePath(path);
@@ -507,6 +510,9 @@ mu::Ret NotationProject::doSave(const io::path_t& path, bool generateBackup, eng
         params.filePath = savePath;
         params.mainFileName = targetMainFileName.toQString();
         params.mode = ioMode;
+        if (saveMode == SaveMode::AutoSave) {
+            params.compressionLevel = AUTOSAVE_COMPRESSION_LEVEL;
+        }
         IF_ASSERT_FAILED(params.mode != MscIoMode::Unknown) {
             return make_ret(Ret::Code::InternalError);
         }
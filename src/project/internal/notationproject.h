@@ -94,10 +94,10 @@ private:
     Ret doLoad(engraving::MscReader& reader, const io::path_t& stylePath, bool forceMode);
     Ret doImport(const io::path_t& path, const io::path_t& stylePath, bool forceMode);
 
-    Ret saveScore(const io::path_t& path, const std::string& fileSuffix);
+    Ret saveScore(const io::path_t& path, const std::string& fileSuffix, SaveMode saveMode);
     Ret saveSelectionOnScore(const io::path_t& path = io::path_t());
     Ret exportProject(const io::path_t& path, const std::string& suffix);
-    Ret doSave(const io::path_t& path, bool generateBackup, engraving::MscIoMode ioMode);
+    Ret doSave(const io::path_t& path, bool generateBackup, engraving::MscIoMode ioMode, SaveMode saveMode);
     Ret makeCurrentFileAsBackup();
     Ret writeProject(engraving::MscWriter& msczWriter, bool onlySelection);
 
@@ -67,6 +67,7 @@ class ExportDialogModel : public QAbstractListModel
 
     Q_PROPERTY(int sampleRate READ sampleRate WRITE setSampleRate NOTIFY sampleRateChanged)
     Q_PROPERTY(int bitRate READ bitRate WRITE setBitRate NOTIFY bitRateChanged)
+    Q_PROPERTY(bool audioExportStems READ audioExportStems WRITE setAudioExportStems NOTIFY audioExportStemsChanged)
 
     Q_PROPERTY(bool midiExpandRepeats READ midiExpandRepeats WRITE setMidiExpandRepeats NOTIFY midiExpandRepeatsChanged)
     Q_PROPERTY(bool midiExportRpns READ midiExportRpns WRITE setMidiExportRpns NOTIFY midiExportRpnsChanged)
@@ -120,6 +121,9 @@ public:
     int bitRate() const;
     void setBitRate(int bitRate);
 
+    bool audioExportStems() const;
+    void setAudioExportStems(bool exportStems);
+
     bool midiExpandRepeats() const;
     void setMidiExpandRepeats(bool expandRepeats);
 
@@ -155,6 +159,7 @@ signals:
     void sampleRateChanged(int sampleRate);
     void availableBitRatesChanged();
     void bitRateChanged(int bitRate);
+    void audioExportStemsChanged(bool exportStems);
 
     void midiExpandRepeatsChanged(bool expandRepeats);
     void midiExportRpnsChanged(bool exportRpns);